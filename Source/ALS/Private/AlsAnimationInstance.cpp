@@ -2,6 +2,7 @@
 
 #include "AlsAnimationInstanceProxy.h"
 #include "AlsCharacter.h"
+#include "AlsFootstepEffectsSubsystem.h"
 #include "DrawDebugHelpers.h"
 #include "Components/CapsuleComponent.h"
 #include "Curves/CurveFloat.h"
@@ -22,12 +23,246 @@
 ALS_DEFINE_PRIVATE_MEMBER_ACCESSOR(AlsGetAnimationCurvesAccessor, &FAnimInstanceProxy::GetAnimationCurves,
                                    const TMap<FName, float>& (FAnimInstanceProxy::*)(EAnimCurveType) const)
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ground Prediction Results Used"), STAT_UAlsAnimationInstance_GroundPredictionResultsUsed, STATGROUP_Als);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ground Prediction Results Dropped"), STAT_UAlsAnimationInstance_GroundPredictionResultsDropped, STATGROUP_Als);
+
+namespace AlsAnimationInstanceConsoleVariables
+{
+	static TAutoConsoleVariable<bool> UseBakedCurves{
+		TEXT("Als.Animation.UseBakedCurves"), true,
+		TEXT("If enabled, the animation instance settings curves are sampled from lookup tables baked ")
+		TEXT("from them. If disabled, the curves are evaluated exactly."),
+		ECVF_Default
+	};
+
+	static TAutoConsoleVariable<bool> UseCharacterInputSnapshot{
+		TEXT("Als.Animation.UseCharacterInputSnapshot"), true,
+		TEXT("If enabled, the animation instance reads the input snapshot published by the character at the end of its tick. ")
+		TEXT("If disabled, it gathers the input from the character on every update. Used to compare their game thread cost."),
+		ECVF_Default
+	};
+}
+
+namespace AlsAnimationInstanceCurves
+{
+	static float Evaluate(const UCurveFloat* Curve, const FAlsBakedCurve& BakedCurve, const float Time)
+	{
+		return BakedCurve.IsBaked() && AlsAnimationInstanceConsoleVariables::UseBakedCurves.GetValueOnAnyThread()
+			       ? BakedCurve.Evaluate(Time)
+			       : Curve->GetFloatValue(Time);
+	}
+}
+
+namespace AlsCachedCurves
+{
+	enum : uint8
+	{
+		LayerHead,
+		LayerHeadAdditive,
+		LayerHeadSlot,
+		LayerArmLeft,
+		LayerArmLeftAdditive,
+		LayerArmLeftSlot,
+		LayerArmLeftLocalSpace,
+		LayerArmRight,
+		LayerArmRightAdditive,
+		LayerArmRightSlot,
+		LayerArmRightLocalSpace,
+		LayerHandLeft,
+		LayerHandRight,
+		LayerSpine,
+		LayerSpineAdditive,
+		LayerSpineSlot,
+		LayerPelvis,
+		LayerPelvisSlot,
+		LayerLegs,
+		LayerLegsSlot,
+		PoseGrounded,
+		PoseInAir,
+		PoseStanding,
+		PoseCrouching,
+		PoseMoving,
+		PoseGait,
+
+		Count
+	};
+}
+
+namespace AlsThighAxesCache
+{
+	struct FThighAxes
+	{
+		FVector3f Left{ForceInit};
+
+		FVector3f Right{ForceInit};
+
+		bool bLeftValid{false};
+
+		bool bRightValid{false};
+	};
+
+	static bool CalculateThighAxis(const FReferenceSkeleton& ReferenceSkeleton, const int32 PelvisBoneIndex,
+	                               const FName& FootBoneName, FVector3f& ThighAxis)
+	{
+		auto ParentBoneIndex{ReferenceSkeleton.FindBoneIndex(FootBoneName)};
+		if (ParentBoneIndex < 0)
+		{
+			return false;
+		}
+
+		while (true)
+		{
+			const auto NextParentBoneIndex{ReferenceSkeleton.GetParentIndex(ParentBoneIndex)};
+			if (NextParentBoneIndex <= 0)
+			{
+				return false;
+			}
+
+			if (NextParentBoneIndex == PelvisBoneIndex)
+			{
+				break;
+			}
+
+			ParentBoneIndex = NextParentBoneIndex;
+		}
+
+		const auto& ThighTransform{ReferenceSkeleton.GetRefBonePose()[ParentBoneIndex]};
+
+		ThighAxis = FVector3f{ThighTransform.GetLocation()};
+		ThighAxis.Normalize();
+
+		return true;
+	}
+
+	// The thigh axes only depend on the reference skeleton, so they are calculated once per
+	// skinned asset and shared between all animation instances that use the same asset.
+
+	static FCriticalSection CriticalSection;
+	static TMap<TObjectKey<USkinnedAsset>, FThighAxes> ThighAxesByAsset;
+
+	static void PurgeDestroyedAssets()
+	{
+		FScopeLock Lock{&CriticalSection};
+
+		for (auto Iterator{ThighAxesByAsset.CreateIterator()}; Iterator; ++Iterator)
+		{
+			if (Iterator.Key().ResolveObjectPtr() == nullptr)
+			{
+				Iterator.RemoveCurrent();
+			}
+		}
+	}
+
+#if WITH_EDITOR
+	static void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& ChangedEvent)
+	{
+		// Reimporting a skinned asset or editing its skeleton ends up here, so the thigh axes are recalculated next time.
+
+		const auto* SkinnedAsset{Cast<USkinnedAsset>(Object)};
+		if (SkinnedAsset != nullptr)
+		{
+			FScopeLock Lock{&CriticalSection};
+
+			ThighAxesByAsset.Remove(SkinnedAsset);
+		}
+	}
+#endif
+
+	static void RegisterDelegates()
+	{
+		static auto bRegistered{false};
+		if (bRegistered)
+		{
+			return;
+		}
+
+		bRegistered = true;
+
+		FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&PurgeDestroyedAssets);
+
+#if WITH_EDITOR
+		FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(&OnObjectPropertyChanged);
+#endif
+	}
+
+	static FThighAxes Calculate(const USkinnedAsset* SkinnedAsset)
+	{
+		const auto& ReferenceSkeleton{SkinnedAsset->GetRefSkeleton()};
+		const auto PelvisBoneIndex{ReferenceSkeleton.FindBoneIndex(UAlsConstants::PelvisBoneName())};
+
+		FThighAxes ThighAxes;
+		ThighAxes.bLeftValid = CalculateThighAxis(ReferenceSkeleton, PelvisBoneIndex, UAlsConstants::FootLeftBoneName(), ThighAxes.Left);
+		ThighAxes.bRightValid = CalculateThighAxis(ReferenceSkeleton, PelvisBoneIndex, UAlsConstants::FootRightBoneName(), ThighAxes.Right);
+
+		return ThighAxes;
+	}
+
+	static FThighAxes Get(const USkinnedAsset* SkinnedAsset, const UWorld* World)
+	{
+#if WITH_EDITOR
+		// The reference pose can be edited in the asset editors without any property change notification,
+		// so the preview worlds of these editors don't use the cache. Game worlds, including PIE, still do.
+		if (!IsValid(World) || !World->IsGameWorld())
+		{
+			return Calculate(SkinnedAsset);
+		}
+#endif
+
+		FScopeLock Lock{&CriticalSection};
+
+		RegisterDelegates();
+
+		const auto* CachedThighAxes{ThighAxesByAsset.Find(SkinnedAsset)};
+		if (CachedThighAxes != nullptr)
+		{
+			return *CachedThighAxes;
+		}
+
+		return ThighAxesByAsset.Add(SkinnedAsset, Calculate(SkinnedAsset));
+	}
+}
+
 void UAlsAnimationInstance::NativeInitializeAnimation()
 {
 	Super::NativeInitializeAnimation();
 
 	Character = Cast<AAlsCharacter>(GetOwningActor());
 
+	// Initialization is also performed after the skeletal mesh changes, so previously resolved curves are discarded here.
+
+	static const FName CachedCurveNames[]{
+		UAlsConstants::LayerHeadCurveName(),
+		UAlsConstants::LayerHeadAdditiveCurveName(),
+		UAlsConstants::LayerHeadSlotCurveName(),
+		UAlsConstants::LayerArmLeftCurveName(),
+		UAlsConstants::LayerArmLeftAdditiveCurveName(),
+		UAlsConstants::LayerArmLeftSlotCurveName(),
+		UAlsConstants::LayerArmLeftLocalSpaceCurveName(),
+		UAlsConstants::LayerArmRightCurveName(),
+		UAlsConstants::LayerArmRightAdditiveCurveName(),
+		UAlsConstants::LayerArmRightSlotCurveName(),
+		UAlsConstants::LayerArmRightLocalSpaceCurveName(),
+		UAlsConstants::LayerHandLeftCurveName(),
+		UAlsConstants::LayerHandRightCurveName(),
+		UAlsConstants::LayerSpineCurveName(),
+		UAlsConstants::LayerSpineAdditiveCurveName(),
+		UAlsConstants::LayerSpineSlotCurveName(),
+		UAlsConstants::LayerPelvisCurveName(),
+		UAlsConstants::LayerPelvisSlotCurveName(),
+		UAlsConstants::LayerLegsCurveName(),
+		UAlsConstants::LayerLegsSlotCurveName(),
+		UAlsConstants::PoseGroundedCurveName(),
+		UAlsConstants::PoseInAirCurveName(),
+		UAlsConstants::PoseStandingCurveName(),
+		UAlsConstants::PoseCrouchingCurveName(),
+		UAlsConstants::PoseMovingCurveName(),
+		UAlsConstants::PoseGaitCurveName()
+	};
+
+	static_assert(UE_ARRAY_COUNT(CachedCurveNames) == AlsCachedCurves::Count);
+
+	CurveCache.Initialize(CachedCurveNames);
+
 #if WITH_EDITOR
 	const auto* World{GetWorld()};
 
@@ -38,47 +273,33 @@ void UAlsAnimationInstance::NativeInitializeAnimation()
 	}
 #endif
 
-	const auto* Mesh{GetSkelMeshComponent()};
+	RefreshFeetBoneIndices(GetSkelMeshComponent());
+}
+
+void UAlsAnimationInstance::RefreshFeetBoneIndices(const USkeletalMeshComponent* Mesh)
+{
+	FeetBoneIndices = {};
+	FeetBoneIndicesSkinnedAsset = IsValid(Mesh) ? Mesh->GetSkinnedAsset() : nullptr;
 
-	if (IsValid(Mesh) && IsValid(Mesh->GetSkinnedAsset()))
+	if (IsValid(FeetBoneIndicesSkinnedAsset))
 	{
-		const auto& ReferenceSkeleton{Mesh->GetSkinnedAsset()->GetRefSkeleton()};
-		const auto PelvisBoneIndex{ReferenceSkeleton.FindBoneIndex(UAlsConstants::PelvisBoneName())};
+		FeetBoneIndices.Pelvis = Mesh->GetBoneIndex(UAlsConstants::PelvisBoneName());
+		FeetBoneIndices.FootLeftIk = Mesh->GetBoneIndex(UAlsConstants::FootLeftIkBoneName());
+		FeetBoneIndices.FootRightIk = Mesh->GetBoneIndex(UAlsConstants::FootRightIkBoneName());
+		FeetBoneIndices.FootLeftVirtual = Mesh->GetBoneIndex(UAlsConstants::FootLeftVirtualBoneName());
+		FeetBoneIndices.FootRightVirtual = Mesh->GetBoneIndex(UAlsConstants::FootRightVirtualBoneName());
 
-		static const auto GetThighAxis{
-			[](const FReferenceSkeleton& ReferenceSkeleton, const int32 PelvisBoneIndex, const FName& FootBoneName, FVector3f& ThighAxis)
-			{
-				auto ParentBoneIndex{ReferenceSkeleton.FindBoneIndex(FootBoneName)};
-				if (ParentBoneIndex < 0)
-				{
-					return;
-				}
-
-				while (true)
-				{
-					const auto NextParentBoneIndex{ReferenceSkeleton.GetParentIndex(ParentBoneIndex)};
-					if (NextParentBoneIndex <= 0)
-					{
-						return;
-					}
-
-					if (NextParentBoneIndex == PelvisBoneIndex)
-					{
-						break;
-					}
-
-					ParentBoneIndex = NextParentBoneIndex;
-				}
-
-				const auto& ThighTransform{ReferenceSkeleton.GetRefBonePose()[ParentBoneIndex]};
-
-				ThighAxis = FVector3f{ThighTransform.GetLocation()};
-				ThighAxis.Normalize();
-			}
-		};
+		const auto ThighAxes{AlsThighAxesCache::Get(Mesh->GetSkinnedAsset(), GetWorld())};
+
+		if (ThighAxes.bLeftValid)
+		{
+			FeetState.Left.ThighAxis = ThighAxes.Left;
+		}
 
-		GetThighAxis(ReferenceSkeleton, PelvisBoneIndex, UAlsConstants::FootLeftBoneName(), FeetState.Left.ThighAxis);
-		GetThighAxis(ReferenceSkeleton, PelvisBoneIndex, UAlsConstants::FootRightBoneName(), FeetState.Right.ThighAxis);
+		if (ThighAxes.bRightValid)
+		{
+			FeetState.Right.ThighAxis = ThighAxes.Right;
+		}
 	}
 }
 
@@ -88,6 +309,15 @@ void UAlsAnimationInstance::NativeBeginPlay()
 
 	ALS_ENSURE(IsValid(Settings));
 	ALS_ENSURE(IsValid(Character));
+
+	auto* FootstepEffectsSubsystem{IsValid(Settings) ? GetWorld()->GetSubsystem<UAlsFootstepEffectsSubsystem>() : nullptr};
+	if (IsValid(FootstepEffectsSubsystem))
+	{
+		for (const UAlsFootstepEffectsSettings* FootstepEffectsSettings : Settings->General.FootstepEffectsSettings)
+		{
+			FootstepEffectsSubsystem->PreloadEffects(FootstepEffectsSettings);
+		}
+	}
 }
 
 void UAlsAnimationInstance::NativeUpdateAnimation(const float DeltaTime)
@@ -140,12 +370,30 @@ void UAlsAnimationInstance::NativeUpdateAnimation(const float DeltaTime)
 
 	const auto PreviousLocation{LocomotionState.Location};
 
-	RefreshMovementBaseOnGameThread();
-	RefreshViewOnGameThread();
-	RefreshLocomotionOnGameThread();
+	// The character publishes everything needed here in a single snapshot at the end of its tick.
+
+	const auto* InputSnapshotPointer{&Character->GetAnimationInputSnapshot()};
+
+	if (!AlsAnimationInstanceConsoleVariables::UseCharacterInputSnapshot.GetValueOnGameThread())
+	{
+		const auto* World{GetWorld()};
+		const auto ActorDeltaTime{IsValid(World) ? World->GetDeltaSeconds() * Character->CustomTimeDilation : 0.0f};
+
+		Character->GatherAnimationInputSnapshot(GatheredInputSnapshot, ActorDeltaTime);
+
+		InputSnapshotPointer = &GatheredInputSnapshot;
+	}
+
+	const auto& InputSnapshot{*InputSnapshotPointer};
+
+	RefreshMovementBaseOnGameThread(InputSnapshot);
+	RefreshViewOnGameThread(InputSnapshot);
+	RefreshLocomotionOnGameThread(InputSnapshot);
 	RefreshInAirOnGameThread();
 	RefreshFeetOnGameThread();
-	RefreshRagdollingOnGameThread();
+	RefreshRagdollingOnGameThread(InputSnapshot);
+
+	InputSnapshotFrame = InputSnapshot.Frame;
 
 	if (!bPendingUpdate && IsValid(Character->GetSettings()) &&
 	    FVector::DistSquared(PreviousLocation, LocomotionState.Location) >
@@ -172,8 +420,13 @@ void UAlsAnimationInstance::NativeThreadSafeUpdateAnimation(const float DeltaTim
 	RotateInPlaceState.bUpdatedThisFrame = false;
 	TurnInPlaceState.bUpdatedThisFrame = false;
 
-	RefreshLayering();
-	RefreshPose();
+	float CurveValues[AlsCachedCurves::Count];
+
+	CurveCache.GetCurveValues(AlsGetAnimationCurvesAccessor::Access(GetProxyOnAnyThread<FAnimInstanceProxy>(),
+	                                                                EAnimCurveType::AttributeCurve), CurveValues);
+
+	RefreshLayering(CurveValues);
+	RefreshPose(CurveValues);
 	RefreshView(DeltaTime);
 	RefreshFeet(DeltaTime);
 	RefreshTransitions();
@@ -233,107 +486,70 @@ FAlsControlRigInput UAlsAnimationInstance::GetControlRigInput() const
 	};
 }
 
-void UAlsAnimationInstance::RefreshMovementBaseOnGameThread()
+void UAlsAnimationInstance::RefreshMovementBaseOnGameThread(const FAlsAnimationInputSnapshot& InputSnapshot)
 {
-	const auto& BasedMovement{Character->GetBasedMovement()};
+	// The movement base state is refreshed by the character when it publishes the snapshot, so its delta rotation covers all frames
+	// since the previous snapshot. If the character hasn't ticked since the last update, keep the current state, but don't apply
+	// the same base change or delta rotation twice.
 
-	if (BasedMovement.MovementBase != MovementBase.Primitive || BasedMovement.BoneName != MovementBase.BoneName)
+	if (InputSnapshot.Frame != InputSnapshotFrame)
 	{
-		MovementBase.Primitive = BasedMovement.MovementBase;
-		MovementBase.BoneName = BasedMovement.BoneName;
-		MovementBase.bBaseChanged = true;
+		MovementBase = InputSnapshot.MovementBase;
 	}
 	else
 	{
 		MovementBase.bBaseChanged = false;
+		MovementBase.DeltaRotation = FRotator::ZeroRotator;
 	}
-
-	MovementBase.bHasRelativeLocation = BasedMovement.HasRelativeLocation();
-	MovementBase.bHasRelativeRotation = MovementBase.bHasRelativeLocation && BasedMovement.bRelativeRotation;
-
-	const auto PreviousRotation{MovementBase.Rotation};
-
-	MovementBaseUtility::GetMovementBaseTransform(BasedMovement.MovementBase, BasedMovement.BoneName,
-	                                              MovementBase.Location, MovementBase.Rotation);
-
-	MovementBase.DeltaRotation = MovementBase.bHasRelativeLocation && !MovementBase.bBaseChanged
-		                             ? (MovementBase.Rotation * PreviousRotation.Inverse()).Rotator()
-		                             : FRotator::ZeroRotator;
 }
 
-void UAlsAnimationInstance::RefreshLayering()
+void UAlsAnimationInstance::RefreshLayering(const TConstArrayView<float> CurveValues)
 {
-	const auto& Curves{
-		AlsGetAnimationCurvesAccessor::Access(GetProxyOnAnyThread<FAnimInstanceProxy>(), EAnimCurveType::AttributeCurve)
-	};
-
-	static const auto GetCurveValue{
-		[](const TMap<FName, float>& Curves, const FName& CurveName) -> float
-		{
-			const auto* Value{Curves.Find(CurveName)};
-
-			return Value != nullptr ? *Value : 0.0f;
-		}
-	};
-
-	LayeringState.HeadBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerHeadCurveName());
-	LayeringState.HeadAdditiveBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerHeadAdditiveCurveName());
-	LayeringState.HeadSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerHeadSlotCurveName());
+	LayeringState.HeadBlendAmount = CurveValues[AlsCachedCurves::LayerHead];
+	LayeringState.HeadAdditiveBlendAmount = CurveValues[AlsCachedCurves::LayerHeadAdditive];
+	LayeringState.HeadSlotBlendAmount = CurveValues[AlsCachedCurves::LayerHeadSlot];
 
 	// The mesh space blend will always be 1 unless the local space blend is 1.
 
-	LayeringState.ArmLeftBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmLeftCurveName());
-	LayeringState.ArmLeftAdditiveBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmLeftAdditiveCurveName());
-	LayeringState.ArmLeftSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmLeftSlotCurveName());
-	LayeringState.ArmLeftLocalSpaceBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmLeftLocalSpaceCurveName());
+	LayeringState.ArmLeftBlendAmount = CurveValues[AlsCachedCurves::LayerArmLeft];
+	LayeringState.ArmLeftAdditiveBlendAmount = CurveValues[AlsCachedCurves::LayerArmLeftAdditive];
+	LayeringState.ArmLeftSlotBlendAmount = CurveValues[AlsCachedCurves::LayerArmLeftSlot];
+	LayeringState.ArmLeftLocalSpaceBlendAmount = CurveValues[AlsCachedCurves::LayerArmLeftLocalSpace];
 	LayeringState.ArmLeftMeshSpaceBlendAmount = !FAnimWeight::IsFullWeight(LayeringState.ArmLeftLocalSpaceBlendAmount);
 
 	// The mesh space blend will always be 1 unless the local space blend is 1.
 
-	LayeringState.ArmRightBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmRightCurveName());
-	LayeringState.ArmRightAdditiveBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmRightAdditiveCurveName());
-	LayeringState.ArmRightSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmRightSlotCurveName());
-	LayeringState.ArmRightLocalSpaceBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmRightLocalSpaceCurveName());
+	LayeringState.ArmRightBlendAmount = CurveValues[AlsCachedCurves::LayerArmRight];
+	LayeringState.ArmRightAdditiveBlendAmount = CurveValues[AlsCachedCurves::LayerArmRightAdditive];
+	LayeringState.ArmRightSlotBlendAmount = CurveValues[AlsCachedCurves::LayerArmRightSlot];
+	LayeringState.ArmRightLocalSpaceBlendAmount = CurveValues[AlsCachedCurves::LayerArmRightLocalSpace];
 	LayeringState.ArmRightMeshSpaceBlendAmount = !FAnimWeight::IsFullWeight(LayeringState.ArmRightLocalSpaceBlendAmount);
 
-	LayeringState.HandLeftBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerHandLeftCurveName());
-	LayeringState.HandRightBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerHandRightCurveName());
+	LayeringState.HandLeftBlendAmount = CurveValues[AlsCachedCurves::LayerHandLeft];
+	LayeringState.HandRightBlendAmount = CurveValues[AlsCachedCurves::LayerHandRight];
 
-	LayeringState.SpineBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerSpineCurveName());
-	LayeringState.SpineAdditiveBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerSpineAdditiveCurveName());
-	LayeringState.SpineSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerSpineSlotCurveName());
+	LayeringState.SpineBlendAmount = CurveValues[AlsCachedCurves::LayerSpine];
+	LayeringState.SpineAdditiveBlendAmount = CurveValues[AlsCachedCurves::LayerSpineAdditive];
+	LayeringState.SpineSlotBlendAmount = CurveValues[AlsCachedCurves::LayerSpineSlot];
 
-	LayeringState.PelvisBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerPelvisCurveName());
-	LayeringState.PelvisSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerPelvisSlotCurveName());
+	LayeringState.PelvisBlendAmount = CurveValues[AlsCachedCurves::LayerPelvis];
+	LayeringState.PelvisSlotBlendAmount = CurveValues[AlsCachedCurves::LayerPelvisSlot];
 
-	LayeringState.LegsBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerLegsCurveName());
-	LayeringState.LegsSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerLegsSlotCurveName());
+	LayeringState.LegsBlendAmount = CurveValues[AlsCachedCurves::LayerLegs];
+	LayeringState.LegsSlotBlendAmount = CurveValues[AlsCachedCurves::LayerLegsSlot];
 }
 
-void UAlsAnimationInstance::RefreshPose()
+void UAlsAnimationInstance::RefreshPose(const TConstArrayView<float> CurveValues)
 {
-	const auto& Curves{
-		AlsGetAnimationCurvesAccessor::Access(GetProxyOnAnyThread<FAnimInstanceProxy>(), EAnimCurveType::AttributeCurve)
-	};
+	PoseState.GroundedAmount = CurveValues[AlsCachedCurves::PoseGrounded];
+	PoseState.InAirAmount = CurveValues[AlsCachedCurves::PoseInAir];
 
-	static const auto GetCurveValue{
-		[](const TMap<FName, float>& Curves, const FName& CurveName) -> float
-		{
-			const auto* Value{Curves.Find(CurveName)};
-
-			return Value != nullptr ? *Value : 0.0f;
-		}
-	};
+	PoseState.StandingAmount = CurveValues[AlsCachedCurves::PoseStanding];
+	PoseState.CrouchingAmount = CurveValues[AlsCachedCurves::PoseCrouching];
 
-	PoseState.GroundedAmount = GetCurveValue(Curves, UAlsConstants::PoseGroundedCurveName());
-	PoseState.InAirAmount = GetCurveValue(Curves, UAlsConstants::PoseInAirCurveName());
+	PoseState.MovingAmount = CurveValues[AlsCachedCurves::PoseMoving];
 
-	PoseState.StandingAmount = GetCurveValue(Curves, UAlsConstants::PoseStandingCurveName());
-	PoseState.CrouchingAmount = GetCurveValue(Curves, UAlsConstants::PoseCrouchingCurveName());
-
-	PoseState.MovingAmount = GetCurveValue(Curves, UAlsConstants::PoseMovingCurveName());
-
-	PoseState.GaitAmount = FMath::Clamp(GetCurveValue(Curves, UAlsConstants::PoseGaitCurveName()), 0.0f, 3.0f);
+	PoseState.GaitAmount = FMath::Clamp(CurveValues[AlsCachedCurves::PoseGait], 0.0f, 3.0f);
 	PoseState.GaitWalkingAmount = UAlsMath::Clamp01(PoseState.GaitAmount);
 	PoseState.GaitRunningAmount = UAlsMath::Clamp01(PoseState.GaitAmount - 1.0f);
 	PoseState.GaitSprintingAmount = UAlsMath::Clamp01(PoseState.GaitAmount - 2.0f);
@@ -350,14 +566,12 @@ void UAlsAnimationInstance::RefreshPose()
 	PoseState.UnweightedGaitSprintingAmount = UAlsMath::Clamp01(PoseState.UnweightedGaitAmount - 2.0f);
 }
 
-void UAlsAnimationInstance::RefreshViewOnGameThread()
+void UAlsAnimationInstance::RefreshViewOnGameThread(const FAlsAnimationInputSnapshot& InputSnapshot)
 {
 	check(IsInGameThread())
 
-	const auto& View{Character->GetViewState()};
-
-	ViewState.Rotation = View.Rotation;
-	ViewState.YawSpeed = View.YawSpeed;
+	ViewState.Rotation = InputSnapshot.ViewRotation;
+	ViewState.YawSpeed = InputSnapshot.ViewYawSpeed;
 }
 
 void UAlsAnimationInstance::RefreshView(const float DeltaTime)
@@ -594,29 +808,34 @@ void UAlsAnimationInstance::RefreshLook()
 	LookState.YawRightAmount = 0.5f + FMath::Abs(LookState.YawForwardAmount - 0.5f);
 }
 
-void UAlsAnimationInstance::RefreshLocomotionOnGameThread()
+void UAlsAnimationInstance::RefreshLocomotionOnGameThread(const FAlsAnimationInputSnapshot& InputSnapshot)
 {
 	check(IsInGameThread())
 
 	const auto* World{GetWorld()};
 
-	const auto ActorDeltaTime{IsValid(World) ? World->GetDeltaSeconds() * Character->CustomTimeDilation : 0.0f};
+	const auto ActorDeltaTime{IsValid(World) ? World->GetDeltaSeconds() * InputSnapshot.TimeDilation : 0.0f};
 	const auto bCanCalculateRateOfChange{!bPendingUpdate && ActorDeltaTime > UE_SMALL_NUMBER};
 
-	const auto& Locomotion{Character->GetLocomotionState()};
-
-	LocomotionState.bHasInput = Locomotion.bHasInput;
-	LocomotionState.InputYawAngle = Locomotion.InputYawAngle;
+	LocomotionState.bHasInput = InputSnapshot.bHasInput;
+	LocomotionState.InputYawAngle = InputSnapshot.InputYawAngle;
 
 	const auto PreviousVelocity{LocomotionState.Velocity};
 
-	LocomotionState.Speed = Locomotion.Speed;
-	LocomotionState.Velocity = Locomotion.Velocity;
-	LocomotionState.VelocityYawAngle = Locomotion.VelocityYawAngle;
+	LocomotionState.Speed = InputSnapshot.Speed;
+	LocomotionState.Velocity = InputSnapshot.Velocity;
+	LocomotionState.VelocityYawAngle = InputSnapshot.VelocityYawAngle;
 
-	LocomotionState.Acceleration = bCanCalculateRateOfChange
-		                               ? (LocomotionState.Velocity - PreviousVelocity) / ActorDeltaTime
-		                               : FVector::ZeroVector;
+	if (InputSnapshot.Frame != InputSnapshotFrame || !bCanCalculateRateOfChange)
+	{
+		// When the character ticks less often than the animation instance, for example, because of its significance tier, the
+		// velocity only changes in frames in which a new snapshot is published. So the acceleration is calculated over the delta
+		// time of the character and kept in the other frames, instead of spiking in the first frames and dropping to zero in the others.
+
+		LocomotionState.Acceleration = bCanCalculateRateOfChange && InputSnapshot.DeltaTime > UE_SMALL_NUMBER
+			                               ? (LocomotionState.Velocity - PreviousVelocity) / InputSnapshot.DeltaTime
+			                               : FVector::ZeroVector;
+	}
 
 	const auto* Movement{Character->GetCharacterMovement()};
 
@@ -624,12 +843,12 @@ void UAlsAnimationInstance::RefreshLocomotionOnGameThread()
 	LocomotionState.MaxBrakingDeceleration = Movement->GetMaxBrakingDeceleration();
 	LocomotionState.WalkableFloorAngleCos = Movement->GetWalkableFloorZ();
 
-	LocomotionState.bMoving = Locomotion.bMoving;
+	LocomotionState.bMoving = InputSnapshot.bMoving;
 
-	LocomotionState.bMovingSmooth = (Locomotion.bHasInput && Locomotion.bHasVelocity) ||
-	                                Locomotion.Speed > Settings->General.MovingSmoothSpeedThreshold;
+	LocomotionState.bMovingSmooth = (InputSnapshot.bHasInput && InputSnapshot.bHasVelocity) ||
+	                                InputSnapshot.Speed > Settings->General.MovingSmoothSpeedThreshold;
 
-	LocomotionState.TargetYawAngle = Locomotion.TargetYawAngle;
+	LocomotionState.TargetYawAngle = InputSnapshot.TargetYawAngle;
 
 	const auto PreviousYawAngle{LocomotionState.Rotation.Yaw};
 
@@ -868,12 +1087,24 @@ void UAlsAnimationInstance::RefreshRotationYawOffsets(const float ViewRelativeVe
 	// graph and is used to offset the character's rotation for more natural movement.
 	// The curves allow us to precisely control the offset for each movement direction.
 
+	const auto& GroundedSettings{Settings->Grounded};
 	auto& RotationYawOffsets{GroundedState.RotationYawOffsets};
 
-	RotationYawOffsets.ForwardAngle = Settings->Grounded.RotationYawOffsetForwardCurve->GetFloatValue(ViewRelativeVelocityYawAngle);
-	RotationYawOffsets.BackwardAngle = Settings->Grounded.RotationYawOffsetBackwardCurve->GetFloatValue(ViewRelativeVelocityYawAngle);
-	RotationYawOffsets.LeftAngle = Settings->Grounded.RotationYawOffsetLeftCurve->GetFloatValue(ViewRelativeVelocityYawAngle);
-	RotationYawOffsets.RightAngle = Settings->Grounded.RotationYawOffsetRightCurve->GetFloatValue(ViewRelativeVelocityYawAngle);
+	RotationYawOffsets.ForwardAngle = AlsAnimationInstanceCurves::Evaluate(GroundedSettings.RotationYawOffsetForwardCurve,
+	                                                                       GroundedSettings.RotationYawOffsetForwardBakedCurve,
+	                                                                       ViewRelativeVelocityYawAngle);
+
+	RotationYawOffsets.BackwardAngle = AlsAnimationInstanceCurves::Evaluate(GroundedSettings.RotationYawOffsetBackwardCurve,
+	                                                                        GroundedSettings.RotationYawOffsetBackwardBakedCurve,
+	                                                                        ViewRelativeVelocityYawAngle);
+
+	RotationYawOffsets.LeftAngle = AlsAnimationInstanceCurves::Evaluate(GroundedSettings.RotationYawOffsetLeftCurve,
+	                                                                    GroundedSettings.RotationYawOffsetLeftBakedCurve,
+	                                                                    ViewRelativeVelocityYawAngle);
+
+	RotationYawOffsets.RightAngle = AlsAnimationInstanceCurves::Evaluate(GroundedSettings.RotationYawOffsetRightCurve,
+	                                                                     GroundedSettings.RotationYawOffsetRightBakedCurve,
+	                                                                     ViewRelativeVelocityYawAngle);
 }
 
 void UAlsAnimationInstance::InitializeStandingMovement()
@@ -907,9 +1138,12 @@ void UAlsAnimationInstance::RefreshStandingMovement()
 	// blend independently while still matching the animation speed to the movement speed, preventing the character from needing
 	// to play a half walk + half run blend. The curves are used to map the stride amount to the speed for maximum control.
 
-	StandingState.StrideBlendAmount = FMath::Lerp(Settings->Standing.StrideBlendAmountWalkCurve->GetFloatValue(Speed),
-	                                              Settings->Standing.StrideBlendAmountRunCurve->GetFloatValue(Speed),
-	                                              PoseState.UnweightedGaitRunningAmount);
+	const auto& StandingSettings{Settings->Standing};
+
+	StandingState.StrideBlendAmount = FMath::Lerp(
+		AlsAnimationInstanceCurves::Evaluate(StandingSettings.StrideBlendAmountWalkCurve, StandingSettings.StrideBlendAmountWalkBakedCurve, Speed),
+		AlsAnimationInstanceCurves::Evaluate(StandingSettings.StrideBlendAmountRunCurve, StandingSettings.StrideBlendAmountRunBakedCurve, Speed),
+		PoseState.UnweightedGaitRunningAmount);
 
 	// Calculate the walk run blend amount. This value is used within the blend spaces to blend between walking and running.
 
@@ -989,7 +1223,8 @@ void UAlsAnimationInstance::RefreshCrouchingMovement()
 
 	const auto Speed{LocomotionState.Speed / LocomotionState.Scale};
 
-	CrouchingState.StrideBlendAmount = Settings->Crouching.StrideBlendAmountCurve->GetFloatValue(Speed);
+	CrouchingState.StrideBlendAmount = AlsAnimationInstanceCurves::Evaluate(Settings->Crouching.StrideBlendAmountCurve,
+	                                                                        Settings->Crouching.StrideBlendAmountBakedCurve, Speed);
 
 	CrouchingState.PlayRate = FMath::Clamp(
 		Speed / (Settings->Crouching.AnimatedCrouchSpeed * CrouchingState.StrideBlendAmount),
@@ -1002,6 +1237,96 @@ void UAlsAnimationInstance::RefreshInAirOnGameThread()
 
 	InAirState.bJumped = !bPendingUpdate && (InAirState.bJumped || InAirState.bJumpRequested);
 	InAirState.bJumpRequested = false;
+
+	RefreshGroundPredictionOnGameThread();
+}
+
+void UAlsAnimationInstance::RefreshGroundPredictionOnGameThread()
+{
+	// The ground prediction sweep is issued asynchronously here and its result is consumed one frame later, so
+	// that the animation worker thread doesn't have to perform a synchronous sweep and wait for the physics scene.
+
+	check(IsInGameThread())
+
+	auto* World{GetWorld()};
+	const auto CurrentFrame{GFrameCounter};
+	const auto MaxResultAge{static_cast<uint64>(FMath::Max(1, Settings->InAir.GroundPredictionMaxResultAge))};
+
+	if (GroundPredictionTraceHandle.IsValid())
+	{
+		FTraceDatum TraceDatum;
+
+		if (World->QueryTraceData(GroundPredictionTraceHandle, TraceDatum) &&
+		    CurrentFrame - GroundPredictionTraceFrame <= MaxResultAge)
+		{
+			INC_DWORD_STAT(STAT_UAlsAnimationInstance_GroundPredictionResultsUsed);
+
+			const auto Hit{!TraceDatum.OutHits.IsEmpty() ? TraceDatum.OutHits[0] : FHitResult{TraceDatum.Start, TraceDatum.End}};
+			const auto bGroundValid{Hit.IsValidBlockingHit() && Hit.ImpactNormal.Z >= LocomotionState.WalkableFloorAngleCos};
+
+			GroundPredictionHitFrame = GroundPredictionTraceFrame;
+			GroundPredictionHitTime = Hit.Time;
+			bGroundPredictionHitValid = bGroundValid;
+
+#if WITH_EDITORONLY_DATA && ENABLE_DRAW_DEBUG
+			if (bDisplayDebugTraces)
+			{
+				UAlsDebugUtility::DrawSweepSingleCapsule(World, TraceDatum.Start, TraceDatum.End, FRotator::ZeroRotator,
+				                                         LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight,
+				                                         bGroundValid, Hit, {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f});
+			}
+#endif
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_UAlsAnimationInstance_GroundPredictionResultsDropped);
+		}
+
+		GroundPredictionTraceHandle = FTraceHandle{};
+	}
+
+	if (bGroundPredictionHitValid && CurrentFrame - GroundPredictionHitFrame > MaxResultAge)
+	{
+		bGroundPredictionHitValid = false;
+	}
+
+	static constexpr auto MinVerticalVelocity{-4000.0f};
+	static constexpr auto MaxVerticalVelocity{-200.0f};
+
+	const auto VerticalVelocity{UE_REAL_TO_FLOAT(LocomotionState.Velocity.Z)};
+
+	if (bPendingUpdate || LocomotionMode != AlsLocomotionModeTags::InAir || VerticalVelocity > MaxVerticalVelocity)
+	{
+		bGroundPredictionHitValid = false;
+		return;
+	}
+
+	// Calculate the ground prediction sweep by tracing in the velocity direction to find a walkable surface the character is falling toward.
+
+	const auto SweepStartLocation{LocomotionState.Location};
+
+	auto VelocityDirection{LocomotionState.Velocity};
+	VelocityDirection.Z = FMath::Clamp(VelocityDirection.Z, MinVerticalVelocity, MaxVerticalVelocity);
+	VelocityDirection.Normalize();
+
+	static constexpr auto MinSweepDistance{150.0f};
+	static constexpr auto MaxSweepDistance{2000.0f};
+
+	const auto SweepVector{
+		VelocityDirection * FMath::GetMappedRangeValueClamped(FVector2f{MaxVerticalVelocity, MinVerticalVelocity},
+		                                                      {MinSweepDistance, MaxSweepDistance},
+		                                                      VerticalVelocity) * LocomotionState.Scale
+	};
+
+	GroundPredictionTraceHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, SweepStartLocation,
+	                                                         SweepStartLocation + SweepVector, FQuat::Identity,
+	                                                         Settings->InAir.GroundPredictionSweepChannel,
+	                                                         FCollisionShape::MakeCapsule(LocomotionState.CapsuleRadius,
+	                                                                                      LocomotionState.CapsuleHalfHeight),
+	                                                         {__FUNCTION__, false, Character},
+	                                                         Settings->InAir.GroundPredictionSweepResponses);
+
+	GroundPredictionTraceFrame = CurrentFrame;
 }
 
 void UAlsAnimationInstance::RefreshInAir()
@@ -1041,13 +1366,11 @@ void UAlsAnimationInstance::RefreshInAir()
 
 void UAlsAnimationInstance::RefreshGroundPrediction()
 {
-	// Calculate the ground prediction weight by tracing in the velocity direction to find a walkable surface the character
-	// is falling toward and getting the "time" (range from 0 to 1, 1 being maximum, 0 being about to ground) till impact.
-	// The ground prediction amount curve is used to control how the time affects the final amount for a smooth blend.
-
-	static constexpr auto VerticalVelocityThreshold{-200.0f};
+	// Calculate the ground prediction weight using the "time" (range from 0 to 1, 1 being maximum, 0 being about to ground) till impact
+	// from the latest ground prediction sweep performed in the RefreshGroundPredictionOnGameThread() function. The ground
+	// prediction amount curve is used to control how the time affects the final amount for a smooth blend.
 
-	if (InAirState.VerticalVelocity > VerticalVelocityThreshold)
+	if (!bGroundPredictionHitValid)
 	{
 		InAirState.GroundPredictionAmount = 0.0f;
 		return;
@@ -1060,57 +1383,9 @@ void UAlsAnimationInstance::RefreshGroundPrediction()
 		return;
 	}
 
-	const auto SweepStartLocation{LocomotionState.Location};
-
-	static constexpr auto MinVerticalVelocity{-4000.0f};
-	static constexpr auto MaxVerticalVelocity{-200.0f};
-
-	auto VelocityDirection{LocomotionState.Velocity};
-	VelocityDirection.Z = FMath::Clamp(VelocityDirection.Z, MinVerticalVelocity, MaxVerticalVelocity);
-	VelocityDirection.Normalize();
-
-	static constexpr auto MinSweepDistance{150.0f};
-	static constexpr auto MaxSweepDistance{2000.0f};
-
-	const auto SweepVector{
-		VelocityDirection * FMath::GetMappedRangeValueClamped(FVector2f{MaxVerticalVelocity, MinVerticalVelocity},
-		                                                      {MinSweepDistance, MaxSweepDistance},
-		                                                      InAirState.VerticalVelocity) * LocomotionState.Scale
-	};
-
-	FHitResult Hit;
-	GetWorld()->SweepSingleByChannel(Hit, SweepStartLocation, SweepStartLocation + SweepVector,
-	                                 FQuat::Identity, Settings->InAir.GroundPredictionSweepChannel,
-	                                 FCollisionShape::MakeCapsule(LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight),
-	                                 {__FUNCTION__, false, Character}, Settings->InAir.GroundPredictionSweepResponses);
-
-	const auto bGroundValid{Hit.IsValidBlockingHit() && Hit.ImpactNormal.Z >= LocomotionState.WalkableFloorAngleCos};
-
-#if WITH_EDITORONLY_DATA && ENABLE_DRAW_DEBUG
-	if (bDisplayDebugTraces)
-	{
-		if (IsInGameThread())
-		{
-			UAlsDebugUtility::DrawSweepSingleCapsule(GetWorld(), Hit.TraceStart, Hit.TraceEnd, FRotator::ZeroRotator,
-			                                         LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight,
-			                                         bGroundValid, Hit, {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f});
-		}
-		else
-		{
-			DisplayDebugTracesQueue.Emplace([this, Hit, bGroundValid]
-				{
-					UAlsDebugUtility::DrawSweepSingleCapsule(GetWorld(), Hit.TraceStart, Hit.TraceEnd, FRotator::ZeroRotator,
-					                                         LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight,
-					                                         bGroundValid, Hit, {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f});
-				}
-			);
-		}
-	}
-#endif
-
-	InAirState.GroundPredictionAmount = bGroundValid
-		                                    ? Settings->InAir.GroundPredictionAmountCurve->GetFloatValue(Hit.Time) * AllowanceAmount
-		                                    : 0.0f;
+	InAirState.GroundPredictionAmount = AlsAnimationInstanceCurves::Evaluate(Settings->InAir.GroundPredictionAmountCurve,
+	                                                                         Settings->InAir.GroundPredictionAmountBakedCurve,
+	                                                                         GroundPredictionHitTime) * AllowanceAmount;
 }
 
 void UAlsAnimationInstance::RefreshInAirLean()
@@ -1122,7 +1397,9 @@ void UAlsAnimationInstance::RefreshInAirLean()
 	static constexpr auto ReferenceSpeed{350.0f};
 
 	const auto TargetLeanAmount{
-		GetRelativeVelocity() / ReferenceSpeed * Settings->InAir.LeanAmountCurve->GetFloatValue(InAirState.VerticalVelocity)
+		GetRelativeVelocity() / ReferenceSpeed * AlsAnimationInstanceCurves::Evaluate(Settings->InAir.LeanAmountCurve,
+		                                                                              Settings->InAir.LeanAmountBakedCurve,
+		                                                                              InAirState.VerticalVelocity)
 	};
 
 	if (bPendingUpdate || Settings->General.LeanInterpolationSpeed <= 0.0f)
@@ -1145,21 +1422,46 @@ void UAlsAnimationInstance::RefreshFeetOnGameThread()
 
 	const auto* Mesh{GetSkelMeshComponent()};
 
-	FeetState.PelvisRotation = FQuat4f{Mesh->GetSocketTransform(UAlsConstants::PelvisBoneName(), RTS_Component).GetRotation()};
+	if (FeetBoneIndicesSkinnedAsset != Mesh->GetSkinnedAsset())
+	{
+		// The skinned asset was changed, for example, with USkinnedMeshComponent::SetSkinnedAssetAndUpdate().
+
+		RefreshFeetBoneIndices(Mesh);
+	}
+
+	// Read the bone transforms directly using the bone indices resolved during initialization. This is
+	// equivalent to USkinnedMeshComponent::GetSocketTransform(), but without searching sockets and bones by name.
+
+	const auto& ComponentSpaceTransforms{Mesh->GetComponentSpaceTransforms()};
+
+	FeetState.PelvisRotation = ComponentSpaceTransforms.IsValidIndex(FeetBoneIndices.Pelvis)
+		                           ? FQuat4f{ComponentSpaceTransforms[FeetBoneIndices.Pelvis].GetRotation()}
+		                           : FQuat4f::Identity;
+
+	const auto& ComponentTransform{Mesh->GetComponentTransform()};
+
+	const auto GetBoneTransform{
+		[&ComponentSpaceTransforms, &ComponentTransform](const int32 BoneIndex)
+		{
+			return ComponentSpaceTransforms.IsValidIndex(BoneIndex)
+				       ? ComponentSpaceTransforms[BoneIndex] * ComponentTransform
+				       : ComponentTransform;
+		}
+	};
 
 	const auto FootLeftTargetTransform{
-		Mesh->GetSocketTransform(Settings->General.bUseFootIkBones
-			                         ? UAlsConstants::FootLeftIkBoneName()
-			                         : UAlsConstants::FootLeftVirtualBoneName())
+		GetBoneTransform(Settings->General.bUseFootIkBones
+			                 ? FeetBoneIndices.FootLeftIk
+			                 : FeetBoneIndices.FootLeftVirtual)
 	};
 
 	FeetState.Left.TargetLocation = FootLeftTargetTransform.GetLocation();
 	FeetState.Left.TargetRotation = FootLeftTargetTransform.GetRotation();
 
 	const auto FootRightTargetTransform{
-		Mesh->GetSocketTransform(Settings->General.bUseFootIkBones
-			                         ? UAlsConstants::FootRightIkBoneName()
-			                         : UAlsConstants::FootRightVirtualBoneName())
+		GetBoneTransform(Settings->General.bUseFootIkBones
+			                 ? FeetBoneIndices.FootRightIk
+			                 : FeetBoneIndices.FootRightVirtual)
 	};
 
 	FeetState.Right.TargetLocation = FootRightTargetTransform.GetLocation();
@@ -1848,7 +2150,7 @@ void UAlsAnimationInstance::PlayQueuedTurnInPlaceAnimation()
 	TurnInPlaceState.QueuedTurnYawAngle = 0.0f;
 }
 
-void UAlsAnimationInstance::RefreshRagdollingOnGameThread()
+void UAlsAnimationInstance::RefreshRagdollingOnGameThread(const FAlsAnimationInputSnapshot& InputSnapshot)
 {
 	check(IsInGameThread())
 
@@ -1861,7 +2163,7 @@ void UAlsAnimationInstance::RefreshRagdollingOnGameThread()
 
 	static constexpr auto ReferenceSpeed{1000.0f};
 
-	RagdollingState.FlailPlayRate = UAlsMath::Clamp01(UE_REAL_TO_FLOAT(Character->GetRagdollingState().Velocity.Size() / ReferenceSpeed));
+	RagdollingState.FlailPlayRate = UAlsMath::Clamp01(UE_REAL_TO_FLOAT(InputSnapshot.RagdollingVelocity.Size() / ReferenceSpeed));
 }
 
 FPoseSnapshot& UAlsAnimationInstance::SnapshotFinalRagdollPose()
@@ -2,6 +2,7 @@
 
 #include "AlsAnimationInstance.h"
 #include "AlsCharacterMovementComponent.h"
+#include "AlsSignificanceSubsystem.h"
 #include "TimerManager.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
@@ -22,6 +23,9 @@
 namespace AlsCharacterConstants
 {
 	constexpr auto MinAimingYawAngleLimit{70.0f};
+
+	// Maximum remaining view network smoothing time of characters in the medium and lower significance tiers.
+	constexpr auto ReducedViewNetworkSmoothingTime{0.05f};
 }
 
 AAlsCharacter::AAlsCharacter(const FObjectInitializer& ObjectInitializer) : Super{
@@ -188,6 +192,23 @@ void AAlsCharacter::BeginPlay()
 	AlsCharacterMovement->SetRotationMode(RotationMode);
 
 	OnOverlayModeChanged(OverlayMode);
+
+	auto* SignificanceSubsystem{GetWorld()->GetSubsystem<UAlsSignificanceSubsystem>()};
+	if (IsValid(SignificanceSubsystem))
+	{
+		SignificanceSubsystem->RegisterCharacter(this);
+	}
+}
+
+void AAlsCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	auto* SignificanceSubsystem{GetWorld()->GetSubsystem<UAlsSignificanceSubsystem>()};
+	if (IsValid(SignificanceSubsystem))
+	{
+		SignificanceSubsystem->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AAlsCharacter::CalcCamera(const float DeltaTime, FMinimalViewInfo& ViewInfo)
@@ -278,15 +299,32 @@ void AAlsCharacter::Tick(const float DeltaTime)
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("AAlsCharacter::Tick"), STAT_AAlsCharacter_Tick, STATGROUP_Als)
 	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
 
+	SendPendingDesiredState();
+
 	if (!IsValid(Settings) || !AnimationInstance.IsValid())
 	{
 		Super::Tick(DeltaTime);
 		return;
 	}
 
-	RefreshMovementBase();
+	// Characters in lower significance tiers refresh their mesh properties, gait and rotation mode less often. Movement,
+	// rotation and view (including view network smoothing) are still refreshed every frame, so these characters keep
+	// moving and turning smoothly and only react to gait and rotation mode changes with a small delay.
 
-	RefreshMeshProperties();
+	SignificanceRefreshTimeRemaining -= DeltaTime;
+
+	const auto bRefreshSignificanceState{SignificanceRefreshTimeRemaining <= 0.0f};
+	if (bRefreshSignificanceState)
+	{
+		SignificanceRefreshTimeRemaining = UAlsSignificanceSubsystem::GetRefreshInterval(SignificanceTier);
+	}
+
+	RefreshMovementBase(MovementBase);
+
+	if (bRefreshSignificanceState)
+	{
+		RefreshMeshProperties();
+	}
 
 	RefreshInput(DeltaTime);
 
@@ -294,8 +332,12 @@ void AAlsCharacter::Tick(const float DeltaTime)
 
 	RefreshView(DeltaTime);
 	RefreshLocomotion();
-	RefreshGait();
-	RefreshRotationMode();
+
+	if (bRefreshSignificanceState)
+	{
+		RefreshGait();
+		RefreshRotationMode();
+	}
 
 	RefreshGroundedRotation(DeltaTime);
 	RefreshInAirRotation(DeltaTime);
@@ -308,6 +350,8 @@ void AAlsCharacter::Tick(const float DeltaTime)
 	Super::Tick(DeltaTime);
 
 	RefreshLocomotionLate();
+
+	RefreshAnimationInputSnapshot(DeltaTime);
 }
 
 void AAlsCharacter::PossessedBy(AController* NewController)
@@ -411,69 +455,184 @@ void AAlsCharacter::RefreshMeshProperties() const
 	}
 }
 
-void AAlsCharacter::RefreshMovementBase()
+void AAlsCharacter::RefreshMovementBase(FAlsMovementBaseState& State) const
 {
-	if (BasedMovement.MovementBase != MovementBase.Primitive || BasedMovement.BoneName != MovementBase.BoneName)
+	if (BasedMovement.MovementBase != State.Primitive || BasedMovement.BoneName != State.BoneName)
 	{
-		MovementBase.Primitive = BasedMovement.MovementBase;
-		MovementBase.BoneName = BasedMovement.BoneName;
-		MovementBase.bBaseChanged = true;
+		State.Primitive = BasedMovement.MovementBase;
+		State.BoneName = BasedMovement.BoneName;
+		State.bBaseChanged = true;
 	}
 	else
 	{
-		MovementBase.bBaseChanged = false;
+		State.bBaseChanged = false;
 	}
 
-	MovementBase.bHasRelativeLocation = BasedMovement.HasRelativeLocation();
-	MovementBase.bHasRelativeRotation = MovementBase.bHasRelativeLocation && BasedMovement.bRelativeRotation;
+	State.bHasRelativeLocation = BasedMovement.HasRelativeLocation();
+	State.bHasRelativeRotation = State.bHasRelativeLocation && BasedMovement.bRelativeRotation;
 
-	const auto PreviousRotation{MovementBase.Rotation};
+	const auto PreviousRotation{State.Rotation};
 
 	MovementBaseUtility::GetMovementBaseTransform(BasedMovement.MovementBase, BasedMovement.BoneName,
-	                                              MovementBase.Location, MovementBase.Rotation);
+	                                              State.Location, State.Rotation);
 
-	MovementBase.DeltaRotation = MovementBase.bHasRelativeLocation && !MovementBase.bBaseChanged
-		                             ? (MovementBase.Rotation * PreviousRotation.Inverse()).Rotator()
-		                             : FRotator::ZeroRotator;
+	State.DeltaRotation = State.bHasRelativeLocation && !State.bBaseChanged
+		                      ? (State.Rotation * PreviousRotation.Inverse()).Rotator()
+		                      : FRotator::ZeroRotator;
 }
 
-void AAlsCharacter::SetViewMode(const FGameplayTag& NewViewMode)
+void AAlsCharacter::RefreshAnimationInputSnapshot(const float DeltaTime)
 {
-	SetViewMode(NewViewMode, true);
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("AAlsCharacter::RefreshAnimationInputSnapshot"),
+	                            STAT_AAlsCharacter_RefreshAnimationInputSnapshot, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
+	GatherAnimationInputSnapshot(AnimationInputSnapshot, DeltaTime);
 }
 
-void AAlsCharacter::SetViewMode(const FGameplayTag& NewViewMode, const bool bSendRpc)
+void AAlsCharacter::GatherAnimationInputSnapshot(FAlsAnimationInputSnapshot& Snapshot, const float DeltaTime) const
 {
-	if (ViewMode == NewViewMode || GetLocalRole() < ROLE_AutonomousProxy)
+	Snapshot.Frame = GFrameCounter;
+	Snapshot.DeltaTime = DeltaTime;
+	Snapshot.TimeDilation = CustomTimeDilation;
+
+	// The movement base state is refreshed separately for the snapshot instead of being copied from the one refreshed at the start
+	// of the tick, since the character may have been based on something else or the base may have moved since then. The
+	// base change and delta rotation are relative to the previous snapshot, i.e., to the previous animation input.
+
+	RefreshMovementBase(Snapshot.MovementBase);
+
+	Snapshot.ViewRotation = ViewState.Rotation;
+	Snapshot.ViewYawSpeed = ViewState.YawSpeed;
+
+	Snapshot.bHasInput = LocomotionState.bHasInput;
+	Snapshot.bHasVelocity = LocomotionState.bHasVelocity;
+	Snapshot.bMoving = LocomotionState.bMoving;
+	Snapshot.InputYawAngle = LocomotionState.InputYawAngle;
+	Snapshot.Speed = LocomotionState.Speed;
+	Snapshot.Velocity = LocomotionState.Velocity;
+	Snapshot.VelocityYawAngle = LocomotionState.VelocityYawAngle;
+	Snapshot.TargetYawAngle = LocomotionState.TargetYawAngle;
+
+	Snapshot.RagdollingVelocity = RagdollingState.Velocity;
+}
+
+void AAlsCharacter::SetSignificanceTier(const EAlsSignificanceTier NewTier)
+{
+	if (SignificanceTier == NewTier)
 	{
 		return;
 	}
 
-	ViewMode = NewViewMode;
+	SignificanceTier = NewTier;
 
-	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ViewMode, this)
+	// The actor keeps ticking every frame, only the state refreshed in Tick() at the tier interval is affected.
+	// Don't wait for the rest of the previous, longer interval when the character becomes more significant.
 
-	if (bSendRpc)
+	SignificanceRefreshTimeRemaining = FMath::Min(SignificanceRefreshTimeRemaining,
+	                                              UAlsSignificanceSubsystem::GetRefreshInterval(SignificanceTier));
+}
+
+void AAlsCharacter::SendPendingDesiredState()
+{
+	if (PendingDesiredStateFields == EAlsDesiredStateFields::None)
 	{
-		if (GetLocalRole() >= ROLE_Authority)
-		{
-			ClientSetViewMode(ViewMode);
-		}
-		else
+		return;
+	}
+
+	// Send all desired state changes made since the last frame in a single RPC,
+	// instead of sending a separate reliable RPC for each change as soon as it happens.
+
+	FAlsPackedDesiredState NewDesiredState;
+	NewDesiredState.ChangedFields = PendingDesiredStateFields;
+	NewDesiredState.bDesiredAiming = bDesiredAiming;
+	NewDesiredState.ViewMode = ViewMode;
+	NewDesiredState.OverlayMode = OverlayMode;
+	NewDesiredState.DesiredRotationMode = DesiredRotationMode;
+	NewDesiredState.DesiredStance = DesiredStance;
+	NewDesiredState.DesiredGait = DesiredGait;
+
+	PendingDesiredStateFields = EAlsDesiredStateFields::None;
+
+	if (GetLocalRole() >= ROLE_Authority)
+	{
+		if (GetRemoteRole() == ROLE_AutonomousProxy)
 		{
-			ServerSetViewMode(ViewMode);
+			ClientSetDesiredState(NewDesiredState);
 		}
 	}
+	else if (GetLocalRole() == ROLE_AutonomousProxy)
+	{
+		ServerSetDesiredState(NewDesiredState);
+	}
+}
+
+void AAlsCharacter::ClientSetDesiredState_Implementation(const FAlsPackedDesiredState& NewDesiredState)
+{
+	ApplyPackedDesiredState(NewDesiredState);
+}
+
+void AAlsCharacter::ServerSetDesiredState_Implementation(const FAlsPackedDesiredState& NewDesiredState)
+{
+	ApplyPackedDesiredState(NewDesiredState);
+}
+
+void AAlsCharacter::ApplyPackedDesiredState(const FAlsPackedDesiredState& NewDesiredState)
+{
+	// Only apply the fields that were actually changed by the sender, so that
+	// we don't overwrite local changes that haven't been sent to the sender yet.
+
+	if (EnumHasAnyFlags(NewDesiredState.ChangedFields, EAlsDesiredStateFields::ViewMode))
+	{
+		SetViewMode(NewDesiredState.ViewMode, false);
+	}
+
+	if (EnumHasAnyFlags(NewDesiredState.ChangedFields, EAlsDesiredStateFields::OverlayMode))
+	{
+		SetOverlayMode(NewDesiredState.OverlayMode, false);
+	}
+
+	if (EnumHasAnyFlags(NewDesiredState.ChangedFields, EAlsDesiredStateFields::DesiredAiming))
+	{
+		SetDesiredAiming(NewDesiredState.bDesiredAiming, false);
+	}
+
+	if (EnumHasAnyFlags(NewDesiredState.ChangedFields, EAlsDesiredStateFields::DesiredRotationMode))
+	{
+		SetDesiredRotationMode(NewDesiredState.DesiredRotationMode, false);
+	}
+
+	if (EnumHasAnyFlags(NewDesiredState.ChangedFields, EAlsDesiredStateFields::DesiredStance))
+	{
+		SetDesiredStance(NewDesiredState.DesiredStance, false);
+	}
+
+	if (EnumHasAnyFlags(NewDesiredState.ChangedFields, EAlsDesiredStateFields::DesiredGait))
+	{
+		SetDesiredGait(NewDesiredState.DesiredGait, false);
+	}
 }
 
-void AAlsCharacter::ClientSetViewMode_Implementation(const FGameplayTag& NewViewMode)
+void AAlsCharacter::SetViewMode(const FGameplayTag& NewViewMode)
 {
-	SetViewMode(NewViewMode, false);
+	SetViewMode(NewViewMode, true);
 }
 
-void AAlsCharacter::ServerSetViewMode_Implementation(const FGameplayTag& NewViewMode)
+void AAlsCharacter::SetViewMode(const FGameplayTag& NewViewMode, const bool bSendRpc)
 {
-	SetViewMode(NewViewMode, false);
+	if (ViewMode == NewViewMode || GetLocalRole() < ROLE_AutonomousProxy)
+	{
+		return;
+	}
+
+	ViewMode = NewViewMode;
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ViewMode, this)
+
+	if (bSendRpc)
+	{
+		PendingDesiredStateFields |= EAlsDesiredStateFields::ViewMode;
+	}
 }
 
 void AAlsCharacter::OnMovementModeChanged(const EMovementMode PreviousMovementMode, const uint8 PreviousCustomMode)
@@ -590,27 +749,10 @@ void AAlsCharacter::SetDesiredAiming(const bool bNewDesiredAiming, const bool bS
 
 	if (bSendRpc)
 	{
-		if (GetLocalRole() >= ROLE_Authority)
-		{
-			ClientSetDesiredAiming(bDesiredAiming);
-		}
-		else
-		{
-			ServerSetDesiredAiming(bDesiredAiming);
-		}
+		PendingDesiredStateFields |= EAlsDesiredStateFields::DesiredAiming;
 	}
 }
 
-void AAlsCharacter::ClientSetDesiredAiming_Implementation(const bool bNewDesiredAiming)
-{
-	SetDesiredAiming(bNewDesiredAiming, false);
-}
-
-void AAlsCharacter::ServerSetDesiredAiming_Implementation(const bool bNewDesiredAiming)
-{
-	SetDesiredAiming(bNewDesiredAiming, false);
-}
-
 void AAlsCharacter::OnReplicated_DesiredAiming(const bool bPreviousDesiredAiming)
 {
 	OnDesiredAimingChanged(bPreviousDesiredAiming);
@@ -636,27 +778,10 @@ void AAlsCharacter::SetDesiredRotationMode(const FGameplayTag& NewDesiredRotatio
 
 	if (bSendRpc)
 	{
-		if (GetLocalRole() >= ROLE_Authority)
-		{
-			ClientSetDesiredRotationMode(DesiredRotationMode);
-		}
-		else
-		{
-			ServerSetDesiredRotationMode(DesiredRotationMode);
-		}
+		PendingDesiredStateFields |= EAlsDesiredStateFields::DesiredRotationMode;
 	}
 }
 
-void AAlsCharacter::ClientSetDesiredRotationMode_Implementation(const FGameplayTag& NewDesiredRotationMode)
-{
-	SetDesiredRotationMode(NewDesiredRotationMode, false);
-}
-
-void AAlsCharacter::ServerSetDesiredRotationMode_Implementation(const FGameplayTag& NewDesiredRotationMode)
-{
-	SetDesiredRotationMode(NewDesiredRotationMode, false);
-}
-
 void AAlsCharacter::SetRotationMode(const FGameplayTag& NewRotationMode)
 {
 	AlsCharacterMovement->SetRotationMode(NewRotationMode);
@@ -791,29 +916,12 @@ void AAlsCharacter::SetDesiredStance(const FGameplayTag& NewDesiredStance, const
 
 	if (bSendRpc)
 	{
-		if (GetLocalRole() >= ROLE_Authority)
-		{
-			ClientSetDesiredStance(DesiredStance);
-		}
-		else
-		{
-			ServerSetDesiredStance(DesiredStance);
-		}
+		PendingDesiredStateFields |= EAlsDesiredStateFields::DesiredStance;
 	}
 
 	ApplyDesiredStance();
 }
 
-void AAlsCharacter::ClientSetDesiredStance_Implementation(const FGameplayTag& NewDesiredStance)
-{
-	SetDesiredStance(NewDesiredStance, false);
-}
-
-void AAlsCharacter::ServerSetDesiredStance_Implementation(const FGameplayTag& NewDesiredStance)
-{
-	SetDesiredStance(NewDesiredStance, false);
-}
-
 void AAlsCharacter::ApplyDesiredStance()
 {
 	if (!LocomotionAction.IsValid())
@@ -921,27 +1029,10 @@ void AAlsCharacter::SetDesiredGait(const FGameplayTag& NewDesiredGait, const boo
 
 	if (bSendRpc)
 	{
-		if (GetLocalRole() >= ROLE_Authority)
-		{
-			ClientSetDesiredGait(DesiredGait);
-		}
-		else
-		{
-			ServerSetDesiredGait(DesiredGait);
-		}
+		PendingDesiredStateFields |= EAlsDesiredStateFields::DesiredGait;
 	}
 }
 
-void AAlsCharacter::ClientSetDesiredGait_Implementation(const FGameplayTag& NewDesiredGait)
-{
-	SetDesiredGait(NewDesiredGait, false);
-}
-
-void AAlsCharacter::ServerSetDesiredGait_Implementation(const FGameplayTag& NewDesiredGait)
-{
-	SetDesiredGait(NewDesiredGait, false);
-}
-
 void AAlsCharacter::SetGait(const FGameplayTag& NewGait)
 {
 	if (Gait != NewGait)
@@ -1065,27 +1156,10 @@ void AAlsCharacter::SetOverlayMode(const FGameplayTag& NewOverlayMode, const boo
 
 	if (bSendRpc)
 	{
-		if (GetLocalRole() >= ROLE_Authority)
-		{
-			ClientSetOverlayMode(OverlayMode);
-		}
-		else
-		{
-			ServerSetOverlayMode(OverlayMode);
-		}
+		PendingDesiredStateFields |= EAlsDesiredStateFields::OverlayMode;
 	}
 }
 
-void AAlsCharacter::ClientSetOverlayMode_Implementation(const FGameplayTag& NewOverlayMode)
-{
-	SetOverlayMode(NewOverlayMode, false);
-}
-
-void AAlsCharacter::ServerSetOverlayMode_Implementation(const FGameplayTag& NewOverlayMode)
-{
-	SetOverlayMode(NewOverlayMode, false);
-}
-
 void AAlsCharacter::OnReplicated_OverlayMode(const FGameplayTag& PreviousOverlayMode)
 {
 	OnOverlayModeChanged(PreviousOverlayMode);
@@ -1319,6 +1393,17 @@ void AAlsCharacter::RefreshViewNetworkSmoothing(const float DeltaTime)
 		NetworkSmoothing.CurrentRotation.Normalize();
 	}
 
+	if (SignificanceTier >= EAlsSignificanceTier::Medium &&
+	    NetworkSmoothing.ServerTime - NetworkSmoothing.ClientTime > AlsCharacterConstants::ReducedViewNetworkSmoothingTime)
+	{
+		// Distant characters don't need full smoothing because the difference is barely noticeable, but snapping
+		// the view would cause a visible pop, so the rest of the smoothing is compressed into a short blend instead.
+
+		NetworkSmoothing.InitialRotation = NetworkSmoothing.CurrentRotation;
+		NetworkSmoothing.ClientTime = NetworkSmoothing.ServerTime - AlsCharacterConstants::ReducedViewNetworkSmoothingTime;
+		NetworkSmoothing.Duration = AlsCharacterConstants::ReducedViewNetworkSmoothingTime;
+	}
+
 	NetworkSmoothing.ClientTime += DeltaTime;
 
 	const auto InterpolationAmount{
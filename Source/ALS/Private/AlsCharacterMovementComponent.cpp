@@ -1,18 +1,94 @@
 #include "AlsCharacterMovementComponent.h"
 
 #include "AlsCharacter.h"
+#include "AlsNetworkSmoothingSubsystem.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Curves/CurveVector.h"
 #include "Engine/World.h"
 #include "GameFramework/Controller.h"
+#include "Utility/AlsLog.h"
 #include "Utility/AlsMacros.h"
 #include "Utility/AlsRotation.h"
+#include "Utility/AlsTagIndexRegistry.h"
 #include "Utility/AlsUtility.h"
 #include "Utility/AlsVector.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsCharacterMovementComponent)
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Floor Cache Hits"), STAT_UAlsCharacterMovementComponent_FloorCacheHits, STATGROUP_Als);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Saved Moves Allocated"), STAT_FAlsNetworkPredictionData_SavedMovesAllocated, STATGROUP_Als);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Autonomous Moves Time (ms)"), STAT_UAlsCharacterMovementComponent_AutonomousMovesTime, STATGROUP_Als);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Merged Autonomous Moves"), STAT_UAlsCharacterMovementComponent_MergedAutonomousMoves, STATGROUP_Als);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Server Moves Received"), STAT_UAlsCharacterMovementComponent_ServerMovesReceived, STATGROUP_Als);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Corrections Sent"), STAT_UAlsCharacterMovementComponent_ClientCorrectionsSent, STATGROUP_Als);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Corrections Received"), STAT_UAlsCharacterMovementComponent_ClientCorrectionsReceived, STATGROUP_Als);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Grounded Movement Settings Memo Hits"), STAT_UAlsCharacterMovementComponent_GroundedMovementSettingsMemoHits, STATGROUP_Als);
+
+namespace AlsCharacterMovementConsoleVariables
+{
+	static TAutoConsoleVariable<bool> UseBakedCurves{
+		TEXT("Als.Movement.UseBakedCurves"), true,
+		TEXT("If enabled, grounded movement settings are sampled from lookup tables baked from the movement settings ")
+		TEXT("curves. If disabled, the curves are evaluated exactly."),
+		ECVF_Default
+	};
+
+	static TAutoConsoleVariable<bool> MemoizeGroundedMovementSettings{
+		TEXT("Als.Movement.MemoizeGroundedMovementSettings"), true,
+		TEXT("If enabled, grounded movement settings calculated during the first simulation of a saved move ")
+		TEXT("are reused when the move is replayed after a server correction, as long as their inputs didn't change."),
+		ECVF_Default
+	};
+
+	static TAutoConsoleVariable<bool> VerifyGroundedMovementSettingsMemo{
+		TEXT("Als.Movement.VerifyGroundedMovementSettingsMemo"), false,
+		TEXT("If enabled, grounded movement settings reused during move replays are also calculated again ")
+		TEXT("and compared bit for bit with the reused ones. Mismatches are counted and reported as errors."),
+		ECVF_Default
+	};
+
+	static TAutoConsoleVariable<bool> UseFloorCache{
+		TEXT("Als.Movement.UseFloorCache"), false,
+		TEXT("If enabled, floor results on static geometry are reused for nearby capsule locations ")
+		TEXT("instead of performing the floor sweeps again. Disabled by default, because static geometry ")
+		TEXT("spawned or destroyed under a character can go unnoticed for a few frames."),
+		ECVF_Default
+	};
+
+	static TAutoConsoleVariable<bool> BatchNetworkSmoothing{
+		TEXT("Als.Movement.BatchNetworkSmoothing"), true,
+		TEXT("If enabled, the linear and exponential network smoothing of simulated proxies is ")
+		TEXT("interpolated in parallel for all of them instead of separately in each character's tick."),
+		ECVF_Default
+	};
+
+	static TAutoConsoleVariable<float> FloorCacheTolerance{
+		TEXT("Als.Movement.FloorCacheTolerance"), 0.1f,
+		TEXT("Maximum distance between capsule locations at which a cached floor result can be reused."),
+		ECVF_Default
+	};
+}
+
+namespace AlsAdaptiveSubstepsConstants
+{
+	// Cosine of 1 degree.
+	constexpr auto StableFloorNormalDotThreshold{0.99985f};
+
+	constexpr auto StableVelocityDeltaThreshold{1.0f};
+}
+
+namespace AlsSmoothClientPositionConstants
+{
+	constexpr auto RecentlyRenderedTolerance{0.2f};
+}
+
+namespace AlsFloorCacheConstants
+{
+	// Limits how long static geometry spawned or destroyed under the character can go unnoticed.
+	constexpr uint64 MaxAgeFrames{30};
+}
+
 void FAlsCharacterNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& Move, const ENetworkMoveType MoveType)
 {
 	Super::ClientFillNetworkMoveData(Move, MoveType);
@@ -29,9 +105,57 @@ bool FAlsCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& Moveme
 {
 	Super::Serialize(Movement, Archive, Map, MoveType);
 
-	NetSerializeOptionalValue(Archive.IsSaving(), Archive, RotationMode, AlsRotationModeTags::ViewDirection.GetTag(), Map);
-	NetSerializeOptionalValue(Archive.IsSaving(), Archive, Stance, AlsStanceTags::Standing.GetTag(), Map);
-	NetSerializeOptionalValue(Archive.IsSaving(), Archive, MaxAllowedGait, AlsGaitTags::Running.GetTag(), Map);
+	// The new move is always serialized first, so pending and old moves sent in the same
+	// packet only need to send the fields that are different from the new move.
+
+	const auto* NewMoveData{
+		MoveType != ENetworkMoveType::NewMove
+			? static_cast<const FAlsCharacterNetworkMoveData*>(Movement.GetNetworkMoveDataContainer().GetNewMoveData())
+			: nullptr
+	};
+
+	uint8 ChangedFields{0b111};
+
+	if (NewMoveData != nullptr)
+	{
+		if (Archive.IsSaving())
+		{
+			ChangedFields = (RotationMode != NewMoveData->RotationMode ? 0b001 : 0) |
+			                (Stance != NewMoveData->Stance ? 0b010 : 0) |
+			                (MaxAllowedGait != NewMoveData->MaxAllowedGait ? 0b100 : 0);
+		}
+
+		Archive.SerializeBits(&ChangedFields, 3);
+	}
+
+	// Built-in tags are sent as small indices, so that usually all three fields fit in a single byte.
+
+	if (ChangedFields & 0b001)
+	{
+		AlsTagIndexRegistry::NetSerializeTag(Archive, Map, EAlsTagFamily::RotationMode, RotationMode);
+	}
+	else if (Archive.IsLoading())
+	{
+		RotationMode = NewMoveData->RotationMode;
+	}
+
+	if (ChangedFields & 0b010)
+	{
+		AlsTagIndexRegistry::NetSerializeTag(Archive, Map, EAlsTagFamily::Stance, Stance);
+	}
+	else if (Archive.IsLoading())
+	{
+		Stance = NewMoveData->Stance;
+	}
+
+	if (ChangedFields & 0b100)
+	{
+		AlsTagIndexRegistry::NetSerializeTag(Archive, Map, EAlsTagFamily::Gait, MaxAllowedGait);
+	}
+	else if (Archive.IsLoading())
+	{
+		MaxAllowedGait = NewMoveData->MaxAllowedGait;
+	}
 
 	return !Archive.IsError();
 }
@@ -43,6 +167,67 @@ FAlsCharacterNetworkMoveDataContainer::FAlsCharacterNetworkMoveDataContainer()
 	OldMoveData = &MoveData[2];
 }
 
+namespace AlsGroundedMovementSettingsMemo
+{
+	// Compares the bits instead of the values, so that, for example, positive and negative zeros are not considered equal.
+	template <typename ValueType>
+	bool IsBitwiseEqual(const ValueType& A, const ValueType& B)
+	{
+		return FMemory::Memcmp(&A, &B, sizeof(ValueType)) == 0;
+	}
+}
+
+bool FAlsGroundedMovementSettingsMemoEntry::HasSameInputs(const FAlsGroundedMovementSettingsMemoEntry& Other) const
+{
+	using namespace AlsGroundedMovementSettingsMemo;
+
+	return GaitSettings == Other.GaitSettings &&
+	       MovementSettings == Other.MovementSettings &&
+	       MaxAllowedGait == Other.MaxAllowedGait &&
+	       bUseBakedCurves == Other.bUseBakedCurves &&
+	       IsBitwiseEqual(Velocity, Other.Velocity) &&
+	       IsBitwiseEqual(ViewRotation, Other.ViewRotation) &&
+	       IsBitwiseEqual(GravityDirection, Other.GravityDirection);
+}
+
+bool FAlsGroundedMovementSettingsMemoEntry::HasSameSettings(const FAlsGroundedMovementSettingsMemoEntry& Other) const
+{
+	using namespace AlsGroundedMovementSettingsMemo;
+
+	return IsBitwiseEqual(GaitAmount, Other.GaitAmount) &&
+	       IsBitwiseEqual(MaxWalkSpeed, Other.MaxWalkSpeed) &&
+	       IsBitwiseEqual(MaxAcceleration, Other.MaxAcceleration) &&
+	       IsBitwiseEqual(BrakingDeceleration, Other.BrakingDeceleration) &&
+	       IsBitwiseEqual(GroundFriction, Other.GroundFriction);
+}
+
+const FAlsGroundedMovementSettingsMemoEntry* FAlsGroundedMovementSettingsMemo::Find(const FAlsGroundedMovementSettingsMemoEntry& Inputs) const
+{
+	for (auto i{0}; i < EntriesCount; i++)
+	{
+		if (Entries[i].HasSameInputs(Inputs))
+		{
+			return &Entries[i];
+		}
+	}
+
+	return nullptr;
+}
+
+void FAlsGroundedMovementSettingsMemo::Add(const FAlsGroundedMovementSettingsMemoEntry& Entry)
+{
+	if (EntriesCount < Entries.Num() && Find(Entry) == nullptr)
+	{
+		Entries[EntriesCount] = Entry;
+		EntriesCount += 1;
+	}
+}
+
+void FAlsGroundedMovementSettingsMemo::Reset()
+{
+	EntriesCount = 0;
+}
+
 void FAlsSavedMove::Clear()
 {
 	Super::Clear();
@@ -50,6 +235,8 @@ void FAlsSavedMove::Clear()
 	RotationMode = AlsRotationModeTags::ViewDirection;
 	Stance = AlsStanceTags::Standing;
 	MaxAllowedGait = AlsGaitTags::Running;
+
+	GroundedMovementSettingsMemo.Reset();
 }
 
 void FAlsSavedMove::SetMoveFor(ACharacter* Character, const float NewDeltaTime, const FVector& NewAcceleration,
@@ -57,15 +244,34 @@ void FAlsSavedMove::SetMoveFor(ACharacter* Character, const float NewDeltaTime,
 {
 	Super::SetMoveFor(Character, NewDeltaTime, NewAcceleration, PredictionData);
 
-	const auto* Movement{Cast<UAlsCharacterMovementComponent>(Character->GetCharacterMovement())};
+	auto* Movement{Cast<UAlsCharacterMovementComponent>(Character->GetCharacterMovement())};
 	if (IsValid(Movement))
 	{
 		RotationMode = Movement->RotationMode;
 		Stance = Movement->Stance;
 		MaxAllowedGait = Movement->MaxAllowedGait;
+
+		AccelDotThresholdCombine = FMath::Cos(FMath::DegreesToRadians(Movement->MoveCombiningAccelerationAngleTolerance));
+
+		// The move is simulated right after this, and the grounded movement settings
+		// calculated during the simulation are recorded into the move in PostUpdate().
+
+		Movement->GroundedMovementSettingsMemo.Reset();
+		Movement->bRecordingGroundedMovementSettings = true;
+		Movement->bReplayingGroundedMovementSettings = false;
 	}
 }
 
+bool FAlsSavedMove::IsImportantMove(const FSavedMovePtr& LastAckedMove) const
+{
+	const auto* AlsLastAckedMove{static_cast<FAlsSavedMove*>(LastAckedMove.Get())};
+
+	return RotationMode != AlsLastAckedMove->RotationMode ||
+	       Stance != AlsLastAckedMove->Stance ||
+	       MaxAllowedGait != AlsLastAckedMove->MaxAllowedGait ||
+	       Super::IsImportantMove(LastAckedMove);
+}
+
 bool FAlsSavedMove::CanCombineWith(const FSavedMovePtr& NewMovePtr, ACharacter* Character, const float MaxDeltaTime) const
 {
 	const auto* NewMove{static_cast<FAlsSavedMove*>(NewMovePtr.Get())};
@@ -111,6 +317,27 @@ void FAlsSavedMove::PrepMoveFor(ACharacter* Character)
 		Movement->MaxAllowedGait = MaxAllowedGait;
 
 		Movement->RefreshGaitSettings();
+
+		Movement->GroundedMovementSettingsMemo = GroundedMovementSettingsMemo;
+		Movement->bRecordingGroundedMovementSettings = false;
+		Movement->bReplayingGroundedMovementSettings = true;
+	}
+}
+
+void FAlsSavedMove::PostUpdate(ACharacter* Character, const EPostUpdateMode PostUpdateMode)
+{
+	Super::PostUpdate(Character, PostUpdateMode);
+
+	auto* Movement{Cast<UAlsCharacterMovementComponent>(Character->GetCharacterMovement())};
+	if (IsValid(Movement))
+	{
+		if (PostUpdateMode == PostUpdate_Record && Movement->bRecordingGroundedMovementSettings)
+		{
+			GroundedMovementSettingsMemo = Movement->GroundedMovementSettingsMemo;
+		}
+
+		Movement->bRecordingGroundedMovementSettings = false;
+		Movement->bReplayingGroundedMovementSettings = false;
 	}
 }
 
@@ -118,6 +345,28 @@ FAlsNetworkPredictionData::FAlsNetworkPredictionData(const UCharacterMovementCom
 
 FSavedMovePtr FAlsNetworkPredictionData::AllocateNewMove()
 {
+	// Simulated proxies also create client prediction data, but never save moves, so the free moves
+	// pool is only filled when the first move is saved, and no more moves are allocated after that
+	// during gameplay unless more moves than the pool can hold are in flight.
+
+	if (!bFreeMovesPrefilled)
+	{
+		bFreeMovesPrefilled = true;
+
+		FreeMoves.Reserve(MaxFreeMoveCount);
+
+		for (auto i{0}; i < MaxFreeMoveCount; i++)
+		{
+			FreeMoves.Add(MakeShared<FAlsSavedMove>());
+		}
+
+		return MakeShared<FAlsSavedMove>();
+	}
+
+	OverflowSavedMovesCount += 1;
+
+	INC_DWORD_STAT(STAT_FAlsNetworkPredictionData_SavedMovesAllocated);
+
 	return MakeShared<FAlsSavedMove>();
 }
 
@@ -199,6 +448,22 @@ void UAlsCharacterMovementComponent::BeginPlay()
 	Super::BeginPlay();
 }
 
+void UAlsCharacterMovementComponent::OnUnregister()
+{
+	if (bNetworkSmoothingBatched)
+	{
+		bNetworkSmoothingBatched = false;
+
+		auto* NetworkSmoothingSubsystem{IsValid(GetWorld()) ? GetWorld()->GetSubsystem<UAlsNetworkSmoothingSubsystem>() : nullptr};
+		if (IsValid(NetworkSmoothingSubsystem))
+		{
+			NetworkSmoothingSubsystem->UnregisterMovement(*this);
+		}
+	}
+
+	Super::OnUnregister();
+}
+
 FVector UAlsCharacterMovementComponent::ConsumeInputVector()
 {
 	auto InputVector{Super::ConsumeInputVector()};
@@ -331,6 +596,10 @@ void UAlsCharacterMovementComponent::MoveSmooth(const FVector& InVelocity, const
 
 void UAlsCharacterMovementComponent::PhysWalking(const float DeltaTime, int32 IterationsCount)
 {
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsCharacterMovementComponent::PhysWalking"),
+	                            STAT_UAlsCharacterMovementComponent_PhysWalking, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
 	RefreshGroundedMovementSettings();
 
 	auto Iterations{IterationsCount};
@@ -370,12 +639,31 @@ void UAlsCharacterMovementComponent::PhysWalking(const float DeltaTime, int32 It
 	const EMovementMode StartingMovementMode = MovementMode;
 	const uint8 StartingCustomMovementMode = CustomMovementMode;
 
+	// TODO Start of custom ALS code block.
+
+	auto bPreviousIterationStable{false};
+
+	// TODO End of custom ALS code block.
+
 	// Perform the move
 	while ( (remainingTime >= MIN_TICK_TIME) && (Iterations < MaxSimulationIterations) && CharacterOwner && (CharacterOwner->Controller || bRunPhysicsWithNoController || HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocity() || (CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)) )
 	{
 		Iterations++;
 		bJustTeleported = false;
-		const float timeTick = GetSimulationTimeStep(remainingTime, Iterations);
+		float timeTick = GetSimulationTimeStep(remainingTime, Iterations);
+
+		// TODO Start of custom ALS code block.
+
+		if (bPreviousIterationStable)
+		{
+			// Merge the following substeps into one, since the movement is unlikely to change until the end of this frame.
+			timeTick = FMath::Min(remainingTime, FMath::Max(timeTick, AdaptiveWalkingMaxSubstepTime));
+		}
+
+		bPreviousIterationStable = false;
+
+		// TODO End of custom ALS code block.
+
 		remainingTime -= timeTick;
 
 		// Save current values
@@ -577,6 +865,24 @@ void UAlsCharacterMovementComponent::PhysWalking(const float DeltaTime, int32 It
 			remainingTime = 0.f;
 			break;
 		}
+
+		// TODO Start of custom ALS code block.
+
+		// The iteration is considered stable if the character moved along the same static walkable floor without
+		// stepping, getting blocked or noticeably changing its velocity. Both the autonomous proxy and the
+		// server make this decision from the same movement state, so the merged substeps stay in sync.
+
+		bPreviousIterationStable = bAllowAdaptiveWalkingSubsteps && IsMovingOnGround() &&
+		                           !bJustTeleported && !StepDownResult.bComputedFloor &&
+		                           OldFloor.IsWalkableFloor() && CurrentFloor.IsWalkableFloor() &&
+		                           !CurrentFloor.HitResult.bStartPenetrating &&
+		                           !MovementBaseUtility::IsDynamicBase(GetMovementBase()) &&
+		                           (CurrentFloor.HitResult.ImpactNormal | OldFloor.HitResult.ImpactNormal) >=
+		                           AlsAdaptiveSubstepsConstants::StableFloorNormalDotThreshold &&
+		                           FVector::DistSquared(Velocity, OldVelocity) <=
+		                           FMath::Square(AlsAdaptiveSubstepsConstants::StableVelocityDeltaThreshold);
+
+		// TODO End of custom ALS code block.
 	}
 
 	if (IsMovingOnGround())
@@ -619,9 +925,97 @@ void UAlsCharacterMovementComponent::PhysCustom(const float DeltaTime, int32 Ite
 	Super::PhysCustom(DeltaTime, IterationsCount);
 }
 
-void UAlsCharacterMovementComponent::ComputeFloorDist(const FVector& CapsuleLocation, float LineDistance,
-                                                      float SweepDistance, FFindFloorResult& OutFloorResult,
-                                                      float SweepRadius, const FHitResult* DownwardSweepResult) const
+void UAlsCharacterMovementComponent::ComputeFloorDist(const FVector& CapsuleLocation, const float LineDistance,
+                                                      const float SweepDistance, FFindFloorResult& OutFloorResult,
+                                                      const float SweepRadius, const FHitResult* DownwardSweepResult) const
+{
+	if (!AlsCharacterMovementConsoleVariables::UseFloorCache.GetValueOnGameThread() || DownwardSweepResult != nullptr)
+	{
+		ComputeFloorDistUncached(CapsuleLocation, LineDistance, SweepDistance, OutFloorResult, SweepRadius, DownwardSweepResult);
+		return;
+	}
+
+	if (TryGetCachedFloor(CapsuleLocation, LineDistance, SweepDistance, SweepRadius, OutFloorResult))
+	{
+		INC_DWORD_STAT(STAT_UAlsCharacterMovementComponent_FloorCacheHits);
+		return;
+	}
+
+	ComputeFloorDistUncached(CapsuleLocation, LineDistance, SweepDistance, OutFloorResult, SweepRadius, nullptr);
+	CacheFloor(CapsuleLocation, LineDistance, SweepDistance, SweepRadius, OutFloorResult);
+}
+
+bool UAlsCharacterMovementComponent::TryGetCachedFloor(const FVector& CapsuleLocation, const float LineDistance,
+                                                       const float SweepDistance, const float SweepRadius,
+                                                       FFindFloorResult& OutFloorResult) const
+{
+	float CapsuleRadius, CapsuleHalfHeight;
+	CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+
+	const auto Tolerance{AlsCharacterMovementConsoleVariables::FloorCacheTolerance.GetValueOnGameThread()};
+
+	for (const auto& Entry : FloorCache)
+	{
+		if (Entry.Frame == 0 || GFrameCounter - Entry.Frame > AlsFloorCacheConstants::MaxAgeFrames ||
+		    Entry.LineDistance != LineDistance || Entry.SweepDistance != SweepDistance || Entry.SweepRadius != SweepRadius ||
+		    Entry.CapsuleRadius != CapsuleRadius || Entry.CapsuleHalfHeight != CapsuleHalfHeight ||
+		    FVector::DistSquared(Entry.CapsuleLocation, CapsuleLocation) > FMath::Square(Tolerance))
+		{
+			continue;
+		}
+
+		// Only static geometry is guaranteed to be in the same place as when the entry was added.
+
+		const auto* FloorComponent{Entry.FloorResult.HitResult.GetComponent()};
+		if (!IsValid(FloorComponent) || FloorComponent->Mobility != EComponentMobility::Static)
+		{
+			continue;
+		}
+
+		// Compensate for the small vertical offset between the requested and the cached capsule locations.
+
+		const auto VerticalOffset{UE_REAL_TO_FLOAT(GetGravitySpaceZ(CapsuleLocation - Entry.CapsuleLocation))};
+
+		OutFloorResult = Entry.FloorResult;
+		OutFloorResult.FloorDist += VerticalOffset;
+
+		if (OutFloorResult.bLineTrace)
+		{
+			OutFloorResult.LineDist += VerticalOffset;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+void UAlsCharacterMovementComponent::CacheFloor(const FVector& CapsuleLocation, const float LineDistance,
+                                                const float SweepDistance, const float SweepRadius,
+                                                const FFindFloorResult& FloorResult) const
+{
+	const auto* FloorComponent{FloorResult.HitResult.GetComponent()};
+	if (!FloorResult.bBlockingHit || !IsValid(FloorComponent) || FloorComponent->Mobility != EComponentMobility::Static)
+	{
+		return;
+	}
+
+	auto& Entry{FloorCache[NextFloorCacheIndex]};
+	NextFloorCacheIndex = (NextFloorCacheIndex + 1) % FloorCache.Num();
+
+	CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(Entry.CapsuleRadius, Entry.CapsuleHalfHeight);
+
+	Entry.CapsuleLocation = CapsuleLocation;
+	Entry.LineDistance = LineDistance;
+	Entry.SweepDistance = SweepDistance;
+	Entry.SweepRadius = SweepRadius;
+	Entry.Frame = GFrameCounter;
+	Entry.FloorResult = FloorResult;
+}
+
+void UAlsCharacterMovementComponent::ComputeFloorDistUncached(const FVector& CapsuleLocation, float LineDistance,
+                                                              float SweepDistance, FFindFloorResult& OutFloorResult,
+                                                              float SweepRadius, const FHitResult* DownwardSweepResult) const
 {
 	// TODO Copied with modifications from UCharacterMovementComponent::ComputeFloorDist().
 	// TODO After the release of a new engine version, this code should be updated to match the source code.
@@ -795,6 +1189,10 @@ void UAlsCharacterMovementComponent::ComputeFloorDist(const FVector& CapsuleLoca
 
 void UAlsCharacterMovementComponent::PerformMovement(const float DeltaTime)
 {
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsCharacterMovementComponent::PerformMovement"),
+	                            STAT_UAlsCharacterMovementComponent_PerformMovement, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
 	Super::PerformMovement(DeltaTime);
 
 	// Update the ServerLastTransformUpdateTimeStamp when the control rotation
@@ -828,8 +1226,70 @@ FNetworkPredictionData_Client* UAlsCharacterMovementComponent::GetPredictionData
 	return ClientPredictionData;
 }
 
+float UAlsCharacterMovementComponent::GetClientNetSendDeltaTime(const APlayerController* Player,
+                                                                const FNetworkPredictionData_Client_Character* ClientData,
+                                                                const FSavedMovePtr& NewMove) const
+{
+	const auto NetSendDeltaTime{Super::GetClientNetSendDeltaTime(Player, ClientData, NewMove)};
+
+	// Send moves less often while nothing important happens, since the server would get almost identical moves anyway.
+
+	if (SteadyStateClientNetSendDeltaTime > NetSendDeltaTime && NewMove.IsValid() &&
+	    ClientData->LastAckedMove.IsValid() && !NewMove->IsImportantMove(ClientData->LastAckedMove))
+	{
+		return SteadyStateClientNetSendDeltaTime;
+	}
+
+	return NetSendDeltaTime;
+}
+
+void UAlsCharacterMovementComponent::ServerMovePacked_ServerReceive(const FCharacterServerMovePackedBits& PackedBits)
+{
+	ServerMovesReceivedCount += 1;
+
+	INC_DWORD_STAT(STAT_UAlsCharacterMovementComponent_ServerMovesReceived);
+
+	Super::ServerMovePacked_ServerReceive(PackedBits);
+}
+
+void UAlsCharacterMovementComponent::SendClientAdjustment()
+{
+	const auto* ServerData{HasValidData() ? GetPredictionData_Server_Character() : nullptr};
+
+	const auto bCorrectionPending{
+		ServerData != nullptr && ServerData->PendingAdjustment.TimeStamp > 0.0f && !ServerData->PendingAdjustment.bAckGoodMove
+	};
+
+	Super::SendClientAdjustment();
+
+	// The pending adjustment is reset once it has been sent.
+
+	if (bCorrectionPending && ServerData->PendingAdjustment.TimeStamp <= 0.0f)
+	{
+		ClientCorrectionsSentCount += 1;
+
+		INC_DWORD_STAT(STAT_UAlsCharacterMovementComponent_ClientCorrectionsSent);
+	}
+}
+
+void UAlsCharacterMovementComponent::ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse)
+{
+	if (!MoveResponse.ClientAdjustment.bAckGoodMove)
+	{
+		ClientCorrectionsReceivedCount += 1;
+
+		INC_DWORD_STAT(STAT_UAlsCharacterMovementComponent_ClientCorrectionsReceived);
+	}
+
+	Super::ClientHandleMoveResponse(MoveResponse);
+}
+
 void UAlsCharacterMovementComponent::SmoothClientPosition(const float DeltaTime)
 {
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsCharacterMovementComponent::SmoothClientPosition"),
+	                            STAT_UAlsCharacterMovementComponent_SmoothClientPosition, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
 	auto* PredictionData{GetPredictionData_Client_Character()};
 	const auto* Mesh{HasValidData() ? CharacterOwner->GetMesh() : nullptr};
 
@@ -846,13 +1306,134 @@ void UAlsCharacterMovementComponent::SmoothClientPosition(const float DeltaTime)
 		PredictionData->MeshRotationTarget = NewRotation;
 	}
 
+	// Only the linear and exponential smoothing modes are skipped, since they only offset the mesh. The replay
+	// smoothing mode moves the updated component itself, so it must keep running even if the mesh is not visible.
+
+	if (PredictionData != nullptr && IsValid(Mesh) &&
+	    (NetworkSmoothingMode == ENetworkSmoothingMode::Linear || NetworkSmoothingMode == ENetworkSmoothingMode::Exponential) &&
+	    !IsNetMode(NM_DedicatedServer) && !Mesh->WasRecentlyRendered(AlsSmoothClientPositionConstants::RecentlyRenderedTolerance))
+	{
+		// Nobody sees the mesh, so there is no point in smoothing its movement. Instead, finish the smoothing
+		// immediately, so that the mesh is in the right place once it becomes visible again, and skip it until then.
+
+		if (!bNetworkSmoothingComplete)
+		{
+			PredictionData->MeshTranslationOffset = FVector::ZeroVector;
+			PredictionData->MeshRotationOffset = PredictionData->MeshRotationTarget;
+
+			bNetworkSmoothingComplete = true;
+
+			// Same as in Super::SmoothClientPosition(), render static meshes are not updated.
+
+			if (!Mesh->bRenderStatic)
+			{
+				SmoothClientPosition_UpdateVisuals();
+			}
+		}
+
+		return;
+	}
+
+	if (PredictionData != nullptr && TryGatherNetworkSmoothing(DeltaTime))
+	{
+		// The interpolation and the mesh update are performed later in this frame by the network smoothing subsystem.
+		return;
+	}
+
 	Super::SmoothClientPosition(DeltaTime);
 }
 
+bool UAlsCharacterMovementComponent::TryGatherNetworkSmoothing(const float DeltaTime)
+{
+	if (!AlsCharacterMovementConsoleVariables::BatchNetworkSmoothing.GetValueOnGameThread() ||
+	    (NetworkSmoothingMode != ENetworkSmoothingMode::Linear && NetworkSmoothingMode != ENetworkSmoothingMode::Exponential) ||
+	    !HasValidData() || CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy || IsNetMode(NM_DedicatedServer))
+	{
+		return false;
+	}
+
+	auto* NetworkSmoothingSubsystem{GetWorld()->GetSubsystem<UAlsNetworkSmoothingSubsystem>()};
+	if (!IsValid(NetworkSmoothingSubsystem))
+	{
+		return false;
+	}
+
+	if (!bNetworkSmoothingBatched)
+	{
+		// The ticks are already queued for this frame, so the new tick prerequisites only take effect from the next frame.
+
+		bNetworkSmoothingBatched = true;
+
+		NetworkSmoothingSubsystem->RegisterMovement(*this);
+	}
+
+	return NetworkSmoothingSubsystem->GatherSmoothing(*this, DeltaTime);
+}
+
 void UAlsCharacterMovementComponent::MoveAutonomous(const float ClientTimeStamp, const float DeltaTime,
                                                     const uint8 CompressedFlags, const FVector& NewAcceleration)
 {
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsCharacterMovementComponent::MoveAutonomous"),
+	                            STAT_UAlsCharacterMovementComponent_MoveAutonomous, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
 	const auto* MoveData{static_cast<FAlsCharacterNetworkMoveData*>(GetCurrentNetworkMoveData())};
+
+	auto MoveDeltaTime{DeltaTime};
+
+	bAutonomousMoveMerged = false;
+	bAutonomousMoveIncludesMergedMoves = false;
+
+	// Clients also call this function when they replay their saved moves after a server correction. These
+	// moves must be simulated exactly as they were originally, so the movement budget is only used on the server.
+
+	if (MovementBudget.bEnabled && CharacterOwner->GetLocalRole() >= ROLE_Authority)
+	{
+		// The budget is refilled by the client's move delta time rather than by the server's time, so
+		// that it doesn't depend on when the server receives the moves or how long it takes to simulate them.
+
+		RemainingMoveBudget = FMath::Min(RemainingMoveBudget + DeltaTime * MovementBudget.MaxMovesPerSecond,
+		                                 MovementBudget.MaxAccumulatedMoves);
+
+		const auto bCanMerge{CanMergeAutonomousMove(CompressedFlags, NewAcceleration, MoveData)};
+
+		if (RemainingMoveBudget < 1.0f && bCanMerge)
+		{
+			// The budget is exhausted, so instead of simulating this move, merge it into the next affordable move.
+
+			MergedMoveDeltaTime = FMath::Min(MergedMoveDeltaTime + DeltaTime, MovementBudget.MaxMergedMoveDeltaTime);
+			bAutonomousMoveMerged = true;
+
+			MergedAutonomousMovesCount += 1;
+
+			INC_DWORD_STAT(STAT_UAlsCharacterMovementComponent_MergedAutonomousMoves);
+			return;
+		}
+
+		RemainingMoveBudget = FMath::Max(0.0f, RemainingMoveBudget - 1.0f);
+
+		bAutonomousMoveIncludesMergedMoves = MergedMoveDeltaTime > 0.0f;
+
+		if (bCanMerge)
+		{
+			MoveDeltaTime = FMath::Max(DeltaTime, FMath::Min(DeltaTime + MergedMoveDeltaTime, MovementBudget.MaxMergedMoveDeltaTime));
+		}
+		else if (MergedMoveDeltaTime > 0.0f)
+		{
+			// This move differs from the merged moves, so simulate them separately with their own flags and acceleration
+			// before the rotation mode, stance and max allowed gait of this move are applied, as the client did.
+
+			Super::MoveAutonomous(ClientTimeStamp, MergedMoveDeltaTime, PreviousAutonomousMoveFlags, PreviousAutonomousMoveAcceleration);
+
+			SimulatedAutonomousMovesCount += 1;
+		}
+
+		MergedMoveDeltaTime = 0.0f;
+	}
+
+	PreviousAutonomousMoveFlags = CompressedFlags;
+	PreviousAutonomousMoveAcceleration = NewAcceleration;
+
 	if (MoveData != nullptr)
 	{
 		RotationMode = MoveData->RotationMode;
@@ -862,7 +1443,17 @@ void UAlsCharacterMovementComponent::MoveAutonomous(const float ClientTimeStamp,
 		RefreshGaitSettings();
 	}
 
-	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAcceleration);
+	const auto StartCycles{FPlatformTime::Cycles64()};
+
+	Super::MoveAutonomous(ClientTimeStamp, MoveDeltaTime, CompressedFlags, NewAcceleration);
+
+	SimulatedAutonomousMovesCount += 1;
+
+	const auto MoveTime{FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles)};
+
+	AutonomousMovesTime += MoveTime;
+
+	INC_FLOAT_STAT_BY(STAT_UAlsCharacterMovementComponent_AutonomousMovesTime, static_cast<float>(MoveTime * 1000.0));
 
 	// Process view network smoothing on the listen server.
 
@@ -882,12 +1473,85 @@ void UAlsCharacterMovementComponent::MoveAutonomous(const float ClientTimeStamp,
 	}
 }
 
+void UAlsCharacterMovementComponent::ServerMoveHandleClientError(const float ClientTimeStamp, const float DeltaTime,
+                                                                 const FVector& Acceleration, const FVector& RelativeClientLocation,
+                                                                 UPrimitiveComponent* ClientMovementBase, const FName ClientBaseBoneName,
+                                                                 const uint8 ClientMovementMode)
+{
+	// The server is intentionally behind the client after a merged move, so comparing their locations would only force
+	// an unnecessary correction. The next simulated move catches up and is checked against the client's location as usual.
+
+	if (!bAutonomousMoveMerged)
+	{
+		Super::ServerMoveHandleClientError(ClientTimeStamp, DeltaTime, Acceleration, RelativeClientLocation,
+		                                   ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+	}
+}
+
+bool UAlsCharacterMovementComponent::ServerShouldUseAuthoritativePosition(const float ClientTimeStamp, const float DeltaTime,
+                                                                          const FVector& Acceleration, const FVector& ClientLocation,
+                                                                          const FVector& RelativeClientLocation,
+                                                                          UPrimitiveComponent* ClientMovementBase,
+                                                                          const FName ClientBaseBoneName, const uint8 ClientMovementMode)
+{
+	// This is only called when the client's location is within the allowed error. A move simulated along with merged
+	// moves takes one large step instead of the client's small steps, so the server accepts the client's location
+	// to prevent the integration difference from accumulating over consecutive merged moves into a correction.
+
+	return bAutonomousMoveIncludesMergedMoves ||
+	       Super::ServerShouldUseAuthoritativePosition(ClientTimeStamp, DeltaTime, Acceleration, ClientLocation, RelativeClientLocation,
+	                                                   ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+}
+
+bool UAlsCharacterMovementComponent::CanMergeAutonomousMove(const uint8 CompressedFlags, const FVector& NewAcceleration,
+                                                            const FAlsCharacterNetworkMoveData* MoveData) const
+{
+	// Never merge moves that change the character's state, such as jumping or
+	// crouching, or moves driven by root motion, since they can't be recovered.
+
+	if (CompressedFlags != PreviousAutonomousMoveFlags || !HasValidData() ||
+	    CharacterOwner->IsPlayingNetworkedRootMotionMontage() || CurrentRootMotion.HasActiveRootMotionSources())
+	{
+		return false;
+	}
+
+	// Merged moves are simulated with the acceleration of the move they are merged into, so only moves
+	// with the same acceleration are merged, otherwise the server would end up away from the client.
+
+	if (!NewAcceleration.Equals(PreviousAutonomousMoveAcceleration))
+	{
+		return false;
+	}
+
+	return MoveData == nullptr || (MoveData->RotationMode == RotationMode && MoveData->Stance == Stance &&
+	                               MoveData->MaxAllowedGait == MaxAllowedGait);
+}
+
+const FAlsMovementGaitSettings UAlsCharacterMovementComponent::DefaultGaitSettings;
+
 void UAlsCharacterMovementComponent::SetMovementSettings(UAlsMovementSettings* NewMovementSettings)
 {
 	ALS_ENSURE(IsValid(NewMovementSettings));
 
+#if WITH_EDITOR
+	if (IsValid(MovementSettings))
+	{
+		MovementSettings->OnGaitSettingsCompiled.RemoveAll(this);
+	}
+#endif
+
 	MovementSettings = NewMovementSettings;
 
+#if WITH_EDITOR
+	// Gait settings of custom rotation modes and stances point directly into the movement
+	// settings, so they must be looked up again when the movement settings are edited.
+
+	if (IsValid(MovementSettings))
+	{
+		MovementSettings->OnGaitSettingsCompiled.AddUObject(this, &ThisClass::RefreshGaitSettings);
+	}
+#endif
+
 	RefreshGaitSettings();
 }
 
@@ -895,13 +1559,13 @@ void UAlsCharacterMovementComponent::RefreshGaitSettings()
 {
 	if (!ALS_ENSURE(IsValid(MovementSettings)))
 	{
+		GaitSettings = &DefaultGaitSettings;
 		return;
 	}
 
-	const auto* StanceSettings{MovementSettings->RotationModes.Find(RotationMode)};
-	const auto* NewGaitSettings{ALS_ENSURE(StanceSettings != nullptr) ? StanceSettings->Stances.Find(Stance) : nullptr};
+	const auto* NewGaitSettings{MovementSettings->FindGaitSettings(RotationMode, Stance)};
 
-	GaitSettings = ALS_ENSURE(NewGaitSettings != nullptr) ? *NewGaitSettings : FAlsMovementGaitSettings{};
+	GaitSettings = ALS_ENSURE(NewGaitSettings != nullptr) ? NewGaitSettings : &DefaultGaitSettings;
 }
 
 void UAlsCharacterMovementComponent::SetRotationMode(const FGameplayTag& NewRotationMode)
@@ -926,27 +1590,88 @@ void UAlsCharacterMovementComponent::SetStance(const FGameplayTag& NewStance)
 
 void UAlsCharacterMovementComponent::RefreshGroundedMovementSettings()
 {
-	auto WalkSpeed{GaitSettings.WalkForwardSpeed};
-	auto RunSpeed{GaitSettings.RunForwardSpeed};
+	const auto* Controller{GetController()};
 
-	if (GaitSettings.bAllowDirectionDependentMovementSpeed &&
-	    Velocity.SizeSquared() > UE_KINDA_SMALL_NUMBER &&
-	    IsValid(MovementSettings))
+	FAlsGroundedMovementSettingsMemoEntry Entry;
+	Entry.Velocity = Velocity;
+
+	// Ideally we should use actor rotation here instead of view rotation, but we can't do that because ALS has
+	// full control over actor rotation and it is not synchronized over the network, so it would cause jitter.
+
+	Entry.ViewRotation = IsValid(Controller) ? Controller->GetControlRotation() : GetCharacterOwner()->GetViewRotation();
+	Entry.GravityDirection = GetGravityDirection();
+	Entry.GaitSettings = GaitSettings;
+	Entry.MovementSettings = MovementSettings;
+	Entry.MaxAllowedGait = MaxAllowedGait;
+	Entry.bUseBakedCurves = AlsCharacterMovementConsoleVariables::UseBakedCurves.GetValueOnAnyThread();
+
+	const auto bMemoize{AlsCharacterMovementConsoleVariables::MemoizeGroundedMovementSettings.GetValueOnAnyThread()};
+
+	// The memo is keyed on all inputs of the calculation, so reusing it gives exactly the same result as calculating it again.
+
+	const auto* MemoizedEntry{
+		bMemoize && bReplayingGroundedMovementSettings ? GroundedMovementSettingsMemo.Find(Entry) : nullptr
+	};
+
+	auto bCalculated{false};
+
+	if (MemoizedEntry != nullptr)
 	{
-		const auto* Controller{GetController()};
+		GroundedMovementSettingsMemoHitsCount += 1;
 
-		const auto ViewRotation{
-			IsValid(Controller)
-				? GetController()->GetControlRotation()
-				: GetCharacterOwner()->GetViewRotation()
-		};
+		INC_DWORD_STAT(STAT_UAlsCharacterMovementComponent_GroundedMovementSettingsMemoHits);
+
+		if (AlsCharacterMovementConsoleVariables::VerifyGroundedMovementSettingsMemo.GetValueOnAnyThread() &&
+		    CalculateGroundedMovementSettings(Entry) && !Entry.HasSameSettings(*MemoizedEntry))
+		{
+			GroundedMovementSettingsMemoMismatchesCount += 1;
+
+			UE_LOG(LogAls, Error, TEXT("The memoized grounded movement settings of %s differ from the calculated ones!"),
+			       *GetNameSafe(GetOwner()));
+		}
+
+		Entry = *MemoizedEntry;
+	}
+	else
+	{
+		bCalculated = CalculateGroundedMovementSettings(Entry);
+	}
 
-		// Ideally we should use actor rotation here instead of view rotation, but we can't do that because ALS has
-		// full control over actor rotation and it is not synchronized over the network, so it would cause jitter.
+	GaitAmount = Entry.GaitAmount;
 
-		const auto RelativeViewRotation{UAlsRotation::GetTwist(ViewRotation.Quaternion(), -GetGravityDirection())};
+	MaxWalkSpeed = Entry.MaxWalkSpeed;
+	MaxWalkSpeedCrouched = MaxWalkSpeed;
+
+	MaxAccelerationWalking = Entry.MaxAcceleration;
+	BrakingDecelerationWalking = Entry.BrakingDeceleration;
+	GroundFriction = Entry.GroundFriction;
+
+	if (bMemoize && bRecordingGroundedMovementSettings && bCalculated)
+	{
+		GroundedMovementSettingsMemo.Add(Entry);
+	}
+}
+
+bool UAlsCharacterMovementComponent::CalculateGroundedMovementSettings(FAlsGroundedMovementSettingsMemoEntry& Entry)
+{
+	auto WalkSpeed{GaitSettings->WalkForwardSpeed};
+	auto RunSpeed{GaitSettings->RunForwardSpeed};
+
+	if (GaitSettings->bAllowDirectionDependentMovementSpeed &&
+	    Entry.Velocity.SizeSquared() > UE_KINDA_SMALL_NUMBER &&
+	    IsValid(MovementSettings))
+	{
+		// The twist is a pure function of the view rotation and gravity direction, so reusing it
+		// for the same inputs gives exactly the same result, including during move replays.
 
-		const FVector2D RelativeVelocity{RelativeViewRotation.UnrotateVector(Velocity)};
+		if (Entry.ViewRotation != DirectionDependentSpeedViewRotation || Entry.GravityDirection != DirectionDependentSpeedGravityDirection)
+		{
+			DirectionDependentSpeedViewRotation = Entry.ViewRotation;
+			DirectionDependentSpeedGravityDirection = Entry.GravityDirection;
+			DirectionDependentSpeedRelativeViewRotation = UAlsRotation::GetTwist(Entry.ViewRotation.Quaternion(), -Entry.GravityDirection);
+		}
+
+		const FVector2D RelativeVelocity{DirectionDependentSpeedRelativeViewRotation.UnrotateVector(Entry.Velocity)};
 		const auto VelocityAngle{UAlsVector::DirectionToAngle(RelativeVelocity)};
 
 		const auto ForwardSpeedAmount{
@@ -954,60 +1679,74 @@ void UAlsCharacterMovementComponent::RefreshGroundedMovementSettings()
 			                                  {1.0f, 0.0f}, FMath::Abs(VelocityAngle))
 		};
 
-		WalkSpeed = FMath::Lerp(GaitSettings.WalkBackwardSpeed, GaitSettings.WalkForwardSpeed, ForwardSpeedAmount);
-		RunSpeed = FMath::Lerp(GaitSettings.RunBackwardSpeed, GaitSettings.RunForwardSpeed, ForwardSpeedAmount);
+		WalkSpeed = FMath::Lerp(GaitSettings->WalkBackwardSpeed, GaitSettings->WalkForwardSpeed, ForwardSpeedAmount);
+		RunSpeed = FMath::Lerp(GaitSettings->RunBackwardSpeed, GaitSettings->RunForwardSpeed, ForwardSpeedAmount);
 	}
 
 	// Map the character's current speed to the to the speed ranges from the movement settings. This allows
 	// us to vary movement speeds but still use the mapped range in calculations for consistent results.
 
-	const auto Speed{UE_REAL_TO_FLOAT(Velocity.Size2D())};
+	const auto Speed{UE_REAL_TO_FLOAT(Entry.Velocity.Size2D())};
 
 	if (Speed > RunSpeed)
 	{
-		GaitAmount = FMath::GetMappedRangeValueClamped(FVector2f{RunSpeed, GaitSettings.SprintSpeed}, {2.0f, 3.0f}, Speed);
+		Entry.GaitAmount = FMath::GetMappedRangeValueClamped(FVector2f{RunSpeed, GaitSettings->SprintSpeed}, {2.0f, 3.0f}, Speed);
 	}
 	else if (Speed > WalkSpeed)
 	{
-		GaitAmount = FMath::GetMappedRangeValueClamped(FVector2f{WalkSpeed, RunSpeed}, {1.0f, 2.0f}, Speed);
+		Entry.GaitAmount = FMath::GetMappedRangeValueClamped(FVector2f{WalkSpeed, RunSpeed}, {1.0f, 2.0f}, Speed);
 	}
 	else
 	{
-		GaitAmount = FMath::GetMappedRangeValueClamped(FVector2f{0.0f, WalkSpeed}, {0.0f, 1.0f}, Speed);
+		Entry.GaitAmount = FMath::GetMappedRangeValueClamped(FVector2f{0.0f, WalkSpeed}, {0.0f, 1.0f}, Speed);
 	}
 
-	if (MaxAllowedGait == AlsGaitTags::Walking)
+	if (Entry.MaxAllowedGait == AlsGaitTags::Walking)
 	{
-		MaxWalkSpeed = WalkSpeed;
+		Entry.MaxWalkSpeed = WalkSpeed;
 	}
-	else if (MaxAllowedGait == AlsGaitTags::Running)
+	else if (Entry.MaxAllowedGait == AlsGaitTags::Running)
 	{
-		MaxWalkSpeed = RunSpeed;
+		Entry.MaxWalkSpeed = RunSpeed;
 	}
-	else if (MaxAllowedGait == AlsGaitTags::Sprinting)
+	else if (Entry.MaxAllowedGait == AlsGaitTags::Sprinting)
 	{
-		MaxWalkSpeed = GaitSettings.SprintSpeed;
+		Entry.MaxWalkSpeed = GaitSettings->SprintSpeed;
 	}
 	else
 	{
-		MaxWalkSpeed = GaitSettings.RunForwardSpeed;
+		Entry.MaxWalkSpeed = GaitSettings->RunForwardSpeed;
 	}
 
-	MaxWalkSpeedCrouched = MaxWalkSpeed;
-
 	// Get acceleration, deceleration and ground friction using a curve. This
 	// allows us to precisely control the movement behavior at each speed.
 
-	if (ALS_ENSURE(IsValid(GaitSettings.AccelerationAndDecelerationAndGroundFrictionCurve)))
+	const auto& BakedCurves{GaitSettings->AccelerationAndDecelerationAndGroundFrictionBakedCurves};
+
+	if (BakedCurves[0].IsBaked() && Entry.bUseBakedCurves)
+	{
+		Entry.MaxAcceleration = BakedCurves[0].Evaluate(Entry.GaitAmount);
+		Entry.BrakingDeceleration = BakedCurves[1].Evaluate(Entry.GaitAmount);
+		Entry.GroundFriction = BakedCurves[2].Evaluate(Entry.GaitAmount);
+		return true;
+	}
+
+	if (ALS_ENSURE(IsValid(GaitSettings->AccelerationAndDecelerationAndGroundFrictionCurve)))
 	{
 		const auto& AccelerationAndDecelerationAndGroundFrictionCurves{
-			GaitSettings.AccelerationAndDecelerationAndGroundFrictionCurve->FloatCurves
+			GaitSettings->AccelerationAndDecelerationAndGroundFrictionCurve->FloatCurves
 		};
 
-		MaxAccelerationWalking = AccelerationAndDecelerationAndGroundFrictionCurves[0].Eval(GaitAmount);
-		BrakingDecelerationWalking = AccelerationAndDecelerationAndGroundFrictionCurves[1].Eval(GaitAmount);
-		GroundFriction = AccelerationAndDecelerationAndGroundFrictionCurves[2].Eval(GaitAmount);
+		Entry.MaxAcceleration = AccelerationAndDecelerationAndGroundFrictionCurves[0].Eval(Entry.GaitAmount);
+		Entry.BrakingDeceleration = AccelerationAndDecelerationAndGroundFrictionCurves[1].Eval(Entry.GaitAmount);
+		Entry.GroundFriction = AccelerationAndDecelerationAndGroundFrictionCurves[2].Eval(Entry.GaitAmount);
+		return true;
 	}
+
+	Entry.MaxAcceleration = MaxAccelerationWalking;
+	Entry.BrakingDeceleration = BrakingDecelerationWalking;
+	Entry.GroundFriction = GroundFriction;
+	return false;
 }
 
 void UAlsCharacterMovementComponent::SetMovementModeLocked(const bool bNewMovementModeLocked)
@@ -7,6 +7,7 @@
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Engine/NetConnection.h"
+#include "Engine/OverlapResult.h"
 #include "Engine/SkeletalMesh.h"
 #include "Net/Core/PushModel/PushModel.h"
 #include "RootMotionSources/AlsRootMotionSource_Mantling.h"
@@ -17,8 +18,39 @@
 #include "Utility/AlsMacros.h"
 #include "Utility/AlsMontageUtility.h"
 #include "Utility/AlsRotation.h"
+#include "Utility/AlsUtility.h"
 #include "Utility/AlsVector.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mantling Traces"), STAT_AAlsCharacter_MantlingTraces, STATGROUP_Als);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mantling No Ledge Cache Hits"), STAT_AAlsCharacter_MantlingNoLedgeCacheHits, STATGROUP_Als);
+
+namespace AlsMantlingTraceTags
+{
+	static const FName& ForwardTrace()
+	{
+		static const FName Tag{TEXTVIEW("AAlsCharacter::StartMantling (Forward Trace)")};
+		return Tag;
+	}
+
+	static const FName& DownwardTrace()
+	{
+		static const FName Tag{TEXTVIEW("AAlsCharacter::StartMantling (Downward Trace)")};
+		return Tag;
+	}
+
+	static const FName& TargetLocationOverlap()
+	{
+		static const FName Tag{TEXTVIEW("AAlsCharacter::StartMantling (Target Location Overlap)")};
+		return Tag;
+	}
+
+	static const FName& StartLocationOverlap()
+	{
+		static const FName Tag{TEXTVIEW("AAlsCharacter::StartMantling (Start Location Overlap)")};
+		return Tag;
+	}
+}
+
 void AAlsCharacter::StartRolling(const float PlayRate)
 {
 	if (LocomotionMode == AlsLocomotionModeTags::Grounded)
@@ -145,8 +177,161 @@ bool AAlsCharacter::StartMantlingGrounded()
 
 bool AAlsCharacter::StartMantlingInAir()
 {
-	return LocomotionMode == AlsLocomotionModeTags::InAir && IsLocallyControlled() &&
-	       StartMantling(Settings->Mantling.InAirTrace);
+	// In-air mantling is checked every frame, so instead of performing all traces synchronously, they are issued as
+	// asynchronous traces one step at a time, and the result of each step is evaluated in the next frame.
+
+	auto& TraceState{InAirMantlingTraceState};
+
+	if (LocomotionMode != AlsLocomotionModeTags::InAir || !IsLocallyControlled() || !CanStartMantling())
+	{
+		TraceState.Stage = EAlsMantlingTraceStage::None;
+		return false;
+	}
+
+	auto* World{GetWorld()};
+	auto& Context{TraceState.Context};
+
+	switch (TraceState.Stage)
+	{
+		case EAlsMantlingTraceStage::ForwardTrace:
+		{
+			FTraceDatum TraceData;
+			if (!World->QueryTraceData(TraceState.SweepHandle, TraceData))
+			{
+				break;
+			}
+
+			Context.ForwardTraceHit = TraceData.OutHits.Num() > 0 ? TraceData.OutHits[0] : FHitResult{TraceData.Start, TraceData.End};
+
+			if (!ProcessMantlingForwardTrace(Context))
+			{
+				CacheMantlingNoLedge();
+				return false;
+			}
+
+			INC_DWORD_STAT(STAT_AAlsCharacter_MantlingTraces);
+
+			TraceState.SweepHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, Context.DownwardTraceStart,
+			                                                    Context.DownwardTraceEnd, FQuat::Identity,
+			                                                    Settings->Mantling.MantlingTraceChannel,
+			                                                    FCollisionShape::MakeSphere(Context.TraceCapsuleRadius),
+			                                                    {AlsMantlingTraceTags::DownwardTrace(), false, this},
+			                                                    Settings->Mantling.MantlingTraceResponses);
+
+			TraceState.Stage = EAlsMantlingTraceStage::DownwardTrace;
+			return false;
+		}
+
+		case EAlsMantlingTraceStage::DownwardTrace:
+		{
+			FTraceDatum TraceData;
+			if (!World->QueryTraceData(TraceState.SweepHandle, TraceData))
+			{
+				break;
+			}
+
+			Context.DownwardTraceHit = TraceData.OutHits.Num() > 0 ? TraceData.OutHits[0] : FHitResult{TraceData.Start, TraceData.End};
+
+			if (!ProcessMantlingDownwardTrace(Context))
+			{
+				CacheMantlingNoLedge();
+				return false;
+			}
+
+			INC_DWORD_STAT_BY(STAT_AAlsCharacter_MantlingTraces, 2);
+
+			TraceState.TargetLocationOverlapHandle =
+				World->AsyncOverlapByChannel(Context.TargetCapsuleLocation, FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
+				                             FCollisionShape::MakeCapsule(Context.CapsuleRadius, Context.CapsuleHalfHeight),
+				                             {AlsMantlingTraceTags::TargetLocationOverlap(), false, this},
+				                             Settings->Mantling.MantlingTraceResponses);
+
+			TraceState.StartLocationOverlapHandle =
+				World->AsyncOverlapByChannel(Context.StartLocation, FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
+				                             FCollisionShape::MakeCapsule(Context.TraceCapsuleRadius,
+				                                                          Context.StartLocationTraceCapsuleHalfHeight),
+				                             {AlsMantlingTraceTags::StartLocationOverlap(), false, this},
+				                             Settings->Mantling.MantlingTraceResponses);
+
+			TraceState.Stage = EAlsMantlingTraceStage::Overlaps;
+			return false;
+		}
+
+		case EAlsMantlingTraceStage::Overlaps:
+		{
+			FOverlapDatum TargetLocationOverlapData;
+			FOverlapDatum StartLocationOverlapData;
+
+			if (!World->QueryOverlapData(TraceState.TargetLocationOverlapHandle, TargetLocationOverlapData) ||
+			    !World->QueryOverlapData(TraceState.StartLocationOverlapHandle, StartLocationOverlapData))
+			{
+				break;
+			}
+
+			TraceState.Stage = EAlsMantlingTraceStage::None;
+
+			static const auto IsBlockingOverlap{[](const FOverlapResult& Overlap) { return Overlap.bBlockingHit; }};
+
+			if (!ProcessMantlingOverlaps(Context, TargetLocationOverlapData.OutOverlaps.ContainsByPredicate(IsBlockingOverlap),
+			                             StartLocationOverlapData.OutOverlaps.ContainsByPredicate(IsBlockingOverlap)))
+			{
+				CacheMantlingNoLedge();
+				return false;
+			}
+
+			// The character has kept moving while the traces were in flight, so make sure
+			// that the ledge is still within reach from the current character location.
+
+			Context.CapsuleBottomLocation = GetActorLocation();
+			Context.CapsuleBottomLocation.Z -= Context.CapsuleHalfHeight;
+
+			const auto LedgeHeight{Context.TargetLocation.Z - Context.CapsuleBottomLocation.Z};
+
+			if (!IsValid(Context.ForwardTraceHit.GetComponent()) ||
+			    LedgeHeight < Context.TraceSettings.LedgeHeight.GetMin() * Context.CapsuleScale -
+			    UCharacterMovementComponent::MAX_FLOOR_DIST ||
+			    LedgeHeight > Context.TraceSettings.LedgeHeight.GetMax() * Context.CapsuleScale +
+			    UCharacterMovementComponent::MAX_FLOOR_DIST)
+			{
+				return false;
+			}
+
+			StartMantlingFromTraces(Context);
+			return true;
+		}
+
+		default:
+			break;
+	}
+
+	// Start a new set of traces, unless the previous traces from this location didn't find anything.
+
+	TraceState.Stage = EAlsMantlingTraceStage::None;
+
+	if (!PrepareMantlingTraces(Settings->Mantling.InAirTrace, Context))
+	{
+		return false;
+	}
+
+	TraceState.PendingNoLedgeEntry = MakeMantlingNoLedgeCacheEntry(Context);
+
+	if (IsMantlingNoLedgeCached(TraceState.PendingNoLedgeEntry))
+	{
+		INC_DWORD_STAT(STAT_AAlsCharacter_MantlingNoLedgeCacheHits);
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_AAlsCharacter_MantlingTraces);
+
+	TraceState.SweepHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, Context.ForwardTraceStart, Context.ForwardTraceEnd,
+	                                                    FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
+	                                                    FCollisionShape::MakeCapsule(Context.TraceCapsuleRadius,
+	                                                                                 Context.ForwardTraceCapsuleHalfHeight),
+	                                                    {AlsMantlingTraceTags::ForwardTrace(), false, this},
+	                                                    Settings->Mantling.MantlingTraceResponses);
+
+	TraceState.Stage = EAlsMantlingTraceStage::ForwardTrace;
+	return false;
 }
 
 bool AAlsCharacter::IsMantlingAllowedToStart_Implementation() const
@@ -156,11 +341,89 @@ bool AAlsCharacter::IsMantlingAllowedToStart_Implementation() const
 
 bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings)
 {
-	if (!Settings->Mantling.bAllowMantling || GetLocalRole() <= ROLE_SimulatedProxy || !IsMantlingAllowedToStart())
+	if (!CanStartMantling())
+	{
+		return false;
+	}
+
+	FAlsMantlingTraceContext Context;
+
+	if (!PrepareMantlingTraces(TraceSettings, Context))
+	{
+		return false;
+	}
+
+	const auto* World{GetWorld()};
+
+	// Trace forward to find an object the character cannot walk on.
+
+	INC_DWORD_STAT(STAT_AAlsCharacter_MantlingTraces);
+
+	World->SweepSingleByChannel(Context.ForwardTraceHit, Context.ForwardTraceStart, Context.ForwardTraceEnd,
+	                            FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
+	                            FCollisionShape::MakeCapsule(Context.TraceCapsuleRadius, Context.ForwardTraceCapsuleHalfHeight),
+	                            {AlsMantlingTraceTags::ForwardTrace(), false, this}, Settings->Mantling.MantlingTraceResponses);
+
+	if (!ProcessMantlingForwardTrace(Context))
+	{
+		return false;
+	}
+
+	// Trace downward from the first trace's impact point and determine if the hit location is walkable.
+
+	INC_DWORD_STAT(STAT_AAlsCharacter_MantlingTraces);
+
+	World->SweepSingleByChannel(Context.DownwardTraceHit, Context.DownwardTraceStart, Context.DownwardTraceEnd, FQuat::Identity,
+	                            Settings->Mantling.MantlingTraceChannel, FCollisionShape::MakeSphere(Context.TraceCapsuleRadius),
+	                            {AlsMantlingTraceTags::DownwardTrace(), false, this}, Settings->Mantling.MantlingTraceResponses);
+
+	if (!ProcessMantlingDownwardTrace(Context))
 	{
 		return false;
 	}
 
+	// Check that there is enough free space for the capsule at the target location.
+
+	INC_DWORD_STAT(STAT_AAlsCharacter_MantlingTraces);
+
+	if (World->OverlapBlockingTestByChannel(Context.TargetCapsuleLocation, FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
+	                                        FCollisionShape::MakeCapsule(Context.CapsuleRadius, Context.CapsuleHalfHeight),
+	                                        {AlsMantlingTraceTags::TargetLocationOverlap(), false, this},
+	                                        Settings->Mantling.MantlingTraceResponses))
+	{
+		ProcessMantlingOverlaps(Context, true, false);
+		return false;
+	}
+
+	// Perform additional overlap at the approximate start location to
+	// ensure there are no vertical obstacles on the path, such as a ceiling.
+
+	INC_DWORD_STAT(STAT_AAlsCharacter_MantlingTraces);
+
+	const auto bStartLocationBlocked{
+		World->OverlapBlockingTestByChannel(Context.StartLocation, FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
+		                                    FCollisionShape::MakeCapsule(Context.TraceCapsuleRadius,
+		                                                                 Context.StartLocationTraceCapsuleHalfHeight),
+		                                    {AlsMantlingTraceTags::StartLocationOverlap(), false, this},
+		                                    Settings->Mantling.MantlingTraceResponses)
+	};
+
+	if (!ProcessMantlingOverlaps(Context, false, bStartLocationBlocked))
+	{
+		return false;
+	}
+
+	StartMantlingFromTraces(Context);
+	return true;
+}
+
+bool AAlsCharacter::CanStartMantling() const
+{
+	return Settings->Mantling.bAllowMantling && GetLocalRole() > ROLE_SimulatedProxy && IsMantlingAllowedToStart();
+}
+
+bool AAlsCharacter::PrepareMantlingTraces(const FAlsMantlingTraceSettings& TraceSettings, FAlsMantlingTraceContext& Context) const
+{
 	const auto ActorLocation{GetActorLocation()};
 	const auto ActorYawAngle{UE_REAL_TO_FLOAT(FMath::UnwindDegrees(GetActorRotation().Yaw))};
 
@@ -184,46 +447,44 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 		return false;
 	}
 
-	const auto ForwardTraceDirection{
-		UAlsVector::AngleToDirectionXY(
-			ActorYawAngle + FMath::ClampAngle(ForwardTraceDeltaAngle, -Settings->Mantling.MaxReachAngle, Settings->Mantling.MaxReachAngle))
-	};
+	Context.TraceSettings = TraceSettings;
+
+	Context.ForwardTraceDirection = UAlsVector::AngleToDirectionXY(
+		ActorYawAngle + FMath::ClampAngle(ForwardTraceDeltaAngle, -Settings->Mantling.MaxReachAngle, Settings->Mantling.MaxReachAngle));
 
 #if ENABLE_DRAW_DEBUG
-	const auto bDisplayDebug{UAlsDebugUtility::ShouldDisplayDebugForActor(this, UAlsConstants::MantlingDebugDisplayName())};
+	Context.bDisplayDebug = UAlsDebugUtility::ShouldDisplayDebugForActor(this, UAlsConstants::MantlingDebugDisplayName());
 #endif
 
 	const auto* Capsule{GetCapsuleComponent()};
 
-	const auto CapsuleScale{Capsule->GetComponentScale().Z};
-	const auto CapsuleRadius{Capsule->GetScaledCapsuleRadius()};
-	const auto CapsuleHalfHeight{Capsule->GetScaledCapsuleHalfHeight()};
+	Context.CapsuleScale = Capsule->GetComponentScale().Z;
+	Context.CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+	Context.CapsuleHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
 
-	const FVector CapsuleBottomLocation{ActorLocation.X, ActorLocation.Y, ActorLocation.Z - CapsuleHalfHeight};
+	Context.CapsuleBottomLocation = {ActorLocation.X, ActorLocation.Y, ActorLocation.Z - Context.CapsuleHalfHeight};
 
-	const auto TraceCapsuleRadius{CapsuleRadius - 1.0f};
+	Context.TraceCapsuleRadius = Context.CapsuleRadius - 1.0f;
 
-	const auto LedgeHeightDelta{UE_REAL_TO_FLOAT((TraceSettings.LedgeHeight.GetMax() - TraceSettings.LedgeHeight.GetMin()) * CapsuleScale)};
+	Context.LedgeHeightDelta = UE_REAL_TO_FLOAT((TraceSettings.LedgeHeight.GetMax() - TraceSettings.LedgeHeight.GetMin()) *
+	                                            Context.CapsuleScale);
 
-	// Trace forward to find an object the character cannot walk on.
-
-	static const FName ForwardTraceTag{FString::Printf(TEXT("%hs (Forward Trace)"), __FUNCTION__)};
+	Context.ForwardTraceStart = Context.CapsuleBottomLocation - Context.ForwardTraceDirection * Context.CapsuleRadius;
+	Context.ForwardTraceStart.Z += (TraceSettings.LedgeHeight.X + TraceSettings.LedgeHeight.Y) *
+		0.5f * Context.CapsuleScale - UCharacterMovementComponent::MAX_FLOOR_DIST;
 
-	auto ForwardTraceStart{CapsuleBottomLocation - ForwardTraceDirection * CapsuleRadius};
-	ForwardTraceStart.Z += (TraceSettings.LedgeHeight.X + TraceSettings.LedgeHeight.Y) *
-		0.5f * CapsuleScale - UCharacterMovementComponent::MAX_FLOOR_DIST;
+	Context.ForwardTraceEnd = Context.ForwardTraceStart + Context.ForwardTraceDirection *
+	                          (Context.CapsuleRadius + (TraceSettings.ReachDistance + 1.0f) * Context.CapsuleScale);
 
-	auto ForwardTraceEnd{ForwardTraceStart + ForwardTraceDirection * (CapsuleRadius + (TraceSettings.ReachDistance + 1.0f) * CapsuleScale)};
+	Context.ForwardTraceCapsuleHalfHeight = Context.LedgeHeightDelta * 0.5f;
 
-	const auto ForwardTraceCapsuleHalfHeight{LedgeHeightDelta * 0.5f};
-
-	FHitResult ForwardTraceHit;
-	GetWorld()->SweepSingleByChannel(ForwardTraceHit, ForwardTraceStart, ForwardTraceEnd,
-	                                 FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
-	                                 FCollisionShape::MakeCapsule(TraceCapsuleRadius, ForwardTraceCapsuleHalfHeight),
-	                                 {ForwardTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses);
+	return true;
+}
 
-	auto* TargetPrimitive{ForwardTraceHit.GetComponent()};
+bool AAlsCharacter::ProcessMantlingForwardTrace(FAlsMantlingTraceContext& Context)
+{
+	const auto& ForwardTraceHit{Context.ForwardTraceHit};
+	const auto* TargetPrimitive{ForwardTraceHit.GetComponent()};
 
 	if (!ForwardTraceHit.IsValidBlockingHit() ||
 	    !IsValid(TargetPrimitive) ||
@@ -232,42 +493,42 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 	    GetCharacterMovement()->IsWalkable(ForwardTraceHit))
 	{
 #if ENABLE_DRAW_DEBUG
-		if (bDisplayDebug)
+		if (Context.bDisplayDebug)
 		{
-			UAlsDebugUtility::DrawSweepSingleCapsuleAlternative(GetWorld(), ForwardTraceStart, ForwardTraceEnd, TraceCapsuleRadius,
-			                                                    ForwardTraceCapsuleHalfHeight, false, ForwardTraceHit, {0.0f, 0.25f, 1.0f},
-			                                                    {0.0f, 0.75f, 1.0f}, TraceSettings.bDrawFailedTraces ? 5.0f : 0.0f);
+			UAlsDebugUtility::DrawSweepSingleCapsuleAlternative(GetWorld(), Context.ForwardTraceStart, Context.ForwardTraceEnd,
+			                                                    Context.TraceCapsuleRadius, Context.ForwardTraceCapsuleHalfHeight,
+			                                                    false, ForwardTraceHit, {0.0f, 0.25f, 1.0f}, {0.0f, 0.75f, 1.0f},
+			                                                    Context.TraceSettings.bDrawFailedTraces ? 5.0f : 0.0f);
 		}
 #endif
 
 		return false;
 	}
 
-	const auto TargetDirection{-ForwardTraceHit.ImpactNormal.GetSafeNormal2D()};
+	Context.TargetDirection = -ForwardTraceHit.ImpactNormal.GetSafeNormal2D();
 
-	// Trace downward from the first trace's impact point and determine if the hit location is walkable.
+	const FVector2D TargetLocationOffset{Context.TargetDirection * (Context.TraceSettings.TargetLocationOffset * Context.CapsuleScale)};
 
-	static const FName DownwardTraceTag{FString::Printf(TEXT("%hs (Downward Trace)"), __FUNCTION__)};
-
-	const FVector2D TargetLocationOffset{TargetDirection * (TraceSettings.TargetLocationOffset * CapsuleScale)};
-
-	const FVector DownwardTraceStart{
+	Context.DownwardTraceStart = {
 		ForwardTraceHit.ImpactPoint.X + TargetLocationOffset.X,
 		ForwardTraceHit.ImpactPoint.Y + TargetLocationOffset.Y,
-		CapsuleBottomLocation.Z + LedgeHeightDelta + 2.5f * TraceCapsuleRadius + UCharacterMovementComponent::MIN_FLOOR_DIST
+		Context.CapsuleBottomLocation.Z + Context.LedgeHeightDelta + 2.5f * Context.TraceCapsuleRadius +
+		UCharacterMovementComponent::MIN_FLOOR_DIST
 	};
 
-	const FVector DownwardTraceEnd{
-		DownwardTraceStart.X,
-		DownwardTraceStart.Y,
-		CapsuleBottomLocation.Z +
-		TraceSettings.LedgeHeight.GetMin() * CapsuleScale + TraceCapsuleRadius - UCharacterMovementComponent::MAX_FLOOR_DIST
+	Context.DownwardTraceEnd = {
+		Context.DownwardTraceStart.X,
+		Context.DownwardTraceStart.Y,
+		Context.CapsuleBottomLocation.Z + Context.TraceSettings.LedgeHeight.GetMin() * Context.CapsuleScale +
+		Context.TraceCapsuleRadius - UCharacterMovementComponent::MAX_FLOOR_DIST
 	};
 
-	FHitResult DownwardTraceHit;
-	GetWorld()->SweepSingleByChannel(DownwardTraceHit, DownwardTraceStart, DownwardTraceEnd, FQuat::Identity,
-	                                 Settings->Mantling.MantlingTraceChannel, FCollisionShape::MakeSphere(TraceCapsuleRadius),
-	                                 {DownwardTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses);
+	return true;
+}
+
+bool AAlsCharacter::ProcessMantlingDownwardTrace(FAlsMantlingTraceContext& Context) const
+{
+	const auto& DownwardTraceHit{Context.DownwardTraceHit};
 
 	const auto SlopeAngleCos{UE_REAL_TO_FLOAT(DownwardTraceHit.ImpactNormal.Z)};
 
@@ -285,116 +546,125 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 	    !GetCharacterMovement()->IsWalkable(DownwardTraceHit))
 	{
 #if ENABLE_DRAW_DEBUG
-		if (bDisplayDebug)
+		if (Context.bDisplayDebug)
 		{
-			UAlsDebugUtility::DrawSweepSingleCapsuleAlternative(GetWorld(), ForwardTraceStart, ForwardTraceEnd, TraceCapsuleRadius,
-			                                                    ForwardTraceCapsuleHalfHeight, true, ForwardTraceHit, {0.0f, 0.25f, 1.0f},
-			                                                    {0.0f, 0.75f, 1.0f}, TraceSettings.bDrawFailedTraces ? 5.0f : 0.0f);
-
-			UAlsDebugUtility::DrawSweepSingleSphere(GetWorld(), DownwardTraceStart, DownwardTraceEnd, TraceCapsuleRadius,
-			                                        false, DownwardTraceHit, {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f},
-			                                        TraceSettings.bDrawFailedTraces ? 7.5f : 0.0f);
+			UAlsDebugUtility::DrawSweepSingleCapsuleAlternative(GetWorld(), Context.ForwardTraceStart, Context.ForwardTraceEnd,
+			                                                    Context.TraceCapsuleRadius, Context.ForwardTraceCapsuleHalfHeight,
+			                                                    true, Context.ForwardTraceHit, {0.0f, 0.25f, 1.0f},
+			                                                    {0.0f, 0.75f, 1.0f}, Context.TraceSettings.bDrawFailedTraces ? 5.0f : 0.0f);
+
+			UAlsDebugUtility::DrawSweepSingleSphere(GetWorld(), Context.DownwardTraceStart, Context.DownwardTraceEnd,
+			                                        Context.TraceCapsuleRadius, false, DownwardTraceHit,
+			                                        {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f},
+			                                        Context.TraceSettings.bDrawFailedTraces ? 7.5f : 0.0f);
 		}
 #endif
 
 		return false;
 	}
 
-	// Check that there is enough free space for the capsule at the target location.
-
-	static const FName TargetLocationTraceTag{FString::Printf(TEXT("%hs (Target Location Overlap)"), __FUNCTION__)};
-
-	const FVector TargetLocation{
+	Context.TargetLocation = {
 		DownwardTraceHit.Location.X,
 		DownwardTraceHit.Location.Y,
 		DownwardTraceHit.ImpactPoint.Z + UCharacterMovementComponent::MIN_FLOOR_DIST
 	};
 
-	const FVector TargetCapsuleLocation{TargetLocation.X, TargetLocation.Y, TargetLocation.Z + CapsuleHalfHeight};
+	Context.TargetCapsuleLocation = {
+		Context.TargetLocation.X,
+		Context.TargetLocation.Y,
+		Context.TargetLocation.Z + Context.CapsuleHalfHeight
+	};
+
+	const FVector2D StartLocationOffset{Context.TargetDirection * (Context.TraceSettings.StartLocationOffset * Context.CapsuleScale)};
 
-	if (GetWorld()->OverlapBlockingTestByChannel(TargetCapsuleLocation, FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
-	                                             FCollisionShape::MakeCapsule(CapsuleRadius, CapsuleHalfHeight),
-	                                             {TargetLocationTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses))
+	Context.StartLocation = {
+		Context.ForwardTraceHit.ImpactPoint.X - StartLocationOffset.X,
+		Context.ForwardTraceHit.ImpactPoint.Y - StartLocationOffset.Y,
+		(DownwardTraceHit.Location.Z + Context.DownwardTraceEnd.Z) * 0.5f
+	};
+
+	Context.StartLocationTraceCapsuleHalfHeight =
+		UE_REAL_TO_FLOAT(DownwardTraceHit.Location.Z - Context.DownwardTraceEnd.Z) * 0.5f + Context.TraceCapsuleRadius;
+
+	return true;
+}
+
+bool AAlsCharacter::ProcessMantlingOverlaps(const FAlsMantlingTraceContext& Context, const bool bTargetLocationBlocked,
+                                            const bool bStartLocationBlocked) const
+{
+	if (bTargetLocationBlocked)
 	{
 #if ENABLE_DRAW_DEBUG
-		if (bDisplayDebug)
+		if (Context.bDisplayDebug)
 		{
-			UAlsDebugUtility::DrawSweepSingleCapsuleAlternative(GetWorld(), ForwardTraceStart, ForwardTraceEnd, TraceCapsuleRadius,
-			                                                    ForwardTraceCapsuleHalfHeight, true, ForwardTraceHit, {0.0f, 0.25f, 1.0f},
-			                                                    {0.0f, 0.75f, 1.0f}, TraceSettings.bDrawFailedTraces ? 5.0f : 0.0f);
-
-			UAlsDebugUtility::DrawSweepSingleSphere(GetWorld(), DownwardTraceStart, DownwardTraceEnd, TraceCapsuleRadius,
-			                                        false, DownwardTraceHit, {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f},
-			                                        TraceSettings.bDrawFailedTraces ? 7.5f : 0.0f);
-
-			DrawDebugCapsule(GetWorld(), TargetCapsuleLocation, CapsuleHalfHeight, CapsuleRadius, FQuat::Identity,
-			                 FColor::Red, false, TraceSettings.bDrawFailedTraces ? 10.0f : 0.0f);
+			UAlsDebugUtility::DrawSweepSingleCapsuleAlternative(GetWorld(), Context.ForwardTraceStart, Context.ForwardTraceEnd,
+			                                                    Context.TraceCapsuleRadius, Context.ForwardTraceCapsuleHalfHeight,
+			                                                    true, Context.ForwardTraceHit, {0.0f, 0.25f, 1.0f},
+			                                                    {0.0f, 0.75f, 1.0f}, Context.TraceSettings.bDrawFailedTraces ? 5.0f : 0.0f);
+
+			UAlsDebugUtility::DrawSweepSingleSphere(GetWorld(), Context.DownwardTraceStart, Context.DownwardTraceEnd,
+			                                        Context.TraceCapsuleRadius, false, Context.DownwardTraceHit,
+			                                        {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f},
+			                                        Context.TraceSettings.bDrawFailedTraces ? 7.5f : 0.0f);
+
+			DrawDebugCapsule(GetWorld(), Context.TargetCapsuleLocation, Context.CapsuleHalfHeight, Context.CapsuleRadius,
+			                 FQuat::Identity, FColor::Red, false, Context.TraceSettings.bDrawFailedTraces ? 10.0f : 0.0f);
 		}
 #endif
 
 		return false;
 	}
 
-	// Perform additional overlap at the approximate start location to
-	// ensure there are no vertical obstacles on the path, such as a ceiling.
-
-	static const FName StartLocationTraceTag{FString::Printf(TEXT("%hs (Start Location Overlap)"), __FUNCTION__)};
-
-	const FVector2D StartLocationOffset{TargetDirection * (TraceSettings.StartLocationOffset * CapsuleScale)};
-
-	const FVector StartLocation{
-		ForwardTraceHit.ImpactPoint.X - StartLocationOffset.X,
-		ForwardTraceHit.ImpactPoint.Y - StartLocationOffset.Y,
-		(DownwardTraceHit.Location.Z + DownwardTraceEnd.Z) * 0.5f
-	};
-
-	const auto StartLocationTraceCapsuleHalfHeight{
-		UE_REAL_TO_FLOAT(DownwardTraceHit.Location.Z - DownwardTraceEnd.Z) * 0.5f + TraceCapsuleRadius
-	};
-
-	if (GetWorld()->OverlapBlockingTestByChannel(StartLocation, FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
-	                                             FCollisionShape::MakeCapsule(TraceCapsuleRadius, StartLocationTraceCapsuleHalfHeight),
-	                                             {StartLocationTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses))
+	if (bStartLocationBlocked)
 	{
 #if ENABLE_DRAW_DEBUG
-		if (bDisplayDebug)
+		if (Context.bDisplayDebug)
 		{
-			UAlsDebugUtility::DrawSweepSingleCapsuleAlternative(GetWorld(), ForwardTraceStart, ForwardTraceEnd, TraceCapsuleRadius,
-			                                                    ForwardTraceCapsuleHalfHeight, true, ForwardTraceHit,
-			                                                    {0.0f, 0.25f, 1.0f},
-			                                                    {0.0f, 0.75f, 1.0f}, TraceSettings.bDrawFailedTraces ? 5.0f : 0.0f);
-
-			UAlsDebugUtility::DrawSweepSingleSphere(GetWorld(), DownwardTraceStart, DownwardTraceEnd, TraceCapsuleRadius,
-			                                        false, DownwardTraceHit, {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f},
-			                                        TraceSettings.bDrawFailedTraces ? 7.5f : 0.0f);
-
-			DrawDebugCapsule(GetWorld(), StartLocation, StartLocationTraceCapsuleHalfHeight, TraceCapsuleRadius, FQuat::Identity,
-			                 FLinearColor{1.0f, 0.5f, 0.0f}.ToFColor(true), false, TraceSettings.bDrawFailedTraces ? 10.0f : 0.0f);
+			UAlsDebugUtility::DrawSweepSingleCapsuleAlternative(GetWorld(), Context.ForwardTraceStart, Context.ForwardTraceEnd,
+			                                                    Context.TraceCapsuleRadius, Context.ForwardTraceCapsuleHalfHeight,
+			                                                    true, Context.ForwardTraceHit, {0.0f, 0.25f, 1.0f},
+			                                                    {0.0f, 0.75f, 1.0f}, Context.TraceSettings.bDrawFailedTraces ? 5.0f : 0.0f);
+
+			UAlsDebugUtility::DrawSweepSingleSphere(GetWorld(), Context.DownwardTraceStart, Context.DownwardTraceEnd,
+			                                        Context.TraceCapsuleRadius, false, Context.DownwardTraceHit,
+			                                        {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f},
+			                                        Context.TraceSettings.bDrawFailedTraces ? 7.5f : 0.0f);
+
+			DrawDebugCapsule(GetWorld(), Context.StartLocation, Context.StartLocationTraceCapsuleHalfHeight, Context.TraceCapsuleRadius,
+			                 FQuat::Identity, FLinearColor{1.0f, 0.5f, 0.0f}.ToFColor(true), false,
+			                 Context.TraceSettings.bDrawFailedTraces ? 10.0f : 0.0f);
 		}
 #endif
 
 		return false;
 	}
 
+	return true;
+}
+
+void AAlsCharacter::StartMantlingFromTraces(const FAlsMantlingTraceContext& Context)
+{
 #if ENABLE_DRAW_DEBUG
-	if (bDisplayDebug)
+	if (Context.bDisplayDebug)
 	{
-		UAlsDebugUtility::DrawSweepSingleCapsuleAlternative(GetWorld(), ForwardTraceStart, ForwardTraceEnd, TraceCapsuleRadius,
-		                                                    ForwardTraceCapsuleHalfHeight, true, ForwardTraceHit,
-		                                                    {0.0f, 0.25f, 1.0f}, {0.0f, 0.75f, 1.0f}, 5.0f);
+		UAlsDebugUtility::DrawSweepSingleCapsuleAlternative(GetWorld(), Context.ForwardTraceStart, Context.ForwardTraceEnd,
+		                                                    Context.TraceCapsuleRadius, Context.ForwardTraceCapsuleHalfHeight,
+		                                                    true, Context.ForwardTraceHit, {0.0f, 0.25f, 1.0f}, {0.0f, 0.75f, 1.0f}, 5.0f);
 
-		UAlsDebugUtility::DrawSweepSingleSphere(GetWorld(), DownwardTraceStart, DownwardTraceEnd,
-		                                        TraceCapsuleRadius, true, DownwardTraceHit,
+		UAlsDebugUtility::DrawSweepSingleSphere(GetWorld(), Context.DownwardTraceStart, Context.DownwardTraceEnd,
+		                                        Context.TraceCapsuleRadius, true, Context.DownwardTraceHit,
 		                                        {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f}, 7.5f);
 	}
 #endif
 
-	const auto TargetRotation{TargetDirection.ToOrientationQuat()};
+	auto* TargetPrimitive{Context.ForwardTraceHit.GetComponent()};
+	const auto& TargetLocation{Context.TargetLocation};
+	const auto TargetRotation{Context.TargetDirection.ToOrientationQuat()};
 
 	FAlsMantlingParameters Parameters;
 
 	Parameters.TargetPrimitive = TargetPrimitive;
-	Parameters.MantlingHeight = UE_REAL_TO_FLOAT((TargetLocation.Z - CapsuleBottomLocation.Z) / CapsuleScale);
+	Parameters.MantlingHeight = UE_REAL_TO_FLOAT((TargetLocation.Z - Context.CapsuleBottomLocation.Z) / Context.CapsuleScale);
 
 	// Determine the mantling type by checking the movement mode and mantling height.
 
@@ -433,8 +703,75 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 		StartMantlingImplementation(Parameters);
 		ServerStartMantling(Parameters);
 	}
+}
 
-	return true;
+FAlsMantlingNoLedgeCacheEntry AAlsCharacter::MakeMantlingNoLedgeCacheEntry(const FAlsMantlingTraceContext& Context) const
+{
+	static constexpr auto DirectionSectorsCount{16};
+
+	FAlsMantlingNoLedgeCacheEntry Entry;
+
+	auto Location{GetActorLocation()};
+	const auto* Base{GetMovementBase()};
+
+	// Use the movement base space, so that the entry remains valid while the movement base is moving.
+
+	if (IsValid(Base))
+	{
+		Entry.MovementBase = Base;
+		Location = Base->GetComponentTransform().InverseTransformPositionNoScale(Location);
+	}
+
+	const auto BucketSize{FMath::Max(1.0f, Settings->Mantling.InAirNoLedgeCacheBucketSize)};
+
+	Entry.LocationBucket = {
+		FMath::FloorToInt32(Location.X / BucketSize),
+		FMath::FloorToInt32(Location.Y / BucketSize),
+		FMath::FloorToInt32(Location.Z / BucketSize)
+	};
+
+	const auto DirectionAngle{FMath::RadiansToDegrees(FMath::Atan2(Context.ForwardTraceDirection.Y, Context.ForwardTraceDirection.X))};
+
+	Entry.DirectionSector = static_cast<uint8>(
+		(FMath::RoundToInt32(DirectionAngle / (360.0f / DirectionSectorsCount)) % DirectionSectorsCount + DirectionSectorsCount) %
+		DirectionSectorsCount);
+
+	Entry.ExpirationTime = GetWorld()->GetTimeSeconds() + Settings->Mantling.InAirNoLedgeCacheDuration;
+
+	return Entry;
+}
+
+bool AAlsCharacter::IsMantlingNoLedgeCached(const FAlsMantlingNoLedgeCacheEntry& Entry) const
+{
+	const auto WorldTime{GetWorld()->GetTimeSeconds()};
+
+	for (const auto& CachedEntry : InAirMantlingTraceState.NoLedgeCache)
+	{
+		if (CachedEntry.ExpirationTime > WorldTime &&
+		    CachedEntry.LocationBucket == Entry.LocationBucket &&
+		    CachedEntry.DirectionSector == Entry.DirectionSector &&
+		    CachedEntry.MovementBase == Entry.MovementBase)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void AAlsCharacter::CacheMantlingNoLedge()
+{
+	auto& TraceState{InAirMantlingTraceState};
+
+	TraceState.Stage = EAlsMantlingTraceStage::None;
+
+	if (Settings->Mantling.InAirNoLedgeCacheDuration <= 0.0f)
+	{
+		return;
+	}
+
+	TraceState.NoLedgeCache[TraceState.NextNoLedgeCacheIndex] = TraceState.PendingNoLedgeEntry;
+	TraceState.NextNoLedgeCacheIndex = (TraceState.NextNoLedgeCacheIndex + 1) % FAlsInAirMantlingTraceState::NoLedgeCacheSize;
 }
 
 void AAlsCharacter::ServerStartMantling_Implementation(const FAlsMantlingParameters& Parameters)
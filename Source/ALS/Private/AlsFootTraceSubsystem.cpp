@@ -0,0 +1,208 @@
+#include "AlsFootTraceSubsystem.h"
+
+#include "AlsCharacter.h"
+#include "Engine/World.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsFootTraceSubsystem)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Foot Traces Issued"), STAT_UAlsFootTraceSubsystem_TracesIssued, STATGROUP_Als);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Foot Traces Reused"), STAT_UAlsFootTraceSubsystem_TracesReused, STATGROUP_Als);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Foot Traces Completed Synchronously"), STAT_UAlsFootTraceSubsystem_TracesCompletedSynchronously, STATGROUP_Als);
+
+namespace AlsFootTraceConstants
+{
+	// Maximum distance between the start locations of the requested trace and the completed trace whose hit can be
+	// projected onto the requested one. Large enough to cover a sprinting character between the lowest tier traces,
+	// so that only teleports and the like fall back to synchronous traces.
+	constexpr auto MaxHitProjectionDistance{150.0f};
+
+	// Number of frames after which a trace result is considered lost if it can't be queried.
+	constexpr uint64 MaxTraceFrames{2};
+
+	// Number of frames after which a trace that is no longer requested is removed.
+	constexpr uint64 MaxIdleFrames{60};
+
+	// Minimum number of frames between traces of a single rig, per significance tier.
+	constexpr uint64 TraceIntervals[]{1, 1, 2, 4};
+}
+
+namespace AlsFootTraceTags
+{
+	static const FName& BatchedTrace()
+	{
+		static const FName Tag{TEXTVIEW("UAlsFootTraceSubsystem::IssueTraces (Batched Trace)")};
+		return Tag;
+	}
+}
+
+bool UAlsFootTraceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAlsFootTraceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsFootTraceSubsystem, STATGROUP_Tickables)
+}
+
+void UAlsFootTraceSubsystem::Tick(const float DeltaTime)
+{
+	IssueTraces();
+}
+
+int32 UAlsFootTraceSubsystem::AllocateTraceId()
+{
+	// Trace ids are never reused, so a rig can't accidentally receive the hit of another rig's trace.
+
+	return NextTraceId.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool UAlsFootTraceSubsystem::RequestTrace(const int32 TraceId, const FVector& Start, const FVector& End,
+                                          const ECollisionChannel Channel, const AActor* OwningActor, FHitResult& OutHit)
+{
+	FScopeLock Lock{&TracesLock};
+
+	auto& Trace{Traces.FindOrAdd(TraceId)};
+
+	Trace.RequestFrame = GFrameCounter;
+
+	if (!Trace.bHitValid || Trace.Channel != Channel ||
+	    FVector::DistSquared(Trace.Hit.TraceStart, Start) > FMath::Square(AlsFootTraceConstants::MaxHitProjectionDistance))
+	{
+		// The caller performs this trace by itself, so it isn't requested until its result is passed to CompleteTrace().
+
+		Trace.bRequested = false;
+		return false;
+	}
+
+	// The completed trace is at least one frame old, so its start location almost never matches the requested one. Instead
+	// of tracing again, intersect the requested trace with the plane of the surface hit by the completed trace.
+
+	OutHit = FHitResult{Start, End};
+
+	if (Trace.Hit.bBlockingHit)
+	{
+		const auto TraceVector{End - Start};
+		const auto TraceVectorDotNormal{TraceVector | Trace.Hit.ImpactNormal};
+
+		const auto HitTime{
+			FMath::Abs(TraceVectorDotNormal) > UE_SMALL_NUMBER
+				? ((Trace.Hit.ImpactPoint - Start) | Trace.Hit.ImpactNormal) / TraceVectorDotNormal
+				: -1.0
+		};
+
+		if (HitTime >= 0.0 && HitTime <= 1.0)
+		{
+			OutHit = Trace.Hit;
+			OutHit.TraceStart = Start;
+			OutHit.TraceEnd = End;
+			OutHit.Time = static_cast<float>(HitTime);
+			OutHit.Distance = static_cast<float>(TraceVector.Size() * HitTime);
+			OutHit.Location = Start + TraceVector * HitTime;
+			OutHit.ImpactPoint = OutHit.Location;
+		}
+	}
+
+	Trace.Start = Start;
+	Trace.End = End;
+	Trace.OwningActor = OwningActor;
+	Trace.bRequested = true;
+
+	ReusedTracesCount.fetch_add(1, std::memory_order_relaxed);
+
+	INC_DWORD_STAT(STAT_UAlsFootTraceSubsystem_TracesReused);
+
+	return true;
+}
+
+void UAlsFootTraceSubsystem::CompleteTrace(const int32 TraceId, const ECollisionChannel Channel, const FHitResult& Hit)
+{
+	FScopeLock Lock{&TracesLock};
+
+	auto& Trace{Traces.FindOrAdd(TraceId)};
+
+	// Any trace still in flight is older than this one, so its result is discarded.
+
+	Trace.TraceHandle = {};
+	Trace.Hit = Hit;
+	Trace.bHitValid = true;
+	Trace.Channel = Channel;
+	Trace.IssueFrame = GFrameCounter;
+	Trace.RequestFrame = GFrameCounter;
+
+	SynchronousTracesCount.fetch_add(1, std::memory_order_relaxed);
+
+	INC_DWORD_STAT(STAT_UAlsFootTraceSubsystem_TracesCompletedSynchronously);
+}
+
+void UAlsFootTraceSubsystem::IssueTraces()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsFootTraceSubsystem::IssueTraces"),
+	                            STAT_UAlsFootTraceSubsystem_IssueTraces, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
+	auto* World{GetWorld()};
+	const auto CurrentFrame{GFrameCounter};
+
+	FScopeLock Lock{&TracesLock};
+
+	for (auto Iterator{Traces.CreateIterator()}; Iterator; ++Iterator)
+	{
+		auto& Trace{Iterator.Value()};
+
+		if (CurrentFrame - Trace.RequestFrame > AlsFootTraceConstants::MaxIdleFrames)
+		{
+			Iterator.RemoveCurrent();
+			continue;
+		}
+
+		if (Trace.TraceHandle.IsValid())
+		{
+			// Traces issued in the previous frame can be queried in the current frame.
+
+			FTraceDatum TraceDatum;
+
+			if (World->QueryTraceData(Trace.TraceHandle, TraceDatum))
+			{
+				Trace.Hit = !TraceDatum.OutHits.IsEmpty() ? TraceDatum.OutHits[0] : FHitResult{TraceDatum.Start, TraceDatum.End};
+				Trace.bHitValid = true;
+				Trace.TraceHandle = {};
+			}
+			else if (CurrentFrame - Trace.IssueFrame > AlsFootTraceConstants::MaxTraceFrames)
+			{
+				Trace.TraceHandle = {};
+			}
+			else
+			{
+				continue;
+			}
+		}
+
+		if (!Trace.bRequested)
+		{
+			continue;
+		}
+
+		const auto* Character{Cast<AAlsCharacter>(Trace.OwningActor.Get())};
+		const auto TraceInterval{
+			IsValid(Character)
+				? AlsFootTraceConstants::TraceIntervals[static_cast<uint8>(Character->GetSignificanceTier())]
+				: AlsFootTraceConstants::TraceIntervals[0]
+		};
+
+		if (Trace.bHitValid && CurrentFrame - Trace.IssueFrame < TraceInterval)
+		{
+			continue;
+		}
+
+		Trace.TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Trace.Start, Trace.End, Trace.Channel,
+		                                                   {AlsFootTraceTags::BatchedTrace(), true, Trace.OwningActor.Get()});
+		Trace.IssueFrame = CurrentFrame;
+		Trace.bRequested = false;
+
+		IssuedTracesCount.fetch_add(1, std::memory_order_relaxed);
+
+		INC_DWORD_STAT(STAT_UAlsFootTraceSubsystem_TracesIssued);
+	}
+}
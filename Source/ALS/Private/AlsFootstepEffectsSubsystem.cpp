@@ -0,0 +1,242 @@
+#include "AlsFootstepEffectsSubsystem.h"
+
+#include "NiagaraSystem.h"
+#include "Components/DecalComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInterface.h"
+#include "Notifies/AlsAnimNotify_FootstepEffects.h"
+#include "Sound/SoundBase.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsFootstepEffectsSubsystem)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Decals Recycled"), STAT_UAlsFootstepEffectsSubsystem_DecalsRecycled, STATGROUP_Als);
+
+namespace AlsFootstepEffectsConsoleVariables
+{
+	static TAutoConsoleVariable<int32> MaxDecals{
+		TEXT("Als.FootstepEffects.MaxDecals"), 64,
+		TEXT("Maximum number of footstep decals per world. The oldest decal is reused once this limit is reached."),
+		ECVF_Scalability
+	};
+}
+
+void UAlsFootstepEffectsSubsystem::Deinitialize()
+{
+	for (auto* Decal : Decals)
+	{
+		if (IsValid(Decal))
+		{
+			Decal->DestroyComponent();
+		}
+	}
+
+	Decals.Reset();
+	NextDecalIndex = 0;
+
+	for (const auto& Handle : PreloadHandles)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->CancelHandle();
+		}
+	}
+
+	for (const auto& Tuple : AsyncLoadHandles)
+	{
+		if (Tuple.Value.IsValid())
+		{
+			Tuple.Value->CancelHandle();
+		}
+	}
+
+	PreloadHandles.Reset();
+	AsyncLoadHandles.Reset();
+	PreloadedSettings.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UAlsFootstepEffectsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return Super::DoesSupportWorldType(WorldType) || WorldType == EWorldType::EditorPreview || WorldType == EWorldType::GamePreview;
+}
+
+bool UAlsFootstepEffectsSubsystem::PreloadEffects(const UAlsFootstepEffectsSettings* FootstepEffectsSettings)
+{
+	if (!IsValid(FootstepEffectsSettings))
+	{
+		return false;
+	}
+
+	auto bAlreadyPreloaded{false};
+	PreloadedSettings.Add(FootstepEffectsSettings, &bAlreadyPreloaded);
+
+	if (bAlreadyPreloaded)
+	{
+		return true;
+	}
+
+	TArray<FSoftObjectPath> AssetPaths;
+	AssetPaths.Reserve(FootstepEffectsSettings->Effects.Num() * 3);
+
+	const auto AddAssetPath{
+		[&AssetPaths](const auto& Asset)
+		{
+			if (!Asset.IsNull() && Asset.Get() == nullptr)
+			{
+				AssetPaths.Add(Asset.ToSoftObjectPath());
+			}
+		}
+	};
+
+	for (const auto& Tuple : FootstepEffectsSettings->Effects)
+	{
+		AddAssetPath(Tuple.Value.Sound.Sound);
+		AddAssetPath(Tuple.Value.Decal.DecalMaterial);
+		AddAssetPath(Tuple.Value.ParticleSystem.ParticleSystem);
+	}
+
+	if (AssetPaths.IsEmpty())
+	{
+		return false;
+	}
+
+	// Keep the handle so that the loaded assets stay referenced for the lifetime of the world.
+
+	auto Handle{UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(AssetPaths))};
+	if (Handle.IsValid())
+	{
+		PreloadHandles.Add(MoveTemp(Handle));
+	}
+
+	return false;
+}
+
+void UAlsFootstepEffectsSubsystem::RequestAsyncLoad(const FSoftObjectPath& AssetPath)
+{
+	if (AssetPath.IsNull() || AsyncLoadHandles.Contains(AssetPath))
+	{
+		return;
+	}
+
+	// Add the entry before requesting the load, since the completion delegate may be called immediately.
+
+	auto& Handle{AsyncLoadHandles.Add(AssetPath)};
+
+	Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		AssetPath, FStreamableDelegate::CreateUObject(this, &ThisClass::OnAsyncLoadCompleted, AssetPath));
+
+	if (!Handle.IsValid())
+	{
+		AsyncLoadHandles.Remove(AssetPath);
+	}
+}
+
+void UAlsFootstepEffectsSubsystem::OnAsyncLoadCompleted(const FSoftObjectPath AssetPath)
+{
+	auto* Handle{AsyncLoadHandles.Find(AssetPath)};
+
+	if (Handle != nullptr && Handle->IsValid() && (*Handle)->GetLoadedAsset() == nullptr)
+	{
+		// The asset failed to load, so release the handle, but keep the entry to not request it again on every footstep.
+
+		Handle->Reset();
+	}
+}
+
+UDecalComponent* UAlsFootstepEffectsSubsystem::SpawnDecal(UMaterialInterface* DecalMaterial, const FVector& DecalSize,
+                                                          const FVector& DecalLocation, const FRotator& DecalRotation,
+                                                          USceneComponent* AttachParent, const float Duration,
+                                                          const float FadeOutDuration)
+{
+	auto* Decal{AcquireDecal()};
+	if (!IsValid(Decal))
+	{
+		return nullptr;
+	}
+
+	if (IsValid(Decal->GetAttachParent()))
+	{
+		Decal->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+
+	Decal->SetWorldLocationAndRotation(DecalLocation, DecalRotation);
+
+	if (IsValid(AttachParent))
+	{
+		Decal->AttachToComponent(AttachParent, FAttachmentTransformRules::KeepWorldTransform);
+	}
+
+	Decal->SetDecalMaterial(DecalMaterial);
+	Decal->DecalSize = DecalSize;
+
+	// Don't use UDecalComponent::SetFadeOut() here, because it destroys the component when the fade out ends. The render
+	// proxy restarts fading from the current world time when it is recreated, so marking the render state as dirty is enough.
+	// The fade duration scale is applied the same way as in UDecalComponent::SetFadeOut().
+
+	static const auto* FadeDurationScaleConsoleVariable{IConsoleManager::Get().FindConsoleVariable(TEXT("r.Decal.FadeDurationScale"))};
+
+	auto FadeDurationScale{FadeDurationScaleConsoleVariable != nullptr ? FadeDurationScaleConsoleVariable->GetFloat() : 1.0f};
+	FadeDurationScale = FadeDurationScale > UE_SMALL_NUMBER ? FadeDurationScale : 0.0f;
+
+	Decal->FadeStartDelay = Duration * FadeDurationScale;
+	Decal->FadeDuration = FadeOutDuration * FadeDurationScale;
+	Decal->bDestroyOwnerAfterFade = false;
+
+	Decal->SetVisibility(true);
+	Decal->MarkRenderStateDirty();
+
+	return Decal;
+}
+
+UDecalComponent* UAlsFootstepEffectsSubsystem::AcquireDecal()
+{
+	auto* World{GetWorld()};
+	if (!IsValid(World))
+	{
+		return nullptr;
+	}
+
+	const auto MaxDecals{FMath::Max(1, AlsFootstepEffectsConsoleVariables::MaxDecals.GetValueOnGameThread())};
+
+	if (Decals.Num() > MaxDecals)
+	{
+		for (auto i{MaxDecals}; i < Decals.Num(); i++)
+		{
+			if (IsValid(Decals[i]))
+			{
+				Decals[i]->DestroyComponent();
+			}
+		}
+
+		Decals.SetNum(MaxDecals);
+	}
+
+	if (NextDecalIndex >= MaxDecals)
+	{
+		NextDecalIndex = 0;
+	}
+
+	if (NextDecalIndex >= Decals.Num())
+	{
+		Decals.AddDefaulted();
+	}
+
+	auto& Decal{Decals[NextDecalIndex]};
+	NextDecalIndex = (NextDecalIndex + 1) % MaxDecals;
+
+	if (IsValid(Decal))
+	{
+		INC_DWORD_STAT(STAT_UAlsFootstepEffectsSubsystem_DecalsRecycled);
+		return Decal;
+	}
+
+	Decal = NewObject<UDecalComponent>(this);
+	Decal->bAllowAnyoneToDestroyMe = true;
+	Decal->SetUsingAbsoluteScale(true);
+	Decal->RegisterComponentWithWorld(World);
+
+	return Decal;
+}
@@ -0,0 +1,321 @@
+#include "AlsNetworkSmoothingSubsystem.h"
+
+#include "AlsCharacterMovementComponent.h"
+#include "Async/ParallelFor.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsNetworkSmoothingSubsystem)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched Network Smoothings"), STAT_UAlsNetworkSmoothingSubsystem_BatchedSmoothings, STATGROUP_Als);
+
+namespace AlsNetworkSmoothingConstants
+{
+	// Smaller batches are interpolated on the game thread, since the interpolation of a single
+	// movement component is too cheap to outweigh the cost of dispatching it to the worker threads.
+	constexpr auto MinParallelBatchSize{32};
+}
+
+void FAlsNetworkSmoothingTickFunction::ExecuteTick(const float DeltaTime, const ELevelTick TickType,
+                                                  const ENamedThreads::Type CurrentThread,
+                                                  const FGraphEventRef& CompletionGraphEvent)
+{
+	if (IsValid(Subsystem))
+	{
+		Subsystem->ExecuteBatch();
+	}
+}
+
+FString FAlsNetworkSmoothingTickFunction::DiagnosticMessage()
+{
+	return FString{TEXTVIEW("UAlsNetworkSmoothingSubsystem::ExecuteBatch")};
+}
+
+FName FAlsNetworkSmoothingTickFunction::DiagnosticContext(const bool bDetailed)
+{
+	return FName{TEXTVIEW("AlsNetworkSmoothing")};
+}
+
+bool UAlsNetworkSmoothingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAlsNetworkSmoothingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TickFunction.Subsystem = this;
+	TickFunction.TickGroup = TG_PrePhysics;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.bAllowTickOnDedicatedServer = false;
+}
+
+void UAlsNetworkSmoothingSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+
+	ResetBatch();
+
+	Super::Deinitialize();
+}
+
+void UAlsNetworkSmoothingSubsystem::OnWorldBeginPlay(UWorld& World)
+{
+	Super::OnWorldBeginPlay(World);
+
+	TickFunction.RegisterTickFunction(World.PersistentLevel);
+}
+
+void UAlsNetworkSmoothingSubsystem::RegisterMovement(UAlsCharacterMovementComponent& Movement)
+{
+	TickFunction.AddPrerequisite(&Movement, Movement.PrimaryComponentTick);
+
+	auto* Mesh{IsValid(Movement.GetCharacterOwner()) ? Movement.GetCharacterOwner()->GetMesh() : nullptr};
+	if (IsValid(Mesh))
+	{
+		Mesh->PrimaryComponentTick.AddPrerequisite(this, TickFunction);
+	}
+}
+
+void UAlsNetworkSmoothingSubsystem::UnregisterMovement(UAlsCharacterMovementComponent& Movement)
+{
+	TickFunction.RemovePrerequisite(&Movement, Movement.PrimaryComponentTick);
+
+	auto* Mesh{IsValid(Movement.GetCharacterOwner()) ? Movement.GetCharacterOwner()->GetMesh() : nullptr};
+	if (IsValid(Mesh))
+	{
+		Mesh->PrimaryComponentTick.RemovePrerequisite(this, TickFunction);
+	}
+}
+
+bool UAlsNetworkSmoothingSubsystem::GatherSmoothing(UAlsCharacterMovementComponent& Movement, const float DeltaTime)
+{
+	check(IsInGameThread())
+
+	if (!TickFunction.IsTickFunctionRegistered() || !TickFunction.IsTickFunctionEnabled() || ExecutionFrame == GFrameCounter)
+	{
+		return false;
+	}
+
+	const auto* PredictionData{Movement.GetPredictionData_Client_Character()};
+	const auto* Mesh{IsValid(Movement.GetCharacterOwner()) ? Movement.GetCharacterOwner()->GetMesh() : nullptr};
+
+	// Same as in UCharacterMovementComponent::SmoothClientPosition_Interpolate(), simulating meshes are not smoothed.
+
+	if (PredictionData == nullptr || !PredictionData->bSmoothNetUpdates || !IsValid(Mesh) || Mesh->IsSimulatingPhysics())
+	{
+		return false;
+	}
+
+	if (GatherFrame != GFrameCounter)
+	{
+		ResetBatch();
+		GatherFrame = GFrameCounter;
+	}
+
+	Movements.Emplace(&Movement);
+	Modes.Add(Movement.NetworkSmoothingMode);
+	DeltaTimes.Add(DeltaTime);
+	Velocities.Add(Movement.Velocity);
+	CorrectionDeltas.Add(PredictionData->LastCorrectionDelta);
+	SmoothLocationTimes.Add(PredictionData->SmoothNetUpdateTime);
+	SmoothRotationTimes.Add(PredictionData->SmoothNetUpdateRotationTime);
+	ServerTimeStamps.Add(PredictionData->SmoothingServerTimeStamp);
+	ClientTimeStamps.Add(PredictionData->SmoothingClientTimeStamp);
+	OriginalTranslationOffsets.Add(PredictionData->OriginalMeshTranslationOffset);
+	TranslationOffsets.Add(PredictionData->MeshTranslationOffset);
+	OriginalRotationOffsets.Add(PredictionData->OriginalMeshRotationOffset);
+	RotationOffsets.Add(PredictionData->MeshRotationOffset);
+	RotationTargets.Add(PredictionData->MeshRotationTarget);
+	SmoothingCompletes.Add(Movement.bNetworkSmoothingComplete);
+
+	return true;
+}
+
+void UAlsNetworkSmoothingSubsystem::ExecuteBatch()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsNetworkSmoothingSubsystem::ExecuteBatch"),
+	                            STAT_UAlsNetworkSmoothingSubsystem_ExecuteBatch, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
+	ExecutionFrame = GFrameCounter;
+
+	if (GatherFrame != GFrameCounter)
+	{
+		ResetBatch();
+	}
+
+	LastBatchSize = Movements.Num();
+
+	if (LastBatchSize <= 0)
+	{
+		return;
+	}
+
+	ParallelFor(TEXT("UAlsNetworkSmoothingSubsystem::ComputeSmoothing"), LastBatchSize, AlsNetworkSmoothingConstants::MinParallelBatchSize,
+	            [this](const int32 Index)
+	            {
+		            ComputeSmoothing(Index);
+	            });
+
+	for (auto i{0}; i < LastBatchSize; i++)
+	{
+		auto* Movement{Movements[i].Get()};
+		auto* PredictionData{IsValid(Movement) ? Movement->GetPredictionData_Client_Character() : nullptr};
+
+		if (PredictionData == nullptr)
+		{
+			continue;
+		}
+
+		PredictionData->SmoothingClientTimeStamp = ClientTimeStamps[i];
+		PredictionData->MeshTranslationOffset = TranslationOffsets[i];
+		PredictionData->MeshRotationOffset = RotationOffsets[i];
+
+		Movement->bNetworkSmoothingComplete = SmoothingCompletes[i] != 0;
+
+		// Same as in UCharacterMovementComponent::SmoothClientPosition(), render static meshes are not updated.
+
+		const auto* Mesh{IsValid(Movement->GetCharacterOwner()) ? Movement->GetCharacterOwner()->GetMesh() : nullptr};
+		if (IsValid(Mesh) && !Mesh->bRenderStatic)
+		{
+			Movement->SmoothClientPosition_UpdateVisuals();
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_UAlsNetworkSmoothingSubsystem_BatchedSmoothings, LastBatchSize);
+
+	ResetBatch();
+}
+
+void UAlsNetworkSmoothingSubsystem::ResetBatch()
+{
+	Movements.Reset();
+	Modes.Reset();
+	DeltaTimes.Reset();
+	Velocities.Reset();
+	CorrectionDeltas.Reset();
+	SmoothLocationTimes.Reset();
+	SmoothRotationTimes.Reset();
+	ServerTimeStamps.Reset();
+	ClientTimeStamps.Reset();
+	OriginalTranslationOffsets.Reset();
+	TranslationOffsets.Reset();
+	OriginalRotationOffsets.Reset();
+	RotationOffsets.Reset();
+	RotationTargets.Reset();
+	SmoothingCompletes.Reset();
+}
+
+void UAlsNetworkSmoothingSubsystem::ComputeSmoothing(const int32 Index)
+{
+	// TODO Copied with modifications from UCharacterMovementComponent::SmoothClientPosition_Interpolate().
+	// TODO After the release of a new engine version, this code should be updated to match the source code.
+
+	const auto DeltaTime{DeltaTimes[Index]};
+
+	auto& TranslationOffset{TranslationOffsets[Index]};
+	auto& RotationOffset{RotationOffsets[Index]};
+	const auto& RotationTarget{RotationTargets[Index]};
+
+	if (Modes[Index] == ENetworkSmoothingMode::Linear)
+	{
+		auto& ClientTimeStamp{ClientTimeStamps[Index]};
+		const auto ServerTimeStamp{ServerTimeStamps[Index]};
+
+		// Increment client position.
+		ClientTimeStamp += DeltaTime;
+
+		static constexpr auto LerpLimit{1.15f};
+
+		auto LerpPercent{0.0f};
+		const auto TargetDelta{CorrectionDeltas[Index]};
+
+		if (TargetDelta > UE_SMALL_NUMBER)
+		{
+			// Don't let the client get too far ahead (happens on spikes). But we do want a buffer for variable network conditions.
+			static constexpr auto MaxClientTimeAheadPercent{0.15f};
+
+			const auto MaxTimeAhead{TargetDelta * MaxClientTimeAheadPercent};
+			ClientTimeStamp = FMath::Min(ClientTimeStamp, ServerTimeStamp + MaxTimeAhead);
+
+			// Compute interpolation alpha based on our client position within the server delta.
+			// We should take TargetDelta seconds to reach alpha of 1.
+			const auto RemainingTime{static_cast<float>(ServerTimeStamp - ClientTimeStamp)};
+			const auto CurrentSmoothTime{TargetDelta - RemainingTime};
+
+			LerpPercent = FMath::Clamp(CurrentSmoothTime / TargetDelta, 0.0f, LerpLimit);
+		}
+		else
+		{
+			LerpPercent = 1.0f;
+		}
+
+		if (LerpPercent >= 1.0f - UE_KINDA_SMALL_NUMBER)
+		{
+			if (Velocities[Index].IsNearlyZero())
+			{
+				TranslationOffset = FVector::ZeroVector;
+				ClientTimeStamp = ServerTimeStamp;
+				SmoothingCompletes[Index] = true;
+			}
+			else
+			{
+				// Allow limited forward prediction.
+				TranslationOffset = FMath::LerpStable(OriginalTranslationOffsets[Index], FVector::ZeroVector, LerpPercent);
+				SmoothingCompletes[Index] = LerpPercent >= LerpLimit;
+			}
+
+			RotationOffset = RotationTarget;
+		}
+		else
+		{
+			TranslationOffset = FMath::LerpStable(OriginalTranslationOffsets[Index], FVector::ZeroVector, LerpPercent);
+			RotationOffset = FQuat::FastLerp(OriginalRotationOffsets[Index], RotationTarget, LerpPercent).GetNormalized();
+		}
+	}
+	else if (Modes[Index] == ENetworkSmoothingMode::Exponential)
+	{
+		// Smooth interpolation of mesh translation to avoid popping of other client pawns unless under a low tick rate.
+		// Faster interpolation if stopped.
+		const auto SmoothLocationTime{Velocities[Index].IsZero() ? 0.5f * SmoothLocationTimes[Index] : SmoothLocationTimes[Index]};
+
+		if (DeltaTime < SmoothLocationTime)
+		{
+			// Slowly decay translation offset.
+			TranslationOffset = TranslationOffset * (1.0f - DeltaTime / SmoothLocationTime);
+		}
+		else
+		{
+			TranslationOffset = FVector::ZeroVector;
+		}
+
+		// Smooth rotation.
+		if (DeltaTime < SmoothRotationTimes[Index])
+		{
+			// Slowly decay rotation offset.
+			RotationOffset = FQuat::FastLerp(RotationOffset, RotationTarget, DeltaTime / SmoothRotationTimes[Index]).GetNormalized();
+		}
+		else
+		{
+			RotationOffset = RotationTarget;
+		}
+
+		// Check if lerp is complete.
+		if (TranslationOffset.IsNearlyZero(1e-2f) && RotationTarget.Equals(RotationOffset, 1e-5f))
+		{
+			SmoothingCompletes[Index] = true;
+
+			// Make sure to snap exactly to target values.
+			TranslationOffset = FVector::ZeroVector;
+			RotationOffset = RotationTarget;
+		}
+	}
+}
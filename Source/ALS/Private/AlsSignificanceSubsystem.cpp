@@ -0,0 +1,204 @@
+#include "AlsSignificanceSubsystem.h"
+
+#include "AlsCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsSignificanceSubsystem)
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance High Tier Characters"), STAT_UAlsSignificanceSubsystem_HighTier, STATGROUP_Als);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance Medium Tier Characters"), STAT_UAlsSignificanceSubsystem_MediumTier, STATGROUP_Als);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance Low Tier Characters"), STAT_UAlsSignificanceSubsystem_LowTier, STATGROUP_Als);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance Lowest Tier Characters"), STAT_UAlsSignificanceSubsystem_LowestTier, STATGROUP_Als);
+
+namespace AlsSignificanceConsoleVariables
+{
+	static TAutoConsoleVariable<bool> Enabled{
+		TEXT("Als.Significance.Enabled"), true,
+		TEXT("If disabled, all characters use the high significance tier."),
+		ECVF_Scalability
+	};
+
+	static TAutoConsoleVariable<float> MediumTierDistance{
+		TEXT("Als.Significance.MediumTierDistance"), 2000.0f,
+		TEXT("Distance to the nearest local viewer from which simulated proxies use the medium significance tier."),
+		ECVF_Scalability
+	};
+
+	static TAutoConsoleVariable<float> LowTierDistance{
+		TEXT("Als.Significance.LowTierDistance"), 4000.0f,
+		TEXT("Distance to the nearest local viewer from which simulated proxies use the low significance tier."),
+		ECVF_Scalability
+	};
+
+	static TAutoConsoleVariable<float> LowestTierDistance{
+		TEXT("Als.Significance.LowestTierDistance"), 8000.0f,
+		TEXT("Distance to the nearest local viewer from which simulated proxies use the lowest significance tier."),
+		ECVF_Scalability
+	};
+}
+
+namespace AlsSignificanceConstants
+{
+	constexpr auto RefreshInterval{0.25f};
+
+	// A character must come this much closer than the tier distance to return to a more significant tier,
+	// which prevents characters standing right on a tier boundary from switching tiers back and forth.
+	constexpr auto HysteresisDistanceScale{1.1f};
+
+	constexpr auto RecentlyRenderedTolerance{0.5f};
+
+	constexpr float RefreshIntervals[]{0.0f, 0.0f, 1.0f / 30.0f, 1.0f / 10.0f};
+}
+
+bool UAlsSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAlsSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsSignificanceSubsystem, STATGROUP_Tickables)
+}
+
+void UAlsSignificanceSubsystem::Tick(const float DeltaTime)
+{
+	RefreshTimeRemaining -= DeltaTime;
+
+	if (RefreshTimeRemaining <= 0.0f)
+	{
+		RefreshTimeRemaining = AlsSignificanceConstants::RefreshInterval;
+		RefreshSignificance();
+	}
+}
+
+void UAlsSignificanceSubsystem::RegisterCharacter(AAlsCharacter* Character)
+{
+	if (IsValid(Character))
+	{
+		Characters.AddUnique(Character);
+	}
+}
+
+void UAlsSignificanceSubsystem::UnregisterCharacter(AAlsCharacter* Character)
+{
+	Characters.RemoveSingleSwap(Character, EAllowShrinking::No);
+}
+
+float UAlsSignificanceSubsystem::GetRefreshInterval(const EAlsSignificanceTier Tier)
+{
+	return AlsSignificanceConstants::RefreshIntervals[static_cast<uint8>(Tier)];
+}
+
+void UAlsSignificanceSubsystem::RefreshSignificance()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsSignificanceSubsystem::RefreshSignificance"),
+	                            STAT_UAlsSignificanceSubsystem_RefreshSignificance, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+
+	for (auto Iterator{GetWorld()->GetPlayerControllerIterator()}; Iterator; ++Iterator)
+	{
+		const auto* PlayerController{Iterator->Get()};
+
+		if (IsValid(PlayerController) && PlayerController->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+
+	uint32 TierCharactersCounts[4]{};
+
+	for (auto i{Characters.Num() - 1}; i >= 0; i--)
+	{
+		auto* Character{Characters[i].Get()};
+
+		if (!IsValid(Character))
+		{
+			Characters.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		const auto Tier{CalculateSignificanceTier(Character, ViewLocations)};
+
+		Character->SetSignificanceTier(Tier);
+		TierCharactersCounts[static_cast<uint8>(Tier)] += 1;
+	}
+
+	SET_DWORD_STAT(STAT_UAlsSignificanceSubsystem_HighTier, TierCharactersCounts[0]);
+	SET_DWORD_STAT(STAT_UAlsSignificanceSubsystem_MediumTier, TierCharactersCounts[1]);
+	SET_DWORD_STAT(STAT_UAlsSignificanceSubsystem_LowTier, TierCharactersCounts[2]);
+	SET_DWORD_STAT(STAT_UAlsSignificanceSubsystem_LowestTier, TierCharactersCounts[3]);
+}
+
+EAlsSignificanceTier UAlsSignificanceSubsystem::CalculateSignificanceTier(const AAlsCharacter* Character,
+                                                                          const TConstArrayView<FVector> ViewLocations) const
+{
+	// Authoritative and autonomous characters always use the high tier, as their simulation must not depend on
+	// the location of local viewers. This also covers dedicated servers, which don't have local viewers at all.
+
+	if (!AlsSignificanceConsoleVariables::Enabled.GetValueOnGameThread() ||
+	    Character->GetLocalRole() != ROLE_SimulatedProxy || ViewLocations.IsEmpty())
+	{
+		return EAlsSignificanceTier::High;
+	}
+
+	const auto CharacterLocation{Character->GetActorLocation()};
+	auto MinDistanceSquared{TNumericLimits<double>::Max()};
+
+	for (const auto& ViewLocation : ViewLocations)
+	{
+		MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(CharacterLocation, ViewLocation));
+	}
+
+	const auto Distance{FMath::Sqrt(MinDistanceSquared)};
+
+	const auto CalculateDistanceTier{
+		[](const double TierDistance)
+		{
+			if (TierDistance >= AlsSignificanceConsoleVariables::LowestTierDistance.GetValueOnGameThread())
+			{
+				return EAlsSignificanceTier::Lowest;
+			}
+
+			if (TierDistance >= AlsSignificanceConsoleVariables::LowTierDistance.GetValueOnGameThread())
+			{
+				return EAlsSignificanceTier::Low;
+			}
+
+			if (TierDistance >= AlsSignificanceConsoleVariables::MediumTierDistance.GetValueOnGameThread())
+			{
+				return EAlsSignificanceTier::Medium;
+			}
+
+			return EAlsSignificanceTier::High;
+		}
+	};
+
+	const auto CurrentTier{Character->GetSignificanceTier()};
+	auto Tier{CalculateDistanceTier(Distance)};
+
+	if (Tier < CurrentTier)
+	{
+		Tier = FMath::Min(CurrentTier, CalculateDistanceTier(Distance * AlsSignificanceConstants::HysteresisDistanceScale));
+	}
+
+	// Characters that are not visible to anyone don't need to be updated as often as the visible ones.
+
+	const auto* Mesh{Character->GetMesh()};
+
+	if (Tier < EAlsSignificanceTier::Low && IsValid(Mesh) &&
+	    !Mesh->WasRecentlyRendered(AlsSignificanceConstants::RecentlyRenderedTolerance))
+	{
+		Tier = EAlsSignificanceTier::Low;
+	}
+
+	return Tier;
+}
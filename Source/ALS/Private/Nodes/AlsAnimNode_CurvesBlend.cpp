@@ -60,10 +60,21 @@ void FAlsAnimNode_CurvesBlend::Evaluate_AnyThread(FPoseContext& Output)
 		return;
 	}
 
-	auto CurvesPoseContext{Output};
+	// This doesn't copy the source pose, but allocates a new pose from the memory stack and copies only the non-pose state.
+
+	FPoseContext CurvesPoseContext{Output};
 	CurvesPose.Evaluate(CurvesPoseContext);
 
-	switch (GetBlendMode())
+	const auto CurrentBlendMode{GetBlendMode()};
+
+	// Blending an empty curves pose doesn't change the source pose curves, except in override mode, which removes them.
+
+	if (CurvesPoseContext.Curve.Num() <= 0 && CurrentBlendMode != EAlsCurvesBlendMode::Override)
+	{
+		return;
+	}
+
+	switch (CurrentBlendMode)
 	{
 		case EAlsCurvesBlendMode::BlendByAmount:
 			Output.Curve.Accumulate(CurvesPoseContext.Curve, CurrentBlendAmount);
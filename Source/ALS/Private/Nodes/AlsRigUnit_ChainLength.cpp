@@ -4,41 +4,38 @@
 
 namespace AlsChainLengthRigUnit
 {
-	float CalculateChainLength(FRigTransformElement* AncestorElement, FRigTransformElement* DescendantElement,
-	                           const URigHierarchy* Hierarchy, const ERigTransformType::Type TransformType, TBitArray<>& VisitedElements)
+	bool FindChain(const FRigTransformElement* AncestorElement, const FRigTransformElement* DescendantElement,
+	               TBitArray<>& VisitedElements, TArray<int32>& ChainElementIndices)
 	{
-		// Based on URigHierarchy::IsDependentOn().
+		// Based on URigHierarchy::IsDependentOn(). On success, the chain
+		// element indices are added in order from the ancestor to the descendant.
 
 		if (AncestorElement == nullptr || DescendantElement == nullptr)
 		{
-			return -1.0f;
+			return false;
 		}
 
 		if (DescendantElement == AncestorElement)
 		{
-			return 0.0f;
+			ChainElementIndices.Add(DescendantElement->GetIndex());
+			return true;
 		}
 
 		const auto DescendantElementIndex{DescendantElement->GetIndex()};
 
-		if (!VisitedElements.IsValidIndex(DescendantElementIndex))
+		if (!VisitedElements.IsValidIndex(DescendantElementIndex) || VisitedElements[DescendantElementIndex])
 		{
-			return -1.0f;
+			return false;
 		}
 
-		if (VisitedElements[DescendantElementIndex])
-		{
-			return -1.0f;
-		}
+		VisitedElements[DescendantElementIndex] = true;
 
-		float ChainLength{-1.0};
-		FRigTransformElement* ParentElement{nullptr};
+		auto bFound{false};
 
 		const auto* SingleParentElement{Cast<FRigSingleParentElement>(DescendantElement)};
 		if (SingleParentElement != nullptr)
 		{
-			ParentElement = SingleParentElement->ParentElement;
-			ChainLength = CalculateChainLength(AncestorElement, ParentElement, Hierarchy, TransformType, VisitedElements);
+			bFound = FindChain(AncestorElement, SingleParentElement->ParentElement, VisitedElements, ChainElementIndices);
 		}
 		else
 		{
@@ -47,25 +44,21 @@ namespace AlsChainLengthRigUnit
 			{
 				for (const auto& ParentConstraint : MultiParentElement->ParentConstraints)
 				{
-					ParentElement = ParentConstraint.ParentElement;
-					ChainLength = CalculateChainLength(AncestorElement, ParentElement, Hierarchy, TransformType, VisitedElements);
-
-					if (ChainLength >= 0.0f)
+					if (FindChain(AncestorElement, ParentConstraint.ParentElement, VisitedElements, ChainElementIndices))
 					{
+						bFound = true;
 						break;
 					}
 				}
 			}
 		}
 
-		if (ChainLength < 0.0f)
+		if (bFound)
 		{
-			return -1.0f;
+			ChainElementIndices.Add(DescendantElementIndex);
 		}
 
-		return UE_REAL_TO_FLOAT(ChainLength + FVector::Distance(
-			Hierarchy->GetTransform(DescendantElement, TransformType).GetLocation(),
-			Hierarchy->GetTransform(ParentElement, TransformType).GetLocation()));
+		return bFound;
 	}
 }
 
@@ -73,7 +66,7 @@ FAlsRigUnit_ChainLength_Execute()
 {
 	DECLARE_SCOPE_HIERARCHICAL_COUNTER_RIGUNIT()
 
-	const auto* Hierarchy{ExecuteContext.Hierarchy};
+	auto* Hierarchy{ExecuteContext.Hierarchy};
 
 	if (!IsValid(Hierarchy) ||
 	    !CachedAncestorItem.UpdateCache(AncestorItem, Hierarchy) ||
@@ -82,17 +75,45 @@ FAlsRigUnit_ChainLength_Execute()
 		return;
 	}
 
-	auto* AncestorTransformElement{const_cast<FRigTransformElement*>(Cast<FRigTransformElement>(CachedAncestorItem.GetElement()))};
-	auto* DescendantTransformElement{const_cast<FRigTransformElement*>(Cast<FRigTransformElement>(CachedDescendantItem.GetElement()))};
+	if (CachedChainAncestorIndex != CachedAncestorItem.GetIndex() ||
+	    CachedChainDescendantIndex != CachedDescendantItem.GetIndex() ||
+	    CachedChainTopologyVersion != Hierarchy->GetTopologyVersion())
+	{
+		CachedChainAncestorIndex = CachedAncestorItem.GetIndex();
+		CachedChainDescendantIndex = CachedDescendantItem.GetIndex();
+		CachedChainTopologyVersion = Hierarchy->GetTopologyVersion();
+
+		const auto* AncestorTransformElement{Cast<FRigTransformElement>(CachedAncestorItem.GetElement())};
+		const auto* DescendantTransformElement{Cast<FRigTransformElement>(CachedDescendantItem.GetElement())};
+
+		CachedChainElementIndices.Reset();
+
+		TBitArray VisitedElements{false, Hierarchy->Num()};
+
+		if (!AlsChainLengthRigUnit::FindChain(AncestorTransformElement, DescendantTransformElement,
+		                                      VisitedElements, CachedChainElementIndices))
+		{
+			CachedChainElementIndices.Reset();
+			VisitedElements.Init(false, Hierarchy->Num());
+
+			AlsChainLengthRigUnit::FindChain(DescendantTransformElement, AncestorTransformElement,
+			                                 VisitedElements, CachedChainElementIndices);
+		}
+	}
+
 	const auto TransformType{bInitial ? ERigTransformType::InitialGlobal : ERigTransformType::CurrentGlobal};
-	TBitArray VisitedElements{false, Hierarchy->Num()};
 
-	Length = AlsChainLengthRigUnit::CalculateChainLength(AncestorTransformElement, DescendantTransformElement,
-	                                                     Hierarchy, TransformType, VisitedElements);
+	Length = 0.0f;
 
-	if (Length < 0.0f)
+	for (auto i{1}; i < CachedChainElementIndices.Num(); i++)
 	{
-		Length = FMath::Max(0.0f, AlsChainLengthRigUnit::CalculateChainLength(DescendantTransformElement, AncestorTransformElement,
-		                                                                      Hierarchy, TransformType, VisitedElements));
+		auto* ParentElement{Hierarchy->Get<FRigTransformElement>(CachedChainElementIndices[i - 1])};
+		auto* ChildElement{Hierarchy->Get<FRigTransformElement>(CachedChainElementIndices[i])};
+
+		if (ParentElement != nullptr && ChildElement != nullptr)
+		{
+			Length += UE_REAL_TO_FLOAT(FVector::Distance(Hierarchy->GetTransform(ChildElement, TransformType).GetLocation(),
+			                                             Hierarchy->GetTransform(ParentElement, TransformType).GetLocation()));
+		}
 	}
 }
@@ -1,10 +1,21 @@
 #include "Nodes/AlsRigUnit_FootOffsetTrace.h"
 
+#include "AlsFootTraceSubsystem.h"
 #include "Engine/HitResult.h"
 #include "Engine/World.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsRigUnit_FootOffsetTrace)
 
+namespace AlsFootOffsetTraceConsoleVariables
+{
+	static TAutoConsoleVariable<int32> BatchTraces{
+		TEXT("Als.ControlRig.BatchFootOffsetTraces"), -1,
+		TEXT("Overrides the Batch Trace input of all foot offset trace rig units. ")
+		TEXT("-1 - use the input, 0 - never batch the traces, 1 - always batch the traces."),
+		ECVF_Default
+	};
+}
+
 FAlsRigUnit_FootOffsetTrace_Execute()
 {
 	DECLARE_SCOPE_HIERARCHICAL_COUNTER_RIGUNIT()
@@ -21,9 +32,33 @@ FAlsRigUnit_FootOffsetTrace_Execute()
 	const FVector TraceStart{FootTargetLocation.X, FootTargetLocation.Y, TraceDistanceUpward};
 	const FVector TraceEnd{FootTargetLocation.X, FootTargetLocation.Y, -TraceDistanceDownward};
 
+	const auto WorldTraceStart{ExecuteContext.ToWorldSpace(TraceStart)};
+	const auto WorldTraceEnd{ExecuteContext.ToWorldSpace(TraceEnd)};
+
+	const auto BatchTracesOverride{AlsFootOffsetTraceConsoleVariables::BatchTraces.GetValueOnAnyThread()};
+	const auto bBatch{BatchTracesOverride < 0 ? bBatchTrace : BatchTracesOverride > 0};
+
+	const auto* World{ExecuteContext.GetWorld()};
+	auto* TraceSubsystem{bBatch ? World->GetSubsystem<UAlsFootTraceSubsystem>() : nullptr};
+
+	if (TraceSubsystem != nullptr && TraceId == INDEX_NONE)
+	{
+		TraceId = TraceSubsystem->AllocateTraceId();
+	}
+
 	FHitResult Hit;
-	ExecuteContext.GetWorld()->LineTraceSingleByChannel(Hit, ExecuteContext.ToWorldSpace(TraceStart), ExecuteContext.ToWorldSpace(TraceEnd),
-	                                                    TraceChannel, {__FUNCTION__, true, ExecuteContext.GetOwningActor()});
+
+	if (TraceSubsystem == nullptr ||
+	    !TraceSubsystem->RequestTrace(TraceId, WorldTraceStart, WorldTraceEnd, TraceChannel, ExecuteContext.GetOwningActor(), Hit))
+	{
+		World->LineTraceSingleByChannel(Hit, WorldTraceStart, WorldTraceEnd, TraceChannel,
+		                                {__FUNCTION__, true, ExecuteContext.GetOwningActor()});
+
+		if (TraceSubsystem != nullptr)
+		{
+			TraceSubsystem->CompleteTrace(TraceId, TraceChannel, Hit);
+		}
+	}
 
 	auto* DrawInterface{ExecuteContext.GetDrawInterface()};
 	if (DrawInterface != nullptr && bDrawDebug)
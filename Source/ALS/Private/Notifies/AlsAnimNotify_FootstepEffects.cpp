@@ -1,6 +1,7 @@
 #include "Notifies/AlsAnimNotify_FootstepEffects.h"
 
 #include "AlsCharacter.h"
+#include "AlsFootstepEffectsSubsystem.h"
 #include "DrawDebugHelpers.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Animation/AnimInstance.h"
@@ -19,6 +20,32 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimNotify_FootstepEffects)
 
+namespace AlsFootstepEffects
+{
+	template <typename AssetType>
+	AssetType* GetAssetOrRequestAsyncLoad(const TSoftObjectPtr<AssetType>& Asset, const UWorld* World,
+	                                      UAlsFootstepEffectsSubsystem* EffectsSubsystem, const bool bEffectsPreloaded)
+	{
+		auto* LoadedAsset{Asset.Get()};
+
+		if (LoadedAsset != nullptr || Asset.IsNull())
+		{
+			return LoadedAsset;
+		}
+
+		// Animation editor previews have no gameplay to hitch, so it is better to load the asset right away there. The same applies
+		// to the first footstep of effects that nothing has preloaded yet: skipping it would silence the first footstep on every surface.
+
+		if (World->WorldType == EWorldType::EditorPreview || !IsValid(EffectsSubsystem) || !bEffectsPreloaded)
+		{
+			return Asset.LoadSynchronous();
+		}
+
+		EffectsSubsystem->RequestAsyncLoad(Asset.ToSoftObjectPath());
+		return nullptr;
+	}
+}
+
 #if WITH_EDITOR
 void FAlsFootstepDecalSettings::PostEditChangeProperty(const FPropertyChangedEvent& ChangedEvent)
 {
@@ -96,6 +123,13 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 	const auto* World{Mesh->GetWorld()};
 	const auto MeshScale{Mesh->GetComponentScale().Z};
 
+	auto* EffectsSubsystem{World->GetSubsystem<UAlsFootstepEffectsSubsystem>()};
+
+	// Usually the effects are already preloaded by the animation instance, in which case this does nothing. Otherwise,
+	// the preload starts now and assets that this footstep needs are loaded synchronously until the preload exists.
+
+	const auto bEffectsPreloaded{IsValid(EffectsSubsystem) && EffectsSubsystem->PreloadEffects(FootstepEffectsSettings)};
+
 	const auto& FootBoneName{FootBone == EAlsFootBone::Left ? UAlsConstants::FootLeftBoneName() : UAlsConstants::FootRightBoneName()};
 	const auto FootTransform{Mesh->GetSocketTransform(FootBoneName)};
 
@@ -171,21 +205,24 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 
 	if (bSpawnSound)
 	{
-		SpawnSound(Mesh, EffectSettings->Sound, FootstepLocation, FootstepRotation);
+		SpawnSound(Mesh, EffectsSubsystem, bEffectsPreloaded, EffectSettings->Sound, FootstepLocation, FootstepRotation);
 	}
 
 	if (bSpawnDecal)
 	{
-		SpawnDecal(Mesh, EffectSettings->Decal, FootstepLocation, FootstepRotation, FootstepHit, FootZAxis);
+		SpawnDecal(Mesh, EffectsSubsystem, bEffectsPreloaded, EffectSettings->Decal,
+		           FootstepLocation, FootstepRotation, FootstepHit, FootZAxis);
 	}
 
 	if (bSpawnParticleSystem)
 	{
-		SpawnParticleSystem(Mesh, EffectSettings->ParticleSystem, FootstepLocation, FootstepRotation);
+		SpawnParticleSystem(Mesh, EffectsSubsystem, bEffectsPreloaded, EffectSettings->ParticleSystem,
+		                    FootstepLocation, FootstepRotation);
 	}
 }
 
-void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, const FAlsFootstepSoundSettings& SoundSettings,
+void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, UAlsFootstepEffectsSubsystem* EffectsSubsystem,
+                                                const bool bEffectsPreloaded, const FAlsFootstepSoundSettings& SoundSettings,
                                                 const FVector& FootstepLocation, const FQuat& FootstepRotation) const
 {
 	auto VolumeMultiplier{SoundVolumeMultiplier};
@@ -195,7 +232,15 @@ void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, co
 		VolumeMultiplier *= 1.0f - UAlsMath::Clamp01(Mesh->GetAnimInstance()->GetCurveValue(UAlsConstants::FootstepSoundBlockCurveName()));
 	}
 
-	if (!FAnimWeight::IsRelevant(VolumeMultiplier) || !IsValid(SoundSettings.Sound.LoadSynchronous()))
+	if (!FAnimWeight::IsRelevant(VolumeMultiplier))
+	{
+		return;
+	}
+
+	const auto* World{Mesh->GetWorld()};
+
+	auto* Sound{AlsFootstepEffects::GetAssetOrRequestAsyncLoad(SoundSettings.Sound, World, EffectsSubsystem, bEffectsPreloaded)};
+	if (!IsValid(Sound))
 	{
 		return;
 	}
@@ -204,16 +249,14 @@ void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, co
 
 	if (SoundSettings.SpawnMode == EAlsFootstepSoundSpawnMode::SpawnAtTraceHitLocation)
 	{
-		const auto* World{Mesh->GetWorld()};
-
 		if (World->WorldType == EWorldType::EditorPreview)
 		{
-			UGameplayStatics::PlaySoundAtLocation(World, SoundSettings.Sound.Get(), FootstepLocation,
+			UGameplayStatics::PlaySoundAtLocation(World, Sound, FootstepLocation,
 			                                      VolumeMultiplier, SoundPitchMultiplier);
 		}
 		else
 		{
-			Audio = UGameplayStatics::SpawnSoundAtLocation(World, SoundSettings.Sound.Get(), FootstepLocation,
+			Audio = UGameplayStatics::SpawnSoundAtLocation(World, Sound, FootstepLocation,
 			                                               FootstepRotation.Rotator(),
 			                                               VolumeMultiplier, SoundPitchMultiplier);
 		}
@@ -224,7 +267,7 @@ void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, co
 			FootBone == EAlsFootBone::Left ? UAlsConstants::FootLeftBoneName() : UAlsConstants::FootRightBoneName()
 		};
 
-		Audio = UGameplayStatics::SpawnSoundAttached(SoundSettings.Sound.Get(), Mesh, FootBoneName, FVector::ZeroVector,
+		Audio = UGameplayStatics::SpawnSoundAttached(Sound, Mesh, FootBoneName, FVector::ZeroVector,
 		                                             FRotator::ZeroRotator, EAttachLocation::SnapToTarget,
 		                                             true, VolumeMultiplier, SoundPitchMultiplier);
 	}
@@ -235,7 +278,8 @@ void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, co
 	}
 }
 
-void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, const FAlsFootstepDecalSettings& DecalSettings,
+void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, UAlsFootstepEffectsSubsystem* EffectsSubsystem,
+                                                const bool bEffectsPreloaded, const FAlsFootstepDecalSettings& DecalSettings,
                                                 const FVector& FootstepLocation, const FQuat& FootstepRotation,
                                                 const FHitResult& FootstepHit, const FVector& FootZAxis) const
 {
@@ -244,7 +288,11 @@ void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, co
 		return;
 	}
 
-	if (!IsValid(DecalSettings.DecalMaterial.LoadSynchronous()))
+	auto* DecalMaterial{
+		AlsFootstepEffects::GetAssetOrRequestAsyncLoad(DecalSettings.DecalMaterial, Mesh->GetWorld(), EffectsSubsystem, bEffectsPreloaded)
+	};
+
+	if (!IsValid(DecalMaterial))
 	{
 		return;
 	}
@@ -263,21 +311,31 @@ void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, co
 		FootstepLocation + DecalRotation.RotateVector(FVector{DecalSettings.LocationOffset} * MeshScale)
 	};
 
-	UDecalComponent* Decal{nullptr};
+	const auto bAttachToHitComponent{
+		DecalSettings.SpawnMode == EAlsFootstepDecalSpawnMode::SpawnAttachedToTraceHitComponent && FootstepHit.Component.IsValid()
+	};
 
-	if (DecalSettings.SpawnMode == EAlsFootstepDecalSpawnMode::SpawnAtTraceHitLocation || !FootstepHit.Component.IsValid())
+	if (IsValid(EffectsSubsystem))
 	{
-		Decal = UGameplayStatics::SpawnDecalAtLocation(Mesh->GetWorld(), DecalSettings.DecalMaterial.Get(),
-		                                               FVector{DecalSettings.Size} * MeshScale,
-		                                               DecalLocation, DecalRotation.Rotator());
+		EffectsSubsystem->SpawnDecal(DecalMaterial, FVector{DecalSettings.Size} * MeshScale, DecalLocation, DecalRotation.Rotator(),
+		                             bAttachToHitComponent ? FootstepHit.Component.Get() : nullptr,
+		                             DecalSettings.Duration, DecalSettings.FadeOutDuration);
+		return;
 	}
-	else if (DecalSettings.SpawnMode == EAlsFootstepDecalSpawnMode::SpawnAttachedToTraceHitComponent)
+
+	UDecalComponent* Decal;
+
+	if (bAttachToHitComponent)
 	{
-		Decal = UGameplayStatics::SpawnDecalAttached(DecalSettings.DecalMaterial.Get(),
-		                                             FVector{DecalSettings.Size} * MeshScale,
+		Decal = UGameplayStatics::SpawnDecalAttached(DecalMaterial, FVector{DecalSettings.Size} * MeshScale,
 		                                             FootstepHit.Component.Get(), NAME_None, DecalLocation,
 		                                             DecalRotation.Rotator(), EAttachLocation::KeepWorldPosition);
 	}
+	else
+	{
+		Decal = UGameplayStatics::SpawnDecalAtLocation(Mesh->GetWorld(), DecalMaterial, FVector{DecalSettings.Size} * MeshScale,
+		                                               DecalLocation, DecalRotation.Rotator());
+	}
 
 	if (IsValid(Decal))
 	{
@@ -285,11 +343,17 @@ void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, co
 	}
 }
 
-void UAlsAnimNotify_FootstepEffects::SpawnParticleSystem(USkeletalMeshComponent* Mesh,
+void UAlsAnimNotify_FootstepEffects::SpawnParticleSystem(USkeletalMeshComponent* Mesh, UAlsFootstepEffectsSubsystem* EffectsSubsystem,
+                                                         const bool bEffectsPreloaded,
                                                          const FAlsFootstepParticleSystemSettings& ParticleSystemSettings,
                                                          const FVector& FootstepLocation, const FQuat& FootstepRotation) const
 {
-	if (!IsValid(ParticleSystemSettings.ParticleSystem.LoadSynchronous()))
+	auto* ParticleSystem{
+		AlsFootstepEffects::GetAssetOrRequestAsyncLoad(ParticleSystemSettings.ParticleSystem, Mesh->GetWorld(),
+		                                               EffectsSubsystem, bEffectsPreloaded)
+	};
+
+	if (!IsValid(ParticleSystem))
 	{
 		return;
 	}
@@ -311,7 +375,7 @@ void UAlsAnimNotify_FootstepEffects::SpawnParticleSystem(USkeletalMeshComponent*
 			ParticleSystemRotation.RotateVector(FVector{ParticleSystemSettings.LocationOffset} * MeshScale)
 		};
 
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(Mesh->GetWorld(), ParticleSystemSettings.ParticleSystem.Get(),
+		UNiagaraFunctionLibrary::SpawnSystemAtLocation(Mesh->GetWorld(), ParticleSystem,
 		                                               ParticleSystemLocation, ParticleSystemRotation.Rotator(),
 		                                               FVector::OneVector * MeshScale, true, true, ENCPoolMethod::AutoRelease);
 	}
@@ -319,7 +383,7 @@ void UAlsAnimNotify_FootstepEffects::SpawnParticleSystem(USkeletalMeshComponent*
 	{
 		const auto& FootBoneName{FootBone == EAlsFootBone::Left ? UAlsConstants::FootLeftBoneName() : UAlsConstants::FootRightBoneName()};
 
-		UNiagaraFunctionLibrary::SpawnSystemAttached(ParticleSystemSettings.ParticleSystem.Get(), Mesh, FootBoneName,
+		UNiagaraFunctionLibrary::SpawnSystemAttached(ParticleSystem, Mesh, FootBoneName,
 		                                             FVector{ParticleSystemSettings.LocationOffset} * MeshScale,
 		                                             FRotator{
 			                                             FootBone == EAlsFootBone::Left
@@ -1,7 +1,32 @@
 ﻿#include "Settings/AlsAnimationInstanceSettings.h"
 
+#include "Curves/CurveFloat.h"
+#include "Utility/AlsLog.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimationInstanceSettings)
 
+namespace AlsAnimationInstanceSettings
+{
+	static void BakeCurve(UCurveFloat* Curve, FAlsBakedCurve& BakedCurve)
+	{
+		if (!IsValid(Curve))
+		{
+			BakedCurve.Reset();
+			return;
+		}
+
+		// The curve may not have been post-loaded yet if the animation instance settings are post-loaded first.
+
+		Curve->ConditionalPostLoad();
+
+		if (!BakedCurve.Bake(Curve->FloatCurve))
+		{
+			UE_LOG(LogAls, Log, TEXT("%s: the curve can't be baked within the allowed error (%f) or isn't extrapolated as")
+			       TEXT(" a constant, exact evaluation will be used instead."), *Curve->GetPathName(), BakedCurve.GetMaxError());
+		}
+	}
+}
+
 UAlsAnimationInstanceSettings::UAlsAnimationInstanceSettings()
 {
 	InAir.GroundPredictionResponseChannels =
@@ -16,7 +41,25 @@ UAlsAnimationInstanceSettings::UAlsAnimationInstanceSettings()
 	InAir.GroundPredictionSweepResponses.Destructible = ECR_Block;
 }
 
+void UAlsAnimationInstanceSettings::PostLoad()
+{
+	Super::PostLoad();
+
+	BakeCurves();
+
 #if WITH_EDITOR
+	BindCurves();
+#endif
+}
+
+#if WITH_EDITOR
+void UAlsAnimationInstanceSettings::BeginDestroy()
+{
+	UnbindCurves();
+
+	Super::BeginDestroy();
+}
+
 void UAlsAnimationInstanceSettings::PostEditChangeProperty(FPropertyChangedEvent& ChangedEvent)
 {
 	if (ChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_STRING_VIEW_CHECKED(ThisClass, InAir))
@@ -24,6 +67,76 @@ void UAlsAnimationInstanceSettings::PostEditChangeProperty(FPropertyChangedEvent
 		InAir.PostEditChangeProperty(ChangedEvent);
 	}
 
+	BakeCurves();
+	BindCurves();
+
 	Super::PostEditChangeProperty(ChangedEvent);
 }
 #endif
+
+void UAlsAnimationInstanceSettings::BakeCurves()
+{
+	using namespace AlsAnimationInstanceSettings;
+
+	BakeCurve(Grounded.RotationYawOffsetForwardCurve, Grounded.RotationYawOffsetForwardBakedCurve);
+	BakeCurve(Grounded.RotationYawOffsetBackwardCurve, Grounded.RotationYawOffsetBackwardBakedCurve);
+	BakeCurve(Grounded.RotationYawOffsetLeftCurve, Grounded.RotationYawOffsetLeftBakedCurve);
+	BakeCurve(Grounded.RotationYawOffsetRightCurve, Grounded.RotationYawOffsetRightBakedCurve);
+
+	BakeCurve(Standing.StrideBlendAmountWalkCurve, Standing.StrideBlendAmountWalkBakedCurve);
+	BakeCurve(Standing.StrideBlendAmountRunCurve, Standing.StrideBlendAmountRunBakedCurve);
+
+	BakeCurve(Crouching.StrideBlendAmountCurve, Crouching.StrideBlendAmountBakedCurve);
+
+	BakeCurve(InAir.LeanAmountCurve, InAir.LeanAmountBakedCurve);
+	BakeCurve(InAir.GroundPredictionAmountCurve, InAir.GroundPredictionAmountBakedCurve);
+}
+
+#if WITH_EDITOR
+void UAlsAnimationInstanceSettings::BindCurves()
+{
+	UnbindCurves();
+
+	UCurveBase* Curves[]
+	{
+		Grounded.RotationYawOffsetForwardCurve,
+		Grounded.RotationYawOffsetBackwardCurve,
+		Grounded.RotationYawOffsetLeftCurve,
+		Grounded.RotationYawOffsetRightCurve,
+		Standing.StrideBlendAmountWalkCurve,
+		Standing.StrideBlendAmountRunCurve,
+		Crouching.StrideBlendAmountCurve,
+		InAir.LeanAmountCurve,
+		InAir.GroundPredictionAmountCurve
+	};
+
+	for (auto* Curve : Curves)
+	{
+		if (IsValid(Curve) && !BoundCurves.Contains(Curve))
+		{
+			Curve->OnUpdateCurve.AddUObject(this, &ThisClass::Curve_OnUpdated);
+			BoundCurves.Emplace(Curve);
+		}
+	}
+}
+
+void UAlsAnimationInstanceSettings::UnbindCurves()
+{
+	for (const auto& Curve : BoundCurves)
+	{
+		if (Curve.IsValid())
+		{
+			Curve->OnUpdateCurve.RemoveAll(this);
+		}
+	}
+
+	BoundCurves.Reset();
+}
+
+void UAlsAnimationInstanceSettings::Curve_OnUpdated(UCurveBase* Curve, EPropertyChangeType::Type ChangeType)
+{
+	// Editing a curve doesn't change the animation instance settings themselves, so the lookup tables must be rebaked manually.
+
+	BakeCurves();
+}
+#endif
@@ -1,8 +1,68 @@
 #include "Settings/AlsMovementSettings.h"
 
+#include "Curves/CurveVector.h"
+#include "Utility/AlsLog.h"
+#include "Utility/AlsTagIndexRegistry.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsMovementSettings)
 
+void FAlsMovementGaitSettings::BakeCurves()
+{
+	auto& BakedCurves{AccelerationAndDecelerationAndGroundFrictionBakedCurves};
+
+	for (auto& BakedCurve : BakedCurves)
+	{
+		BakedCurve.Reset();
+	}
+
+	if (!IsValid(AccelerationAndDecelerationAndGroundFrictionCurve))
+	{
+		return;
+	}
+
+	// The curve may not have been post-loaded yet if the movement settings are post-loaded first.
+
+	AccelerationAndDecelerationAndGroundFrictionCurve->ConditionalPostLoad();
+
+	// Gait amount ranges from 0 to 3, where 0 is stopped, 1 is walking, 2 is running, and 3 is sprinting.
+
+	for (auto i{0}; i < BakedCurves.Num(); i++)
+	{
+		if (!BakedCurves[i].Bake(AccelerationAndDecelerationAndGroundFrictionCurve->FloatCurves[i], 0.0f, 3.0f))
+		{
+			UE_LOG(LogAls, Warning, TEXT("%s: curve %d can't be baked within the allowed error (%f), exact evaluation will be used instead."),
+			       *AccelerationAndDecelerationAndGroundFrictionCurve->GetPathName(), i, BakedCurves[i].GetMaxError());
+
+			for (auto& BakedCurve : BakedCurves)
+			{
+				BakedCurve.Reset();
+			}
+
+			return;
+		}
+	}
+}
+
+void UAlsMovementSettings::PostLoad()
+{
+	Super::PostLoad();
+
+	BakeCurves();
+	CompileGaitSettings();
+
+#if WITH_EDITOR
+	BindCurves();
+#endif
+}
+
 #if WITH_EDITOR
+void UAlsMovementSettings::BeginDestroy()
+{
+	UnbindCurves();
+
+	Super::BeginDestroy();
+}
+
 void UAlsMovementSettings::PostEditChangeProperty(FPropertyChangedEvent& ChangedEvent)
 {
 	if (ChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_STRING_VIEW_CHECKED(ThisClass, VelocityAngleToSpeedInterpolationRange))
@@ -11,6 +71,119 @@ void UAlsMovementSettings::PostEditChangeProperty(FPropertyChangedEvent& Changed
 		                                                      VelocityAngleToSpeedInterpolationRange.Y);
 	}
 
+	BakeCurves();
+	CompileGaitSettings();
+	BindCurves();
+
 	Super::PostEditChangeProperty(ChangedEvent);
 }
 #endif
+
+void UAlsMovementSettings::BakeCurves()
+{
+	for (auto& StanceSettings : RotationModes)
+	{
+		for (auto& GaitSettings : StanceSettings.Value.Stances)
+		{
+			GaitSettings.Value.BakeCurves();
+		}
+	}
+}
+
+void UAlsMovementSettings::CompileGaitSettings()
+{
+	check(AlsTagIndexRegistry::GetFamilyTags(EAlsTagFamily::RotationMode).Num() < CompiledRotationModesCount)
+	check(AlsTagIndexRegistry::GetFamilyTags(EAlsTagFamily::Stance).Num() < CompiledStancesCount)
+
+	// The table is always updated in place, so that pointers to its elements are never invalidated.
+
+	for (auto i{0}; i < CompiledGaitSettings.Num(); i++)
+	{
+		CompiledGaitSettings[i] = {};
+		CompiledGaitSettingsValid[i] = false;
+	}
+
+	for (const auto& StanceSettings : RotationModes)
+	{
+		const auto RotationModeIndex{AlsTagIndexRegistry::GetIndexByTag(EAlsTagFamily::RotationMode, StanceSettings.Key)};
+		if (RotationModeIndex <= 0)
+		{
+			continue;
+		}
+
+		for (const auto& GaitSettings : StanceSettings.Value.Stances)
+		{
+			const auto StanceIndex{AlsTagIndexRegistry::GetIndexByTag(EAlsTagFamily::Stance, GaitSettings.Key)};
+			if (StanceIndex > 0)
+			{
+				const auto Index{RotationModeIndex * CompiledStancesCount + StanceIndex};
+
+				CompiledGaitSettings[Index] = GaitSettings.Value;
+				CompiledGaitSettingsValid[Index] = true;
+			}
+		}
+	}
+
+#if WITH_EDITOR
+	OnGaitSettingsCompiled.Broadcast();
+#endif
+}
+
+const FAlsMovementGaitSettings* UAlsMovementSettings::FindGaitSettings(const FGameplayTag& RotationMode, const FGameplayTag& Stance) const
+{
+	const auto RotationModeIndex{AlsTagIndexRegistry::GetIndexByTag(EAlsTagFamily::RotationMode, RotationMode)};
+	const auto StanceIndex{AlsTagIndexRegistry::GetIndexByTag(EAlsTagFamily::Stance, Stance)};
+
+	if (RotationModeIndex > 0 && StanceIndex > 0)
+	{
+		const auto Index{RotationModeIndex * CompiledStancesCount + StanceIndex};
+		return CompiledGaitSettingsValid[Index] ? &CompiledGaitSettings[Index] : nullptr;
+	}
+
+	// Custom rotation modes and stances are not compiled, so fall back to the map lookups.
+
+	const auto* StanceSettings{RotationModes.Find(RotationMode)};
+	return StanceSettings != nullptr ? StanceSettings->Stances.Find(Stance) : nullptr;
+}
+
+#if WITH_EDITOR
+void UAlsMovementSettings::BindCurves()
+{
+	UnbindCurves();
+
+	for (auto& StanceSettings : RotationModes)
+	{
+		for (auto& GaitSettings : StanceSettings.Value.Stances)
+		{
+			UCurveBase* Curve{GaitSettings.Value.AccelerationAndDecelerationAndGroundFrictionCurve};
+
+			if (IsValid(Curve) && !BoundCurves.Contains(Curve))
+			{
+				Curve->OnUpdateCurve.AddUObject(this, &ThisClass::Curve_OnUpdated);
+				BoundCurves.Emplace(Curve);
+			}
+		}
+	}
+}
+
+void UAlsMovementSettings::UnbindCurves()
+{
+	for (const auto& Curve : BoundCurves)
+	{
+		if (Curve.IsValid())
+		{
+			Curve->OnUpdateCurve.RemoveAll(this);
+		}
+	}
+
+	BoundCurves.Reset();
+}
+
+void UAlsMovementSettings::Curve_OnUpdated(UCurveBase* Curve, EPropertyChangeType::Type ChangeType)
+{
+	// Editing a curve doesn't change the movement settings themselves, so the lookup tables must be rebaked manually.
+
+	BakeCurves();
+	CompileGaitSettings();
+}
+#endif
@@ -0,0 +1,52 @@
+#include "State/AlsPackedDesiredState.h"
+
+#include "Utility/AlsTagIndexRegistry.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsPackedDesiredState)
+
+bool FAlsPackedDesiredState::NetSerialize(FArchive& Archive, UPackageMap* Map, bool& bSuccess)
+{
+	static constexpr auto ChangedFieldsBitsCount{6};
+
+	auto ChangedFieldsValue{static_cast<uint8>(ChangedFields & EAlsDesiredStateFields::All)};
+	Archive.SerializeBits(&ChangedFieldsValue, ChangedFieldsBitsCount);
+	ChangedFields = static_cast<EAlsDesiredStateFields>(ChangedFieldsValue);
+
+	bSuccess = true;
+
+	if (EnumHasAnyFlags(ChangedFields, EAlsDesiredStateFields::ViewMode))
+	{
+		bSuccess &= AlsTagIndexRegistry::NetSerializeTag(Archive, Map, EAlsTagFamily::ViewMode, ViewMode);
+	}
+
+	if (EnumHasAnyFlags(ChangedFields, EAlsDesiredStateFields::OverlayMode))
+	{
+		bSuccess &= AlsTagIndexRegistry::NetSerializeTag(Archive, Map, EAlsTagFamily::OverlayMode, OverlayMode);
+	}
+
+	if (EnumHasAnyFlags(ChangedFields, EAlsDesiredStateFields::DesiredAiming))
+	{
+		auto bDesiredAimingValue{static_cast<uint8>(bDesiredAiming)};
+		Archive.SerializeBits(&bDesiredAimingValue, 1);
+		bDesiredAiming = bDesiredAimingValue & 1;
+	}
+
+	if (EnumHasAnyFlags(ChangedFields, EAlsDesiredStateFields::DesiredRotationMode))
+	{
+		bSuccess &= AlsTagIndexRegistry::NetSerializeTag(Archive, Map, EAlsTagFamily::RotationMode, DesiredRotationMode);
+	}
+
+	if (EnumHasAnyFlags(ChangedFields, EAlsDesiredStateFields::DesiredStance))
+	{
+		bSuccess &= AlsTagIndexRegistry::NetSerializeTag(Archive, Map, EAlsTagFamily::Stance, DesiredStance);
+	}
+
+	if (EnumHasAnyFlags(ChangedFields, EAlsDesiredStateFields::DesiredGait))
+	{
+		bSuccess &= AlsTagIndexRegistry::NetSerializeTag(Archive, Map, EAlsTagFamily::Gait, DesiredGait);
+	}
+
+	bSuccess &= !Archive.IsError();
+
+	return bSuccess;
+}
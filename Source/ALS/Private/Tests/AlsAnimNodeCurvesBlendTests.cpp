@@ -0,0 +1,164 @@
+#include "Animation/AnimInstanceProxy.h"
+#include "Animation/Skeleton.h"
+#include "Misc/AutomationTest.h"
+#include "Nodes/AlsAnimNode_CurvesBlend.h"
+#include "Utility/AlsEnumUtility.h"
+
+// The blend amount and blend mode are folded properties, which are stored on the node only in builds with editor-only data.
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITORONLY_DATA
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsAnimNodeCurvesBlendBenchmarkTest, "Als.AnimNode.CurvesBlend.Benchmark",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace AlsAnimNodeCurvesBlendTests
+{
+	static constexpr auto BonesCount{100};
+	static constexpr auto CurvesCount{32};
+
+	static constexpr auto WarmupEvaluationsCount{100};
+	static constexpr auto EvaluationsCount{10000};
+
+	// Stands in for an input subgraph: outputs the reference pose with the given curves.
+
+	struct FCurvesNode : public FAnimNode_Base
+	{
+		TArray<TPair<FName, float>> Curves;
+
+		virtual void Evaluate_AnyThread(FPoseContext& Output) override
+		{
+			Output.ResetToRefPose();
+
+			for (const auto& Curve : Curves)
+			{
+				Output.Curve.Set(Curve.Key, Curve.Value);
+			}
+		}
+	};
+
+	USkeleton* CreateSkeleton()
+	{
+		auto* Skeleton{NewObject<USkeleton>()};
+
+		FReferenceSkeletonModifier ReferenceSkeletonModifier{Skeleton};
+
+		for (auto i{0}; i < BonesCount; i++)
+		{
+			const FName BoneName{*FString::Printf(TEXT("Bone%d"), i)};
+
+			ReferenceSkeletonModifier.Add({BoneName, BoneName.ToString(), i - 1}, FTransform{FVector{10.0f, 0.0f, 0.0f}});
+		}
+
+		return Skeleton;
+	}
+
+	double MeasureEvaluationTime(FAnimInstanceProxy& AnimInstanceProxy, FAlsAnimNode_CurvesBlend& Node, int32& OutputCurvesCount)
+	{
+		const auto Evaluate{
+			[&AnimInstanceProxy, &Node, &OutputCurvesCount]
+			{
+				FMemMark MemMark{FMemStack::Get()};
+
+				FPoseContext Output{&AnimInstanceProxy};
+				Node.Evaluate_AnyThread(Output);
+
+				OutputCurvesCount = Output.Curve.Num();
+			}
+		};
+
+		for (auto i{0}; i < WarmupEvaluationsCount; i++)
+		{
+			Evaluate();
+		}
+
+		const auto StartTime{FPlatformTime::Seconds()};
+
+		for (auto i{0}; i < EvaluationsCount; i++)
+		{
+			Evaluate();
+		}
+
+		return (FPlatformTime::Seconds() - StartTime) / EvaluationsCount;
+	}
+}
+
+bool FAlsAnimNodeCurvesBlendBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace AlsAnimNodeCurvesBlendTests;
+
+	auto* Skeleton{CreateSkeleton()};
+
+	TArray<FBoneIndexType> RequiredBoneIndices;
+	RequiredBoneIndices.Reserve(BonesCount);
+
+	for (auto i{0}; i < BonesCount; i++)
+	{
+		RequiredBoneIndices.Add(static_cast<FBoneIndexType>(i));
+	}
+
+	FAnimInstanceProxy AnimInstanceProxy;
+	AnimInstanceProxy.GetRequiredBones().InitializeTo(RequiredBoneIndices, UE::Anim::FCurveFilterSettings{}, *Skeleton);
+
+	if (!TestEqual(TEXT("Required bones count"), AnimInstanceProxy.GetRequiredBones().GetCompactPoseNumBones(), BonesCount))
+	{
+		return false;
+	}
+
+	// Half of the curves are shared between the poses, so that every blend mode has both matching and missing curves to handle.
+
+	FCurvesNode SourceNode;
+	FCurvesNode CurvesNode;
+
+	for (auto i{0}; i < CurvesCount; i++)
+	{
+		SourceNode.Curves.Emplace(*FString::Printf(TEXT("Curve%d"), i), 0.25f);
+		CurvesNode.Curves.Emplace(*FString::Printf(TEXT("Curve%d"), i + CurvesCount / 2), 0.75f);
+	}
+
+	FCurvesNode EmptyCurvesNode;
+
+	FAlsAnimNode_CurvesBlend Node;
+	Node.SourcePose.SetLinkNode(&SourceNode);
+
+	// Evaluating only the source pose is the baseline that the blend cost is compared against.
+
+	Node.BlendAmount = 0.0f;
+	Node.CurvesPose.SetLinkNode(&CurvesNode);
+
+	int32 OutputCurvesCount;
+	const auto BaselineTime{MeasureEvaluationTime(AnimInstanceProxy, Node, OutputCurvesCount)};
+
+	AddInfo(FString::Printf(TEXT("Source pose only: %.3f us per evaluation."), BaselineTime * 1000000.0));
+
+	Node.BlendAmount = 0.5f;
+
+	const auto* BlendModeEnum{StaticEnum<EAlsCurvesBlendMode>()};
+
+	for (auto i{0}; i < BlendModeEnum->NumEnums() - 1; i++)
+	{
+		Node.BlendMode = static_cast<EAlsCurvesBlendMode>(BlendModeEnum->GetValueByIndex(i));
+
+		const auto BlendModeName{AlsEnumUtility::GetNameStringByValue(Node.BlendMode)};
+
+		for (auto* LinkedNode : {&CurvesNode, &EmptyCurvesNode})
+		{
+			Node.CurvesPose.SetLinkNode(LinkedNode);
+
+			const auto Time{MeasureEvaluationTime(AnimInstanceProxy, Node, OutputCurvesCount)};
+
+			const auto Description{
+				FString::Printf(TEXT("%s with %s curves pose"), *BlendModeName,
+				                LinkedNode == &CurvesNode ? TEXT("a full") : TEXT("an empty"))
+			};
+
+			TestTrue(Description + TEXT(" outputs curves"), OutputCurvesCount > 0 || Node.BlendMode == EAlsCurvesBlendMode::Override);
+
+			AddInfo(FString::Printf(TEXT("%s: %.3f us per evaluation, %.3f us over the source pose only."), *Description,
+			                        Time * 1000000.0, (Time - BaselineTime) * 1000000.0));
+		}
+	}
+
+	return true;
+}
+
+#endif
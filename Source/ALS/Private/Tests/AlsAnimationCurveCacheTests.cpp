@@ -0,0 +1,123 @@
+#include "Algo/Reverse.h"
+#include "Misc/AutomationTest.h"
+#include "Utility/AlsAnimationCurveCache.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsAnimationCurveCacheParityTest, "Als.AnimationCurveCache.Parity",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace AlsAnimationCurveCacheTests
+{
+	static constexpr auto CachedCurvesCount{26};
+	static constexpr auto OtherCurvesCount{11};
+
+	FName GetCachedCurveName(const int32 Index)
+	{
+		return *FString::Printf(TEXT("CachedCurve%d"), Index);
+	}
+
+	FName GetOtherCurveName(const int32 Index)
+	{
+		return *FString::Printf(TEXT("OtherCurve%d"), Index);
+	}
+
+	// Refills the map the same way the animation instance proxy does every frame: reset without freeing memory, then add all curves in order.
+
+	void FillCurves(TMap<FName, float>& Curves, const TConstArrayView<FName> CurveNames, const int32 Frame)
+	{
+		Curves.Reset();
+
+		for (auto i{0}; i < CurveNames.Num(); i++)
+		{
+			Curves.Add(CurveNames[i], Frame * 100.0f + i + 1.0f);
+		}
+	}
+}
+
+bool FAlsAnimationCurveCacheParityTest::RunTest(const FString& Parameters)
+{
+	using namespace AlsAnimationCurveCacheTests;
+
+	TArray<FName> CachedCurveNames;
+	TArray<FName> OtherCurveNames;
+
+	for (auto i{0}; i < CachedCurvesCount; i++)
+	{
+		CachedCurveNames.Add(GetCachedCurveName(i));
+	}
+
+	for (auto i{0}; i < OtherCurvesCount; i++)
+	{
+		OtherCurveNames.Add(GetOtherCurveName(i));
+	}
+
+	const auto MakeFrame{
+		[&CachedCurveNames, &OtherCurveNames](const int32 FirstCachedCurve, const int32 CachedCurvesEnd, const bool bReverse)
+		{
+			TArray<FName> CurveNames;
+			CurveNames.Append(OtherCurveNames.GetData(), 5);
+
+			for (auto i{FirstCachedCurve}; i < CachedCurvesEnd; i++)
+			{
+				CurveNames.Add(CachedCurveNames[i]);
+			}
+
+			CurveNames.Append(OtherCurveNames.GetData() + 5, 5);
+
+			if (bReverse)
+			{
+				Algo::Reverse(CurveNames);
+			}
+
+			return CurveNames;
+		}
+	};
+
+	// Each frame changes the curve set in a different way: no change, curves removed, curves added,
+	// curves reordered without changing their count, and one curve replaced by another one.
+
+	TArray<TPair<FString, TArray<FName>>> Frames;
+	Frames.Emplace(TEXT("All curves"), MakeFrame(0, CachedCurvesCount, false));
+	Frames.Emplace(TEXT("Unchanged curves"), MakeFrame(0, CachedCurvesCount, false));
+	Frames.Emplace(TEXT("Half of the curves removed"), MakeFrame(0, CachedCurvesCount / 2, false));
+	Frames.Emplace(TEXT("Unchanged missing curves"), MakeFrame(0, CachedCurvesCount / 2, false));
+	Frames.Emplace(TEXT("Removed curves added back"), MakeFrame(0, CachedCurvesCount, false));
+	Frames.Emplace(TEXT("Reordered curves"), MakeFrame(0, CachedCurvesCount, true));
+
+	auto& ReplacedCurveFrame{Frames.Emplace_GetRef(TEXT("Curve replaced by another curve"), MakeFrame(0, CachedCurvesCount, true))};
+	ReplacedCurveFrame.Value.Remove(GetCachedCurveName(20));
+	ReplacedCurveFrame.Value.Add(OtherCurveNames.Last());
+
+	Frames.Emplace(TEXT("Replaced curve added back"), MakeFrame(0, CachedCurvesCount, true));
+	Frames.Emplace(TEXT("First curves removed"), MakeFrame(CachedCurvesCount / 2, CachedCurvesCount, false));
+	Frames.Emplace(TEXT("No curves"), TArray<FName>{});
+	Frames.Emplace(TEXT("All curves after no curves"), MakeFrame(0, CachedCurvesCount, false));
+
+	FAlsAnimationCurveCache CurveCache;
+	CurveCache.Initialize(CachedCurveNames);
+
+	TMap<FName, float> Curves;
+	float Values[CachedCurvesCount];
+
+	for (auto Frame{0}; Frame < Frames.Num(); Frame++)
+	{
+		FillCurves(Curves, Frames[Frame].Value, Frame);
+
+		CurveCache.GetCurveValues(Curves, MakeArrayView(Values));
+
+		for (auto i{0}; i < CachedCurvesCount; i++)
+		{
+			// Same as the lookup the animation instance performed for each curve before the cache was introduced.
+
+			const auto* ExpectedValue{Curves.Find(CachedCurveNames[i])};
+
+			TestEqual(FString::Printf(TEXT("%s: %s"), *Frames[Frame].Key, *CachedCurveNames[i].ToString()),
+			          Values[i], ExpectedValue != nullptr ? *ExpectedValue : 0.0f);
+		}
+	}
+
+	return true;
+}
+
+#endif
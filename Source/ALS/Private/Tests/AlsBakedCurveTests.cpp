@@ -0,0 +1,114 @@
+#include "Curves/RichCurve.h"
+#include "Misc/AutomationTest.h"
+#include "Utility/AlsBakedCurve.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsBakedCurveErrorBoundTest, "Als.BakedCurve.ErrorBound",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAlsBakedCurveErrorBoundTest::RunTest(const FString& Parameters)
+{
+	// Similar to the default gait amount to acceleration curve: flat while stopped, then a smooth rise up to sprinting.
+
+	FRichCurve Curve;
+	Curve.SetKeyInterpMode(Curve.AddKey(0.0f, 2000.0f), RCIM_Cubic);
+	Curve.SetKeyInterpMode(Curve.AddKey(1.0f, 1000.0f), RCIM_Cubic);
+	Curve.SetKeyInterpMode(Curve.AddKey(2.0f, 1500.0f), RCIM_Cubic);
+	Curve.SetKeyInterpMode(Curve.AddKey(3.0f, 800.0f), RCIM_Cubic);
+
+	FAlsBakedCurve BakedCurve;
+
+	if (!TestTrue(TEXT("Curve baked"), BakedCurve.Bake(Curve, 0.0f, 3.0f)))
+	{
+		return false;
+	}
+
+	float MinValue, MaxValue;
+	Curve.GetValueRange(MinValue, MaxValue);
+
+	const auto AllowedError{(MaxValue - MinValue) * FAlsBakedCurve::DefaultMaxRelativeError};
+
+	// Sample much more densely than baking does, including outside of the baked range where the table is clamped.
+
+	static constexpr auto TestSamplesCount{10000};
+
+	auto MaxError{0.0f};
+
+	for (auto i{0}; i <= TestSamplesCount; i++)
+	{
+		const auto Time{-0.5f + 4.0f * i / TestSamplesCount};
+		const auto ExpectedValue{Curve.Eval(FMath::Clamp(Time, 0.0f, 3.0f))};
+
+		MaxError = FMath::Max(MaxError, FMath::Abs(BakedCurve.Evaluate(Time) - ExpectedValue));
+	}
+
+	AddInfo(FString::Printf(TEXT("Max error: %f, allowed error: %f, error measured during baking: %f."),
+	                        MaxError, AllowedError, BakedCurve.GetMaxError()));
+
+	TestTrue(TEXT("Baked curve error is within the allowed error"), MaxError <= AllowedError);
+
+	// A curve with a sharp step can't be represented by the table and must be rejected.
+
+	FRichCurve SteppedCurve;
+	SteppedCurve.SetKeyInterpMode(SteppedCurve.AddKey(0.0f, 0.0f), RCIM_Constant);
+	SteppedCurve.SetKeyInterpMode(SteppedCurve.AddKey(1.51f, 1.0f), RCIM_Constant);
+
+	TestFalse(TEXT("Stepped curve baked"), BakedCurve.Bake(SteppedCurve, 0.0f, 3.0f));
+	TestFalse(TEXT("Stepped curve is marked as baked"), BakedCurve.IsBaked());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsBakedCurveKeyRangeTest, "Als.BakedCurve.KeyRange",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAlsBakedCurveKeyRangeTest::RunTest(const FString& Parameters)
+{
+	// Similar to the default stride blend amount curves, which are baked over the time range of their keys.
+
+	FRichCurve Curve;
+	Curve.SetKeyInterpMode(Curve.AddKey(0.0f, 0.2f), RCIM_Cubic);
+	Curve.SetKeyInterpMode(Curve.AddKey(150.0f, 1.0f), RCIM_Cubic);
+	Curve.SetKeyInterpMode(Curve.AddKey(350.0f, 0.6f), RCIM_Cubic);
+
+	FAlsBakedCurve BakedCurve;
+
+	if (!TestTrue(TEXT("Curve baked"), BakedCurve.Bake(Curve)))
+	{
+		return false;
+	}
+
+	float MinValue, MaxValue;
+	Curve.GetValueRange(MinValue, MaxValue);
+
+	const auto AllowedError{(MaxValue - MinValue) * FAlsBakedCurve::DefaultMaxRelativeError};
+
+	// The curve is extrapolated as a constant, so the clamped table must match it outside of the key range as well.
+
+	static constexpr auto TestSamplesCount{10000};
+
+	auto MaxError{0.0f};
+
+	for (auto i{0}; i <= TestSamplesCount; i++)
+	{
+		const auto Time{-100.0f + 550.0f * i / TestSamplesCount};
+
+		MaxError = FMath::Max(MaxError, FMath::Abs(BakedCurve.Evaluate(Time) - Curve.Eval(Time)));
+	}
+
+	AddInfo(FString::Printf(TEXT("Max error: %f, allowed error: %f."), MaxError, AllowedError));
+
+	TestTrue(TEXT("Baked curve error is within the allowed error"), MaxError <= AllowedError);
+
+	// A linearly extrapolated curve keeps changing outside of the key range, where the table is clamped, so it must be rejected.
+
+	Curve.PostInfinityExtrap = RCCE_Linear;
+
+	TestFalse(TEXT("Linearly extrapolated curve baked"), BakedCurve.Bake(Curve));
+	TestFalse(TEXT("Linearly extrapolated curve is marked as baked"), BakedCurve.IsBaked());
+
+	return true;
+}
+
+#endif
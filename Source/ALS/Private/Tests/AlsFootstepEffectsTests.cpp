@@ -0,0 +1,137 @@
+#include "AlsFootstepEffectsSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/AutomationTest.h"
+#include "Notifies/AlsAnimNotify_FootstepEffects.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsFootstepEffectsNotifiesTest, "Als.FootstepEffects.Notifies",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace AlsFootstepEffectsTests
+{
+	static constexpr auto NotifiesCount{10000};
+
+	static const TCHAR* DecalMaterialPath{TEXT("/Engine/EngineMaterials/DefaultDeferredDecalMaterial.DefaultDeferredDecalMaterial")};
+
+	UAlsFootstepEffectsSettings* CreateSettings()
+	{
+		auto* Settings{NewObject<UAlsFootstepEffectsSettings>()};
+
+		// Only the decal is set, since sounds and particle systems don't leave anything behind that could be counted.
+
+		auto& EffectSettings{Settings->Effects.Add(SurfaceType_Default)};
+		EffectSettings.Decal.DecalMaterial = TSoftObjectPtr<UMaterialInterface>{FSoftObjectPath{DecalMaterialPath}};
+
+		return Settings;
+	}
+
+	UAlsAnimNotify_FootstepEffects* CreateNotify(UAlsFootstepEffectsSettings* Settings)
+	{
+		auto* Notify{NewObject<UAlsAnimNotify_FootstepEffects>()};
+
+		// The settings are only editable in the editor, so set them through reflection.
+
+		const auto* SettingsProperty{
+			CastField<FObjectProperty>(UAlsAnimNotify_FootstepEffects::StaticClass()->FindPropertyByName(TEXT("FootstepEffectsSettings")))
+		};
+
+		if (SettingsProperty != nullptr)
+		{
+			SettingsProperty->SetObjectPropertyValue_InContainer(Notify, Settings);
+		}
+
+		return Notify;
+	}
+}
+
+bool FAlsFootstepEffectsNotifiesTest::RunTest(const FString& Parameters)
+{
+	using namespace AlsFootstepEffectsTests;
+
+	auto* World{UWorld::CreateWorld(EWorldType::Game, false, TEXT("AlsFootstepEffectsTest"))};
+
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	auto* EffectsSubsystem{World->GetSubsystem<UAlsFootstepEffectsSubsystem>()};
+	if (!TestNotNull(TEXT("Footstep effects subsystem"), EffectsSubsystem))
+	{
+		return false;
+	}
+
+	// The box mesh is 100 units in size, so the top of the floor is at zero height.
+
+	auto* Floor{World->SpawnActor<AStaticMeshActor>(FVector{0.0f, 0.0f, -50.0f}, FRotator::ZeroRotator)};
+	Floor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+	Floor->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+	Floor->GetStaticMeshComponent()->SetWorldScale3D({10.0f, 10.0f, 1.0f});
+
+	// Without a skeletal mesh, the foot transform is the component transform. The pitch makes the X axis, which is
+	// the left foot's Z axis by default, point up, so that the surface trace goes down and decals pass the angle check.
+
+	auto* MeshActor{World->SpawnActor<AActor>(FVector{0.0f, 0.0f, 10.0f}, FRotator::ZeroRotator)};
+
+	auto* Mesh{NewObject<USkeletalMeshComponent>(MeshActor)};
+	MeshActor->SetRootComponent(Mesh);
+	Mesh->SetWorldLocationAndRotation(FVector{0.0f, 0.0f, 10.0f}, FRotator{90.0f, 0.0f, 0.0f});
+	Mesh->RegisterComponent();
+
+	auto SyncLoadsCount{0};
+
+	const auto SyncLoadHandle{
+		FCoreUObjectDelegates::OnSyncLoadPackage.AddLambda([&SyncLoadsCount](const FString&)
+		{
+			SyncLoadsCount += 1;
+		})
+	};
+
+	ON_SCOPE_EXIT
+	{
+		FCoreUObjectDelegates::OnSyncLoadPackage.Remove(SyncLoadHandle);
+	};
+
+	// Effects that nothing has preloaded yet still play on their first footstep.
+
+	auto* NotPreloadedNotify{CreateNotify(CreateSettings())};
+	NotPreloadedNotify->Notify(Mesh, nullptr, {});
+
+	TestEqual(TEXT("Decals after the first footstep of effects that were not preloaded"), EffectsSubsystem->GetDecalsCount(), 1);
+
+	// Preloaded effects never load anything synchronously, no matter how many footsteps there are.
+
+	auto* Settings{CreateSettings()};
+	EffectsSubsystem->PreloadEffects(Settings);
+
+	FlushAsyncLoading();
+
+	SyncLoadsCount = 0;
+
+	auto* Notify{CreateNotify(Settings)};
+
+	for (auto i{0}; i < NotifiesCount; i++)
+	{
+		Notify->Notify(Mesh, nullptr, {});
+	}
+
+	TestEqual(TEXT("Synchronous loads"), SyncLoadsCount, 0);
+
+	const auto* MaxDecalsConsoleVariable{IConsoleManager::Get().FindConsoleVariable(TEXT("Als.FootstepEffects.MaxDecals"))};
+	const auto MaxDecals{MaxDecalsConsoleVariable != nullptr ? FMath::Max(1, MaxDecalsConsoleVariable->GetInt()) : 1};
+
+	// Each footstep spawns a decal, so the pool fills up, but never grows past its limit.
+
+	TestEqual(TEXT("Decals count"), EffectsSubsystem->GetDecalsCount(), MaxDecals);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "Misc/AutomationTest.h"
+#include "Settings/AlsMovementSettings.h"
+#include "Utility/AlsTagIndexRegistry.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsMovementSettingsGaitSettingsParityTest, "Als.MovementSettings.GaitSettingsParity",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAlsMovementSettingsGaitSettingsParityTest::RunTest(const FString& Parameters)
+{
+	auto* MovementSettings{NewObject<UAlsMovementSettings>()};
+
+	// Tags outside of the rotation mode and stance families stand in for project-specific ones, which are never compiled.
+
+	const auto CustomRotationMode{AlsGaitTags::Walking};
+	const auto CustomStance{AlsOverlayModeTags::Default};
+
+	MovementSettings->RotationModes.FindOrAdd(CustomRotationMode).Stances.Add(CustomStance);
+	MovementSettings->RotationModes.FindOrAdd(AlsRotationModeTags::ViewDirection).Stances.Add(CustomStance);
+	MovementSettings->RotationModes.FindOrAdd(CustomRotationMode).Stances.Add(AlsStanceTags::Crouching);
+	MovementSettings->RotationModes.FindOrAdd(AlsRotationModeTags::Aiming).Stances.Remove(AlsStanceTags::Crouching);
+
+	// Make every combination distinguishable.
+
+	auto Speed{100.0f};
+
+	for (auto& StanceSettings : MovementSettings->RotationModes)
+	{
+		for (auto& GaitSettings : StanceSettings.Value.Stances)
+		{
+			GaitSettings.Value.WalkForwardSpeed = Speed;
+			Speed += 10.0f;
+		}
+	}
+
+	MovementSettings->CompileGaitSettings();
+
+	TArray<FGameplayTag> RotationModes{AlsTagIndexRegistry::GetFamilyTags(EAlsTagFamily::RotationMode)};
+	RotationModes.Add(CustomRotationMode);
+	RotationModes.Add(FGameplayTag::EmptyTag);
+
+	TArray<FGameplayTag> Stances{AlsTagIndexRegistry::GetFamilyTags(EAlsTagFamily::Stance)};
+	Stances.Add(CustomStance);
+	Stances.Add(FGameplayTag::EmptyTag);
+
+	for (const auto& RotationMode : RotationModes)
+	{
+		for (const auto& Stance : Stances)
+		{
+			const auto* StanceSettings{MovementSettings->RotationModes.Find(RotationMode)};
+			const auto* ExpectedGaitSettings{StanceSettings != nullptr ? StanceSettings->Stances.Find(Stance) : nullptr};
+
+			const auto* GaitSettings{MovementSettings->FindGaitSettings(RotationMode, Stance)};
+
+			const auto Description{FString::Printf(TEXT("Gait settings of %s and %s"), *RotationMode.ToString(), *Stance.ToString())};
+
+			if (ExpectedGaitSettings == nullptr || GaitSettings == nullptr)
+			{
+				TestTrue(Description + TEXT(" are found by both lookups or by neither"), ExpectedGaitSettings == GaitSettings);
+				continue;
+			}
+
+			TestTrue(Description + TEXT(" are equal"), FAlsMovementGaitSettings::StaticStruct()->CompareScriptStruct(
+				         GaitSettings, ExpectedGaitSettings, PPF_None));
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,146 @@
+#include "AlsCharacterMovementComponent.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/CoreNet.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsNetworkMoveDataRoundTripTest, "Als.NetworkMoveData.RoundTrip",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace AlsNetworkMoveDataTests
+{
+	FAlsCharacterNetworkMoveDataContainer& GetMoveDataContainer(UAlsCharacterMovementComponent& Movement)
+	{
+		return static_cast<FAlsCharacterNetworkMoveDataContainer&>(Movement.GetNetworkMoveDataContainer());
+	}
+
+	void FillMoveData(FAlsCharacterNetworkMoveData& MoveData, const float TimeStamp, const FGameplayTag& RotationMode,
+	                  const FGameplayTag& Stance, const FGameplayTag& MaxAllowedGait)
+	{
+		MoveData.TimeStamp = TimeStamp;
+		MoveData.Acceleration = {1000.0f, 500.0f, 0.0f};
+		MoveData.Location = {1234.56f, -789.01f, 92.15f};
+		MoveData.ControlRotation = {-10.0f, 135.0f, 0.0f};
+
+		MoveData.RotationMode = RotationMode;
+		MoveData.Stance = Stance;
+		MoveData.MaxAllowedGait = MaxAllowedGait;
+	}
+
+	// The format used before the tags were packed: each tag is sent in full unless it matches its default value.
+
+	struct FUnpackedMoveData : public FAlsCharacterNetworkMoveData
+	{
+		explicit FUnpackedMoveData(const FAlsCharacterNetworkMoveData& MoveData)
+			: FAlsCharacterNetworkMoveData{MoveData} {}
+
+		virtual bool Serialize(UCharacterMovementComponent& Movement, FArchive& Archive,
+		                       UPackageMap* Map, const ENetworkMoveType MoveType) override
+		{
+			FCharacterNetworkMoveData::Serialize(Movement, Archive, Map, MoveType);
+
+			NetSerializeOptionalValue(Archive.IsSaving(), Archive, RotationMode, AlsRotationModeTags::ViewDirection.GetTag(), Map);
+			NetSerializeOptionalValue(Archive.IsSaving(), Archive, Stance, AlsStanceTags::Standing.GetTag(), Map);
+			NetSerializeOptionalValue(Archive.IsSaving(), Archive, MaxAllowedGait, AlsGaitTags::Running.GetTag(), Map);
+
+			return !Archive.IsError();
+		}
+	};
+}
+
+bool FAlsNetworkMoveDataRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace AlsNetworkMoveDataTests;
+
+	// Moves are serialized the same way the character movement component does it when sending a
+	// packed server move: the new move first, then the pending and old moves that are delta encoded against it.
+
+	auto* SendingMovement{NewObject<UAlsCharacterMovementComponent>(GetTransientPackage())};
+	auto* ReceivingMovement{NewObject<UAlsCharacterMovementComponent>(GetTransientPackage())};
+
+	auto& SentMoveData{GetMoveDataContainer(*SendingMovement).MoveData};
+	auto& ReceivedMoveData{GetMoveDataContainer(*ReceivingMovement).MoveData};
+
+	FillMoveData(SentMoveData[0], 3.0f, AlsRotationModeTags::Aiming, AlsStanceTags::Crouching, AlsGaitTags::Walking);
+
+	// Same tags as the new move.
+	FillMoveData(SentMoveData[1], 2.0f, AlsRotationModeTags::Aiming, AlsStanceTags::Crouching, AlsGaitTags::Walking);
+
+	// Different stance and gait.
+	FillMoveData(SentMoveData[2], 1.0f, AlsRotationModeTags::Aiming, AlsStanceTags::Standing, AlsGaitTags::Sprinting);
+
+	static constexpr ENetworkMoveType MoveTypes[]{
+		ENetworkMoveType::NewMove, ENetworkMoveType::PendingMove, ENetworkMoveType::OldMove
+	};
+
+	FNetBitWriter Writer{4096};
+	TStaticArray<int64, 3> MoveBitsCounts;
+
+	FNetBitWriter UnpackedWriter{4096};
+	TStaticArray<int64, 3> UnpackedMoveBitsCounts;
+
+	for (auto i{0}; i < SentMoveData.Num(); i++)
+	{
+		const auto StartBitsCount{Writer.GetNumBits()};
+
+		SentMoveData[i].Serialize(*SendingMovement, Writer, nullptr, MoveTypes[i]);
+
+		MoveBitsCounts[i] = Writer.GetNumBits() - StartBitsCount;
+
+		const auto UnpackedStartBitsCount{UnpackedWriter.GetNumBits()};
+
+		FUnpackedMoveData UnpackedMoveData{SentMoveData[i]};
+		UnpackedMoveData.Serialize(*SendingMovement, UnpackedWriter, nullptr, MoveTypes[i]);
+
+		UnpackedMoveBitsCounts[i] = UnpackedWriter.GetNumBits() - UnpackedStartBitsCount;
+	}
+
+	if (!TestFalse(TEXT("Writer error"), Writer.IsError()))
+	{
+		return false;
+	}
+
+	FNetBitReader Reader{nullptr, Writer.GetData(), Writer.GetNumBits()};
+
+	for (auto i{0}; i < ReceivedMoveData.Num(); i++)
+	{
+		ReceivedMoveData[i].Serialize(*ReceivingMovement, Reader, nullptr, MoveTypes[i]);
+	}
+
+	if (!TestFalse(TEXT("Reader error"), Reader.IsError()) ||
+	    !TestTrue(TEXT("All bits read"), Reader.AtEnd()))
+	{
+		return false;
+	}
+
+	for (auto i{0}; i < SentMoveData.Num(); i++)
+	{
+		const auto& Sent{SentMoveData[i]};
+		const auto& Received{ReceivedMoveData[i]};
+
+		const auto Description{FString::Printf(TEXT("Move %d"), i)};
+
+		TestEqual(Description + TEXT(" time stamp"), Received.TimeStamp, Sent.TimeStamp);
+		TestEqual(Description + TEXT(" rotation mode"), Received.RotationMode, Sent.RotationMode);
+		TestEqual(Description + TEXT(" stance"), Received.Stance, Sent.Stance);
+		TestEqual(Description + TEXT(" max allowed gait"), Received.MaxAllowedGait, Sent.MaxAllowedGait);
+
+		AddInfo(FString::Printf(TEXT("%s: %lld bits, previously %lld bits."),
+		                        *Description, MoveBitsCounts[i], UnpackedMoveBitsCounts[i]));
+
+		TestTrue(Description + TEXT(" is smaller than unpacked move"), MoveBitsCounts[i] < UnpackedMoveBitsCounts[i]);
+	}
+
+	// Unchanged fields of the pending move cost only the changed field mask.
+
+	TestTrue(TEXT("Pending move is smaller than old move"), MoveBitsCounts[1] < MoveBitsCounts[2]);
+
+	AddInfo(FString::Printf(TEXT("Packet: %lld bits, previously %lld bits."), Writer.GetNumBits(), UnpackedWriter.GetNumBits()));
+
+	TestTrue(TEXT("Packet is smaller than unpacked packet"), Writer.GetNumBits() < UnpackedWriter.GetNumBits());
+
+	return true;
+}
+
+#endif
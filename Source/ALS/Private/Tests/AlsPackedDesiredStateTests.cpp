@@ -0,0 +1,219 @@
+#include "Misc/AutomationTest.h"
+#include "State/AlsPackedDesiredState.h"
+#include "UObject/CoreNet.h"
+#include "Utility/AlsGameplayTags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsPackedDesiredStateBandwidthTest, "Als.PackedDesiredState.Bandwidth",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace AlsPackedDesiredStateTests
+{
+	struct FFrame
+	{
+		const TCHAR* Description{nullptr};
+
+		FAlsPackedDesiredState State;
+	};
+
+	FFrame MakeFrame(const TCHAR* Description, const EAlsDesiredStateFields ChangedFields, const FGameplayTag& ViewMode = {},
+	                 const FGameplayTag& OverlayMode = {}, const bool bDesiredAiming = false,
+	                 const FGameplayTag& DesiredRotationMode = {}, const FGameplayTag& DesiredStance = {},
+	                 const FGameplayTag& DesiredGait = {})
+	{
+		FFrame Frame;
+		Frame.Description = Description;
+
+		Frame.State.ChangedFields = ChangedFields;
+		Frame.State.ViewMode = ViewMode;
+		Frame.State.OverlayMode = OverlayMode;
+		Frame.State.bDesiredAiming = bDesiredAiming;
+		Frame.State.DesiredRotationMode = DesiredRotationMode;
+		Frame.State.DesiredStance = DesiredStance;
+		Frame.State.DesiredGait = DesiredGait;
+
+		return Frame;
+	}
+
+	int64 SerializeTag(FNetBitWriter& Writer, FGameplayTag Tag)
+	{
+		const auto StartBitsCount{Writer.GetNumBits()};
+
+		auto bSuccess{true};
+		Tag.NetSerialize(Writer, nullptr, bSuccess);
+
+		return Writer.GetNumBits() - StartBitsCount;
+	}
+
+	// Before the desired state was packed, each setter sent its own reliable RPC with a full gameplay tag
+	// (or a bool for aiming) as the only parameter. Returns the total size of these parameters.
+	int64 CalculateUnpackedBitsCount(const FAlsPackedDesiredState& State, int32& RpcsCount)
+	{
+		FNetBitWriter Writer{4096};
+		auto BitsCount{0ll};
+
+		if (EnumHasAnyFlags(State.ChangedFields, EAlsDesiredStateFields::ViewMode))
+		{
+			BitsCount += SerializeTag(Writer, State.ViewMode);
+			RpcsCount += 1;
+		}
+
+		if (EnumHasAnyFlags(State.ChangedFields, EAlsDesiredStateFields::OverlayMode))
+		{
+			BitsCount += SerializeTag(Writer, State.OverlayMode);
+			RpcsCount += 1;
+		}
+
+		if (EnumHasAnyFlags(State.ChangedFields, EAlsDesiredStateFields::DesiredAiming))
+		{
+			BitsCount += 1;
+			RpcsCount += 1;
+		}
+
+		if (EnumHasAnyFlags(State.ChangedFields, EAlsDesiredStateFields::DesiredRotationMode))
+		{
+			BitsCount += SerializeTag(Writer, State.DesiredRotationMode);
+			RpcsCount += 1;
+		}
+
+		if (EnumHasAnyFlags(State.ChangedFields, EAlsDesiredStateFields::DesiredStance))
+		{
+			BitsCount += SerializeTag(Writer, State.DesiredStance);
+			RpcsCount += 1;
+		}
+
+		if (EnumHasAnyFlags(State.ChangedFields, EAlsDesiredStateFields::DesiredGait))
+		{
+			BitsCount += SerializeTag(Writer, State.DesiredGait);
+			RpcsCount += 1;
+		}
+
+		return BitsCount;
+	}
+}
+
+bool FAlsPackedDesiredStateBandwidthTest::RunTest(const FString& Parameters)
+{
+	using namespace AlsPackedDesiredStateTests;
+
+	// A scripted input session, one entry per frame in which at least one desired state setter was called.
+
+	const FFrame Frames[]{
+		MakeFrame(TEXT("Start sprinting"), EAlsDesiredStateFields::DesiredGait,
+		          {}, {}, false, {}, {}, AlsGaitTags::Sprinting),
+		MakeFrame(TEXT("Stop sprinting"), EAlsDesiredStateFields::DesiredGait,
+		          {}, {}, false, {}, {}, AlsGaitTags::Running),
+		MakeFrame(TEXT("Start aiming"), EAlsDesiredStateFields::DesiredAiming,
+		          {}, {}, true),
+		MakeFrame(TEXT("Crouch"), EAlsDesiredStateFields::DesiredStance,
+		          {}, {}, false, {}, AlsStanceTags::Crouching),
+		MakeFrame(TEXT("Equip rifle"), EAlsDesiredStateFields::OverlayMode | EAlsDesiredStateFields::DesiredRotationMode,
+		          {}, AlsOverlayModeTags::Rifle, false, AlsRotationModeTags::ViewDirection),
+		MakeFrame(TEXT("Stand up, walk and stop aiming"),
+		          EAlsDesiredStateFields::DesiredStance | EAlsDesiredStateFields::DesiredGait |
+		          EAlsDesiredStateFields::DesiredAiming,
+		          {}, {}, false, {}, AlsStanceTags::Standing, AlsGaitTags::Walking),
+		MakeFrame(TEXT("Switch to first person"), EAlsDesiredStateFields::ViewMode,
+		          AlsViewModeTags::FirstPerson),
+		MakeFrame(TEXT("Custom overlay mode"), EAlsDesiredStateFields::OverlayMode,
+		          {}, AlsLocomotionModeTags::Grounded),
+		MakeFrame(TEXT("Reset everything"), EAlsDesiredStateFields::All,
+		          AlsViewModeTags::ThirdPerson, AlsOverlayModeTags::Default, false,
+		          AlsRotationModeTags::VelocityDirection, AlsStanceTags::Standing, AlsGaitTags::Running)
+	};
+
+	const auto PackedRpcsCount{static_cast<int32>(UE_ARRAY_COUNT(Frames))};
+
+	auto PackedBitsCount{0ll};
+	auto UnpackedBitsCount{0ll};
+	auto UnpackedRpcsCount{0};
+
+	for (const auto& Frame : Frames)
+	{
+		FNetBitWriter Writer{4096};
+
+		auto SentState{Frame.State};
+		auto bSuccess{true};
+		SentState.NetSerialize(Writer, nullptr, bSuccess);
+
+		if (!TestTrue(FString::Printf(TEXT("%s: serialized"), Frame.Description), bSuccess && !Writer.IsError()))
+		{
+			return false;
+		}
+
+		FNetBitReader Reader{nullptr, Writer.GetData(), Writer.GetNumBits()};
+
+		FAlsPackedDesiredState ReceivedState;
+		ReceivedState.NetSerialize(Reader, nullptr, bSuccess);
+
+		if (!TestTrue(FString::Printf(TEXT("%s: deserialized"), Frame.Description),
+		              bSuccess && !Reader.IsError() && Reader.AtEnd()))
+		{
+			return false;
+		}
+
+		TestTrue(FString::Printf(TEXT("%s: changed fields"), Frame.Description),
+		         ReceivedState.ChangedFields == SentState.ChangedFields);
+
+		if (EnumHasAnyFlags(SentState.ChangedFields, EAlsDesiredStateFields::ViewMode))
+		{
+			TestEqual(FString::Printf(TEXT("%s: view mode"), Frame.Description), ReceivedState.ViewMode, SentState.ViewMode);
+		}
+
+		if (EnumHasAnyFlags(SentState.ChangedFields, EAlsDesiredStateFields::OverlayMode))
+		{
+			TestEqual(FString::Printf(TEXT("%s: overlay mode"), Frame.Description),
+			          ReceivedState.OverlayMode, SentState.OverlayMode);
+		}
+
+		if (EnumHasAnyFlags(SentState.ChangedFields, EAlsDesiredStateFields::DesiredAiming))
+		{
+			TestEqual(FString::Printf(TEXT("%s: desired aiming"), Frame.Description),
+			          static_cast<bool>(ReceivedState.bDesiredAiming), static_cast<bool>(SentState.bDesiredAiming));
+		}
+
+		if (EnumHasAnyFlags(SentState.ChangedFields, EAlsDesiredStateFields::DesiredRotationMode))
+		{
+			TestEqual(FString::Printf(TEXT("%s: desired rotation mode"), Frame.Description),
+			          ReceivedState.DesiredRotationMode, SentState.DesiredRotationMode);
+		}
+
+		if (EnumHasAnyFlags(SentState.ChangedFields, EAlsDesiredStateFields::DesiredStance))
+		{
+			TestEqual(FString::Printf(TEXT("%s: desired stance"), Frame.Description),
+			          ReceivedState.DesiredStance, SentState.DesiredStance);
+		}
+
+		if (EnumHasAnyFlags(SentState.ChangedFields, EAlsDesiredStateFields::DesiredGait))
+		{
+			TestEqual(FString::Printf(TEXT("%s: desired gait"), Frame.Description),
+			          ReceivedState.DesiredGait, SentState.DesiredGait);
+		}
+
+		const auto FramePackedBitsCount{Writer.GetNumBits()};
+
+		auto FrameUnpackedRpcsCount{0};
+		const auto FrameUnpackedBitsCount{CalculateUnpackedBitsCount(SentState, FrameUnpackedRpcsCount)};
+
+		AddInfo(FString::Printf(TEXT("%s: %lld bits in 1 RPC, previously %lld bits in %d RPCs."),
+		                        Frame.Description, FramePackedBitsCount, FrameUnpackedBitsCount, FrameUnpackedRpcsCount));
+
+		PackedBitsCount += FramePackedBitsCount;
+		UnpackedBitsCount += FrameUnpackedBitsCount;
+		UnpackedRpcsCount += FrameUnpackedRpcsCount;
+	}
+
+	// Only the RPC parameters are compared here. Every RPC additionally costs its own bunch header, so
+	// sending fewer RPCs saves even more bandwidth than these numbers show.
+
+	AddInfo(FString::Printf(TEXT("Total: %lld bits in %d RPCs, previously %lld bits in %d RPCs."),
+	                        PackedBitsCount, PackedRpcsCount, UnpackedBitsCount, UnpackedRpcsCount));
+
+	TestTrue(TEXT("Packed desired state is smaller"), PackedBitsCount < UnpackedBitsCount);
+	TestTrue(TEXT("Packed desired state sends fewer RPCs"), PackedRpcsCount < UnpackedRpcsCount);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include "Misc/AutomationTest.h"
+#include "Nodes/AlsRigUnit_ChainLength.h"
+#include "Rigs/RigHierarchy.h"
+#include "Rigs/RigHierarchyController.h"
+#include "Units/RigUnitContext.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsRigUnitChainLengthCachedChainTest, "Als.RigUnit.ChainLength.CachedChain",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAlsRigUnitChainLengthCachedChainTest::RunTest(const FString& Parameters)
+{
+	static constexpr auto EvaluationsCount{1000};
+	static constexpr auto SegmentLength{10.0f};
+
+	auto* Hierarchy{NewObject<URigHierarchy>()};
+	auto* Controller{Hierarchy->GetController(true)};
+
+	// A straight chain of bones along the X axis: Root -> Bone1 -> Bone2 -> Bone3.
+
+	FRigElementKey ParentKey;
+	TArray<FRigElementKey, TInlineAllocator<4>> BoneKeys;
+
+	for (auto i{0}; i < 4; i++)
+	{
+		ParentKey = Controller->AddBone(*FString::Printf(TEXT("Bone%d"), i), ParentKey,
+		                                FTransform{FVector{SegmentLength * i, 0.0f, 0.0f}}, true, ERigBoneType::User, false);
+		BoneKeys.Add(ParentKey);
+	}
+
+	FControlRigExecuteContext ExecuteContext;
+	ExecuteContext.Hierarchy = Hierarchy;
+
+	FAlsRigUnit_ChainLength Unit;
+	Unit.AncestorItem = BoneKeys[0];
+	Unit.DescendantItem = BoneKeys.Last();
+
+	Unit.Execute(ExecuteContext);
+
+	if (!TestEqual(TEXT("Chain elements count"), Unit.CachedChainElementIndices.Num(), BoneKeys.Num()) ||
+	    !TestEqual(TEXT("Chain length"), Unit.Length, SegmentLength * 3.0f))
+	{
+		return false;
+	}
+
+	// Swapping the ancestor and descendant items resolves the same chain from the other end.
+
+	Unit.AncestorItem = BoneKeys.Last();
+	Unit.DescendantItem = BoneKeys[0];
+
+	Unit.Execute(ExecuteContext);
+
+	TestEqual(TEXT("Reversed chain length"), Unit.Length, SegmentLength * 3.0f);
+
+	// The chain is resolved only in the rebuild path, which is also the only place where the unit allocates memory. To tell
+	// a rebuild apart from a cache hit, truncate the cached chain to its first segment: as long as the cache is used, every
+	// evaluation returns the length of that segment instead of the full chain, and the cached array is never reallocated.
+
+	Unit.CachedChainElementIndices.SetNum(2, EAllowShrinking::No);
+
+	const auto* ChainElementIndicesData{Unit.CachedChainElementIndices.GetData()};
+	const auto ChainElementIndicesMax{Unit.CachedChainElementIndices.Max()};
+	const auto TopologyVersion{Hierarchy->GetTopologyVersion()};
+
+	auto CacheHitsCount{0};
+
+	for (auto i{0}; i < EvaluationsCount; i++)
+	{
+		Unit.Execute(ExecuteContext);
+
+		if (FMath::IsNearlyEqual(Unit.Length, SegmentLength))
+		{
+			CacheHitsCount += 1;
+		}
+	}
+
+	TestEqual(TEXT("Evaluations that reused the cached chain"), CacheHitsCount, EvaluationsCount);
+	TestEqual(TEXT("Cached chain topology version"), Unit.CachedChainTopologyVersion, TopologyVersion);
+	TestTrue(TEXT("Cached chain was not reallocated"), Unit.CachedChainElementIndices.GetData() == ChainElementIndicesData &&
+	                                                   Unit.CachedChainElementIndices.Max() == ChainElementIndicesMax);
+
+	// Any topology change, even one outside of the chain, resolves the chain again.
+
+	Controller->AddBone(TEXT("Unrelated"), FRigElementKey{}, FTransform::Identity, true, ERigBoneType::User, false);
+
+	Unit.Execute(ExecuteContext);
+
+	TestNotEqual(TEXT("Topology version"), Hierarchy->GetTopologyVersion(), TopologyVersion);
+	TestEqual(TEXT("Chain length after topology change"), Unit.Length, SegmentLength * 3.0f);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,108 @@
+#include "AlsCharacterMovementComponent.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsSavedMovePoolAllocationsTest, "Als.SavedMovePool.Allocations",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace AlsSavedMovePoolTests
+{
+	static constexpr auto MovesCount{10000};
+
+	// Moves saved before the pool reaches its steady state.
+	static constexpr auto WarmUpMovesCount{100};
+
+	// About 100 ms of round-trip time at 120 frames per second.
+	static constexpr auto InFlightMovesCount{12};
+
+	// A lag spike every few seconds, during which the server doesn't acknowledge any moves.
+	static constexpr auto LagSpikeInterval{1000};
+	static constexpr auto LagSpikeMovesCount{60};
+
+	bool IsInLagSpike(const int32 MoveIndex)
+	{
+		return MoveIndex >= WarmUpMovesCount && MoveIndex % LagSpikeInterval < LagSpikeMovesCount;
+	}
+}
+
+bool FAlsSavedMovePoolAllocationsTest::RunTest(const FString& Parameters)
+{
+	using namespace AlsSavedMovePoolTests;
+
+	// Saved moves are created and freed the same way the client does it: each frame a move is saved,
+	// and the oldest moves are freed once the server acknowledges them. Every heap allocation of a
+	// saved move goes through FAlsNetworkPredictionData::AllocateNewMove(), which counts the allocations
+	// made after the pool was filled. Growth of the containers themselves is checked separately.
+
+	const auto* Movement{NewObject<UAlsCharacterMovementComponent>(GetTransientPackage())};
+
+	FAlsNetworkPredictionData PredictionData{*Movement};
+
+	if (!TestTrue(TEXT("Lag spikes fit into the pool"), InFlightMovesCount + LagSpikeMovesCount <= PredictionData.MaxFreeMoveCount &&
+	                                                     InFlightMovesCount + LagSpikeMovesCount < PredictionData.MaxSavedMoveCount))
+	{
+		return false;
+	}
+
+	SIZE_T SavedMovesAllocatedSize{0};
+	SIZE_T FreeMovesAllocatedSize{0};
+
+	for (auto i{0}; i < MovesCount; i++)
+	{
+		if (i == WarmUpMovesCount)
+		{
+			TestEqual(TEXT("Warm-up overflow saved moves"), PredictionData.GetOverflowSavedMovesCount(), 0);
+
+			SavedMovesAllocatedSize = PredictionData.SavedMoves.GetAllocatedSize();
+			FreeMovesAllocatedSize = PredictionData.FreeMoves.GetAllocatedSize();
+		}
+
+		auto NewMove{PredictionData.CreateSavedMove()};
+		if (!TestTrue(FString::Printf(TEXT("Move %d created"), i), NewMove.IsValid()))
+		{
+			return false;
+		}
+
+		PredictionData.SavedMoves.Push(MoveTemp(NewMove));
+
+		if (!IsInLagSpike(i))
+		{
+			while (PredictionData.SavedMoves.Num() > InFlightMovesCount)
+			{
+				PredictionData.FreeMove(PredictionData.SavedMoves[0]);
+				PredictionData.SavedMoves.RemoveAt(0, 1, EAllowShrinking::No);
+			}
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("Moves: %d, overflow saved moves: %d, pool size: %d."),
+	                        MovesCount, PredictionData.GetOverflowSavedMovesCount(), PredictionData.MaxFreeMoveCount));
+
+	TestEqual(TEXT("Overflow saved moves"), PredictionData.GetOverflowSavedMovesCount(), 0);
+	TestTrue(TEXT("Saved moves weren't reallocated"), PredictionData.SavedMoves.GetAllocatedSize() == SavedMovesAllocatedSize);
+	TestTrue(TEXT("Free moves weren't reallocated"), PredictionData.FreeMoves.GetAllocatedSize() == FreeMovesAllocatedSize);
+
+	// Once more moves are in flight than the pool holds, the additional moves are allocated and counted.
+
+	static constexpr auto SmallPoolSize{8};
+	static constexpr auto SmallPoolMovesCount{32};
+
+	FAlsNetworkPredictionData SmallPoolPredictionData{*Movement};
+	SmallPoolPredictionData.MaxFreeMoveCount = SmallPoolSize;
+
+	for (auto i{0}; i < SmallPoolMovesCount; i++)
+	{
+		SmallPoolPredictionData.SavedMoves.Push(SmallPoolPredictionData.CreateSavedMove());
+	}
+
+	// The first allocation fills the pool and returns one more move.
+
+	TestEqual(TEXT("Small pool overflow saved moves"),
+	          SmallPoolPredictionData.GetOverflowSavedMovesCount(), SmallPoolMovesCount - SmallPoolSize - 1);
+
+	return true;
+}
+
+#endif
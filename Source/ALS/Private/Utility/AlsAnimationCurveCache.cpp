@@ -0,0 +1,79 @@
+#include "Utility/AlsAnimationCurveCache.h"
+
+void FAlsAnimationCurveCache::Initialize(const TConstArrayView<FName> NewCurveNames)
+{
+	CachedCurves.Reset();
+	CachedCurves.Reserve(NewCurveNames.Num());
+
+	for (const auto& CurveName : NewCurveNames)
+	{
+		CachedCurves.Add({CurveName});
+	}
+
+	SearchedCurvesCount = INDEX_NONE;
+}
+
+void FAlsAnimationCurveCache::GetCurveValues(const TMap<FName, float>& Curves, const TArrayView<float> Values)
+{
+	check(Values.Num() >= CachedCurves.Num())
+
+	if (Curves.IsEmpty())
+	{
+		for (auto i{0}; i < CachedCurves.Num(); i++)
+		{
+			Values[i] = 0.0f;
+		}
+
+		return;
+	}
+
+	auto bCurvesChanged{Curves.Num() != SearchedCurvesCount};
+
+	for (auto i{0}; i < CachedCurves.Num(); i++)
+	{
+		auto& CachedCurve{CachedCurves[i]};
+
+		if (!CachedCurve.Id.IsValidId())
+		{
+			// Missing curves are searched for after this loop, once it is known whether the map has changed.
+
+			Values[i] = 0.0f;
+			continue;
+		}
+
+		if (Curves.IsValidId(CachedCurve.Id) && Curves.Get(CachedCurve.Id).Key == CachedCurve.Name)
+		{
+			Values[i] = Curves.Get(CachedCurve.Id).Value;
+			continue;
+		}
+
+		// The resolved curve has moved, so the map was refilled with a different set of curves.
+
+		bCurvesChanged = true;
+
+		CachedCurve.Id = Curves.FindId(CachedCurve.Name);
+		Values[i] = CachedCurve.Id.IsValidId() ? Curves.Get(CachedCurve.Id).Value : 0.0f;
+	}
+
+	if (!bCurvesChanged)
+	{
+		return;
+	}
+
+	SearchedCurvesCount = Curves.Num();
+
+	for (auto i{0}; i < CachedCurves.Num(); i++)
+	{
+		auto& CachedCurve{CachedCurves[i]};
+
+		if (!CachedCurve.Id.IsValidId())
+		{
+			CachedCurve.Id = Curves.FindId(CachedCurve.Name);
+
+			if (CachedCurve.Id.IsValidId())
+			{
+				Values[i] = Curves.Get(CachedCurve.Id).Value;
+			}
+		}
+	}
+}
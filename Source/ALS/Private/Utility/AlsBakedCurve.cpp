@@ -0,0 +1,58 @@
+#include "Utility/AlsBakedCurve.h"
+
+#include "Curves/RichCurve.h"
+
+bool FAlsBakedCurve::Bake(const FRichCurve& Curve, const float NewStartTime, const float EndTime, const float MaxRelativeError)
+{
+	const auto TimeRange{FMath::Max(0.0f, EndTime - NewStartTime)};
+
+	StartTime = NewStartTime;
+	TimeToSampleIndex = TimeRange > UE_SMALL_NUMBER ? (SamplesCount - 1) / TimeRange : 0.0f;
+
+	for (auto i{0}; i < SamplesCount; i++)
+	{
+		Samples[i] = Curve.Eval(StartTime + TimeRange * i / (SamplesCount - 1));
+	}
+
+	// Measure the error by evaluating the source curve between samples, where the linear interpolation deviates from it the most.
+
+	static constexpr auto ErrorSamplesPerInterval{4};
+	static constexpr auto ErrorSamplesCount{(SamplesCount - 1) * ErrorSamplesPerInterval};
+
+	MaxError = 0.0f;
+
+	for (auto i{1}; i < ErrorSamplesCount; i++)
+	{
+		const auto Time{StartTime + TimeRange * i / ErrorSamplesCount};
+
+		MaxError = FMath::Max(MaxError, FMath::Abs(Curve.Eval(Time) - Evaluate(Time)));
+	}
+
+	float MinValue, MaxValue;
+	Curve.GetValueRange(MinValue, MaxValue);
+
+	bBaked = MaxError <= FMath::Max((MaxValue - MinValue) * MaxRelativeError, UE_KINDA_SMALL_NUMBER);
+	return bBaked;
+}
+
+bool FAlsBakedCurve::Bake(const FRichCurve& Curve, const float MaxRelativeError)
+{
+	if (Curve.PreInfinityExtrap != RCCE_Constant || Curve.PostInfinityExtrap != RCCE_Constant)
+	{
+		Reset();
+		return false;
+	}
+
+	float CurveStartTime, CurveEndTime;
+	Curve.GetTimeRange(CurveStartTime, CurveEndTime);
+
+	return Bake(Curve, CurveStartTime, CurveEndTime, MaxRelativeError);
+}
+
+void FAlsBakedCurve::Reset()
+{
+	StartTime = 0.0f;
+	TimeToSampleIndex = 0.0f;
+	MaxError = 0.0f;
+	bBaked = false;
+}
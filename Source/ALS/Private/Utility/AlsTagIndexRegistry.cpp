@@ -0,0 +1,97 @@
+#include "Utility/AlsTagIndexRegistry.h"
+
+#include "Utility/AlsGameplayTags.h"
+
+namespace AlsTagIndexRegistry
+{
+	// Don't change the order of tags in these tables, because it defines the network format.
+
+	static const TArray<FGameplayTag>& GetFamilyTagsArray(const EAlsTagFamily Family)
+	{
+		static const TArray<FGameplayTag> ViewModeTags{
+			AlsViewModeTags::FirstPerson, AlsViewModeTags::ThirdPerson, AlsViewModeTags::TopDown
+		};
+
+		static const TArray<FGameplayTag> RotationModeTags{
+			AlsRotationModeTags::VelocityDirection, AlsRotationModeTags::ViewDirection, AlsRotationModeTags::Aiming
+		};
+
+		static const TArray<FGameplayTag> StanceTags{
+			AlsStanceTags::Standing, AlsStanceTags::Crouching
+		};
+
+		static const TArray<FGameplayTag> GaitTags{
+			AlsGaitTags::Walking, AlsGaitTags::Running, AlsGaitTags::Sprinting
+		};
+
+		static const TArray<FGameplayTag> OverlayModeTags{
+			AlsOverlayModeTags::Default, AlsOverlayModeTags::Masculine, AlsOverlayModeTags::Feminine,
+			AlsOverlayModeTags::Injured, AlsOverlayModeTags::HandsTied, AlsOverlayModeTags::Rifle,
+			AlsOverlayModeTags::PistolOneHanded, AlsOverlayModeTags::PistolTwoHanded, AlsOverlayModeTags::Bow,
+			AlsOverlayModeTags::Torch, AlsOverlayModeTags::Binoculars, AlsOverlayModeTags::Box, AlsOverlayModeTags::Barrel
+		};
+
+		switch (Family)
+		{
+			case EAlsTagFamily::ViewMode:
+				return ViewModeTags;
+
+			case EAlsTagFamily::RotationMode:
+				return RotationModeTags;
+
+			case EAlsTagFamily::Stance:
+				return StanceTags;
+
+			case EAlsTagFamily::Gait:
+				return GaitTags;
+
+			default:
+				return OverlayModeTags;
+		}
+	}
+
+	TConstArrayView<FGameplayTag> GetFamilyTags(const EAlsTagFamily Family)
+	{
+		return GetFamilyTagsArray(Family);
+	}
+
+	uint32 GetIndexBitsCount(const EAlsTagFamily Family)
+	{
+		return FMath::CeilLogTwo(static_cast<uint32>(GetFamilyTagsArray(Family).Num()) + 1);
+	}
+
+	uint8 GetIndexByTag(const EAlsTagFamily Family, const FGameplayTag& Tag)
+	{
+		const auto Index{GetFamilyTagsArray(Family).IndexOfByKey(Tag)};
+		return static_cast<uint8>(Index + 1);
+	}
+
+	bool NetSerializeTag(FArchive& Archive, UPackageMap* Map, const EAlsTagFamily Family, FGameplayTag& Tag)
+	{
+		const auto& FamilyTags{GetFamilyTagsArray(Family)};
+
+		uint8 Index{Archive.IsSaving() ? GetIndexByTag(Family, Tag) : static_cast<uint8>(0)};
+		Archive.SerializeBits(&Index, GetIndexBitsCount(Family));
+
+		if (Index == 0)
+		{
+			auto bSuccess{true};
+			Tag.NetSerialize(Archive, Map, bSuccess);
+
+			return bSuccess;
+		}
+
+		if (Archive.IsLoading())
+		{
+			if (Index > FamilyTags.Num())
+			{
+				Archive.SetError();
+				return false;
+			}
+
+			Tag = FamilyTags[Index - 1];
+		}
+
+		return true;
+	}
+}
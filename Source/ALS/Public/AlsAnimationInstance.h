@@ -2,6 +2,7 @@
 
 #include "Animation/AnimInstance.h"
 #include "Engine/World.h"
+#include "State/AlsAnimationInputSnapshot.h"
 #include "State/AlsControlRigInput.h"
 #include "State/AlsCrouchingState.h"
 #include "State/AlsDynamicTransitionsState.h"
@@ -21,9 +22,11 @@
 #include "State/AlsTransitionsState.h"
 #include "State/AlsTurnInPlaceState.h"
 #include "State/AlsViewAnimationState.h"
+#include "Utility/AlsAnimationCurveCache.h"
 #include "Utility/AlsGameplayTags.h"
 #include "AlsAnimationInstance.generated.h"
 
+class USkinnedAsset;
 class UAlsLinkedAnimationInstance;
 class AAlsCharacter;
 
@@ -57,6 +60,9 @@ protected:
 	mutable TArray<TFunction<void()>> DisplayDebugTracesQueue;
 #endif
 
+	// Layering and pose curves resolved once during initialization, so that they can be read without hashing every frame.
+	FAlsAnimationCurveCache CurveCache;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FGameplayTag ViewMode{AlsViewModeTags::ThirdPerson};
 
@@ -135,6 +141,33 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FAlsRagdollingAnimationState RagdollingState;
 
+private:
+	// Skinned asset for which the feet bone indices were resolved. Referenced so that it can't be replaced by
+	// another asset at the same address, which allows detecting skinned asset changes with a pointer comparison.
+	UPROPERTY(Transient)
+	TObjectPtr<const USkinnedAsset> FeetBoneIndicesSkinnedAsset;
+
+	FAlsFeetBoneIndices FeetBoneIndices;
+
+	// Frame of the last character animation input snapshot used by the animation instance.
+	uint64 InputSnapshotFrame{0};
+
+	// Animation input gathered by the animation instance itself when the Als.Animation.UseCharacterInputSnapshot
+	// console variable is disabled, instead of reading the snapshot published by the character.
+	UPROPERTY(Transient)
+	FAlsAnimationInputSnapshot GatheredInputSnapshot;
+
+	FTraceHandle GroundPredictionTraceHandle;
+
+	uint64 GroundPredictionTraceFrame{0};
+
+	// Frame in which the last accepted ground prediction sweep was issued.
+	uint64 GroundPredictionHitFrame{0};
+
+	float GroundPredictionHitTime{1.0f};
+
+	uint8 bGroundPredictionHitValid : 1 {false};
+
 public:
 	virtual void NativeInitializeAnimation() override;
 
@@ -164,16 +197,16 @@ public:
 	void MarkTeleported();
 
 private:
-	void RefreshMovementBaseOnGameThread();
+	void RefreshMovementBaseOnGameThread(const FAlsAnimationInputSnapshot& InputSnapshot);
 
-	void RefreshLayering();
+	void RefreshLayering(TConstArrayView<float> CurveValues);
 
-	void RefreshPose();
+	void RefreshPose(TConstArrayView<float> CurveValues);
 
 	// View
 
 private:
-	void RefreshViewOnGameThread();
+	void RefreshViewOnGameThread(const FAlsAnimationInputSnapshot& InputSnapshot);
 
 	void RefreshView(float DeltaTime);
 
@@ -193,7 +226,7 @@ protected:
 	// Locomotion
 
 private:
-	void RefreshLocomotionOnGameThread();
+	void RefreshLocomotionOnGameThread(const FAlsAnimationInputSnapshot& InputSnapshot);
 
 protected:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Animation Instance", Meta = (BlueprintThreadSafe))
@@ -260,6 +293,8 @@ public:
 private:
 	void RefreshInAirOnGameThread();
 
+	void RefreshGroundPredictionOnGameThread();
+
 protected:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Animation Instance", Meta = (BlueprintThreadSafe))
 	void RefreshInAir();
@@ -271,6 +306,8 @@ protected:
 	// Feet
 
 private:
+	void RefreshFeetBoneIndices(const USkeletalMeshComponent* Mesh);
+
 	void RefreshFeetOnGameThread();
 
 	void RefreshFeet(float DeltaTime);
@@ -344,7 +381,7 @@ private:
 	// Ragdolling
 
 private:
-	void RefreshRagdollingOnGameThread();
+	void RefreshRagdollingOnGameThread(const FAlsAnimationInputSnapshot& InputSnapshot);
 
 public:
 	FPoseSnapshot& SnapshotFinalRagdollPose();
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "GameFramework/Character.h"
+#include "State/AlsAnimationInputSnapshot.h"
 #include "State/AlsLocomotionState.h"
 #include "State/AlsMantlingState.h"
+#include "State/AlsMantlingTraceState.h"
 #include "State/AlsMovementBaseState.h"
+#include "State/AlsPackedDesiredState.h"
 #include "State/AlsRagdollingState.h"
 #include "State/AlsRollingState.h"
+#include "State/AlsSignificanceTier.h"
 #include "State/AlsViewState.h"
 #include "Utility/AlsGameplayTags.h"
 #include "AlsCharacter.generated.h"
@@ -108,8 +112,22 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State|Als Character", Transient)
 	FAlsRollingState RollingState;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State|Als Character", Transient)
+	EAlsSignificanceTier SignificanceTier{EAlsSignificanceTier::High};
+
+	// Time left until the next refresh of the state that lower significance tiers refresh less often than every frame.
+	float SignificanceRefreshTimeRemaining{0.0f};
+
 	FTimerHandle BrakingFrictionFactorResetTimer;
 
+	FAlsInAirMantlingTraceState InAirMantlingTraceState;
+
+	// Desired state fields changed since the last desired state RPC.
+	EAlsDesiredStateFields PendingDesiredStateFields{EAlsDesiredStateFields::None};
+
+	UPROPERTY(Transient)
+	FAlsAnimationInputSnapshot AnimationInputSnapshot;
+
 public:
 	explicit AAlsCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
@@ -128,6 +146,8 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void CalcCamera(float DeltaTime, FMinimalViewInfo& ViewInfo) override;
 
 public:
@@ -151,7 +171,36 @@ protected:
 private:
 	void RefreshMeshProperties() const;
 
-	void RefreshMovementBase();
+	void RefreshMovementBase(FAlsMovementBaseState& State) const;
+
+public:
+	const FAlsAnimationInputSnapshot& GetAnimationInputSnapshot() const;
+
+	// Fills the snapshot from the current character state. The movement base state is refreshed relative to the one already in the snapshot.
+	void GatherAnimationInputSnapshot(FAlsAnimationInputSnapshot& Snapshot, float DeltaTime) const;
+
+private:
+	void RefreshAnimationInputSnapshot(float DeltaTime);
+
+	// Significance
+
+public:
+	EAlsSignificanceTier GetSignificanceTier() const;
+
+	void SetSignificanceTier(EAlsSignificanceTier NewTier);
+
+	// Desired State
+
+private:
+	void SendPendingDesiredState();
+
+	UFUNCTION(Client, Reliable)
+	void ClientSetDesiredState(const FAlsPackedDesiredState& NewDesiredState);
+
+	UFUNCTION(Server, Reliable)
+	void ServerSetDesiredState(const FAlsPackedDesiredState& NewDesiredState);
+
+	void ApplyPackedDesiredState(const FAlsPackedDesiredState& NewDesiredState);
 
 	// View Mode
 
@@ -164,12 +213,6 @@ public:
 private:
 	void SetViewMode(const FGameplayTag& NewViewMode, bool bSendRpc);
 
-	UFUNCTION(Client, Reliable)
-	void ClientSetViewMode(const FGameplayTag& NewViewMode);
-
-	UFUNCTION(Server, Reliable)
-	void ServerSetViewMode(const FGameplayTag& NewViewMode);
-
 	// Locomotion Mode
 
 public:
@@ -197,12 +240,6 @@ public:
 private:
 	void SetDesiredAiming(bool bNewDesiredAiming, bool bSendRpc);
 
-	UFUNCTION(Client, Reliable)
-	void ClientSetDesiredAiming(bool bNewDesiredAiming);
-
-	UFUNCTION(Server, Reliable)
-	void ServerSetDesiredAiming(bool bNewDesiredAiming);
-
 	UFUNCTION()
 	void OnReplicated_DesiredAiming(bool bPreviousDesiredAiming);
 
@@ -221,12 +258,6 @@ public:
 private:
 	void SetDesiredRotationMode(const FGameplayTag& NewDesiredRotationMode, bool bSendRpc);
 
-	UFUNCTION(Client, Reliable)
-	void ClientSetDesiredRotationMode(const FGameplayTag& NewDesiredRotationMode);
-
-	UFUNCTION(Server, Reliable)
-	void ServerSetDesiredRotationMode(const FGameplayTag& NewDesiredRotationMode);
-
 	// Rotation Mode
 
 public:
@@ -253,12 +284,6 @@ public:
 private:
 	void SetDesiredStance(const FGameplayTag& NewDesiredStance, bool bSendRpc);
 
-	UFUNCTION(Client, Reliable)
-	void ClientSetDesiredStance(const FGameplayTag& NewDesiredStance);
-
-	UFUNCTION(Server, Reliable)
-	void ServerSetDesiredStance(const FGameplayTag& NewDesiredStance);
-
 protected:
 	virtual void ApplyDesiredStance();
 
@@ -291,12 +316,6 @@ public:
 private:
 	void SetDesiredGait(const FGameplayTag& NewDesiredGait, bool bSendRpc);
 
-	UFUNCTION(Client, Reliable)
-	void ClientSetDesiredGait(const FGameplayTag& NewDesiredGait);
-
-	UFUNCTION(Server, Reliable)
-	void ServerSetDesiredGait(const FGameplayTag& NewDesiredGait);
-
 	// Gait
 
 public:
@@ -328,12 +347,6 @@ public:
 private:
 	void SetOverlayMode(const FGameplayTag& NewOverlayMode, bool bSendRpc);
 
-	UFUNCTION(Client, Reliable)
-	void ClientSetOverlayMode(const FGameplayTag& NewOverlayMode);
-
-	UFUNCTION(Server, Reliable)
-	void ServerSetOverlayMode(const FGameplayTag& NewOverlayMode);
-
 	UFUNCTION()
 	void OnReplicated_OverlayMode(const FGameplayTag& PreviousOverlayMode);
 
@@ -507,6 +520,24 @@ private:
 
 	bool StartMantling(const FAlsMantlingTraceSettings& TraceSettings);
 
+	bool CanStartMantling() const;
+
+	bool PrepareMantlingTraces(const FAlsMantlingTraceSettings& TraceSettings, FAlsMantlingTraceContext& Context) const;
+
+	bool ProcessMantlingForwardTrace(FAlsMantlingTraceContext& Context);
+
+	bool ProcessMantlingDownwardTrace(FAlsMantlingTraceContext& Context) const;
+
+	bool ProcessMantlingOverlaps(const FAlsMantlingTraceContext& Context, bool bTargetLocationBlocked, bool bStartLocationBlocked) const;
+
+	void StartMantlingFromTraces(const FAlsMantlingTraceContext& Context);
+
+	FAlsMantlingNoLedgeCacheEntry MakeMantlingNoLedgeCacheEntry(const FAlsMantlingTraceContext& Context) const;
+
+	bool IsMantlingNoLedgeCached(const FAlsMantlingNoLedgeCacheEntry& Entry) const;
+
+	void CacheMantlingNoLedge();
+
 	UFUNCTION(Server, Reliable)
 	void ServerStartMantling(const FAlsMantlingParameters& Parameters);
 
@@ -615,6 +646,16 @@ inline const UAlsCharacterSettings* AAlsCharacter::GetSettings() const
 	return Settings;
 }
 
+inline const FAlsAnimationInputSnapshot& AAlsCharacter::GetAnimationInputSnapshot() const
+{
+	return AnimationInputSnapshot;
+}
+
+inline EAlsSignificanceTier AAlsCharacter::GetSignificanceTier() const
+{
+	return SignificanceTier;
+}
+
 inline const FGameplayTag& AAlsCharacter::GetViewMode() const
 {
 	return ViewMode;
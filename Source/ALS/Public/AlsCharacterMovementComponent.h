@@ -1,9 +1,12 @@
 #pragma once
 
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Settings/AlsMovementBudget.h"
 #include "Settings/AlsMovementSettings.h"
 #include "AlsCharacterMovementComponent.generated.h"
 
+class UAlsNetworkSmoothingSubsystem;
+
 using FAlsPhysicsRotationDelegate = TMulticastDelegate<void(float DeltaTime)>;
 
 class ALS_API FAlsCharacterNetworkMoveData : public FCharacterNetworkMoveData
@@ -33,6 +36,53 @@ public:
 	FAlsCharacterNetworkMoveDataContainer();
 };
 
+// Grounded movement settings together with all inputs they were calculated from.
+struct ALS_API FAlsGroundedMovementSettingsMemoEntry
+{
+	FVector Velocity{ForceInit};
+
+	FRotator ViewRotation{ForceInit};
+
+	FVector GravityDirection{ForceInit};
+
+	const FAlsMovementGaitSettings* GaitSettings{nullptr};
+
+	const UAlsMovementSettings* MovementSettings{nullptr};
+
+	FGameplayTag MaxAllowedGait;
+
+	bool bUseBakedCurves{false};
+
+	float GaitAmount{0.0f};
+
+	float MaxWalkSpeed{0.0f};
+
+	float MaxAcceleration{0.0f};
+
+	float BrakingDeceleration{0.0f};
+
+	float GroundFriction{0.0f};
+
+	bool HasSameInputs(const FAlsGroundedMovementSettingsMemoEntry& Other) const;
+
+	bool HasSameSettings(const FAlsGroundedMovementSettingsMemoEntry& Other) const;
+};
+
+// Grounded movement settings calculated during a single move. A move usually calculates them once per physics
+// iteration, so a few entries are enough to cover the whole move, and the rest of the calculations are not memoized.
+struct ALS_API FAlsGroundedMovementSettingsMemo
+{
+	TStaticArray<FAlsGroundedMovementSettingsMemoEntry, 4> Entries;
+
+	int32 EntriesCount{0};
+
+	const FAlsGroundedMovementSettingsMemoEntry* Find(const FAlsGroundedMovementSettingsMemoEntry& Inputs) const;
+
+	void Add(const FAlsGroundedMovementSettingsMemoEntry& Entry);
+
+	void Reset();
+};
+
 class ALS_API FAlsSavedMove : public FSavedMove_Character
 {
 private:
@@ -45,18 +95,46 @@ public:
 
 	FGameplayTag MaxAllowedGait{AlsGaitTags::Running};
 
+	// Grounded movement settings calculated when the move was first simulated, reused when the move is replayed
+	// after a server correction for the calculations whose inputs didn't change, instead of calculating them again.
+	FAlsGroundedMovementSettingsMemo GroundedMovementSettingsMemo;
+
 public:
 	virtual void Clear() override;
 
 	virtual void SetMoveFor(ACharacter* Character, float NewDeltaTime, const FVector& NewAcceleration,
 	                        FNetworkPredictionData_Client_Character& PredictionData) override;
 
+	virtual bool IsImportantMove(const FSavedMovePtr& LastAckedMove) const override;
+
 	virtual bool CanCombineWith(const FSavedMovePtr& NewMovePtr, ACharacter* Character, float MaxDeltaTime) const override;
 
 	virtual void CombineWith(const FSavedMove_Character* PreviousMove, ACharacter* Character,
 	                         APlayerController* Player, const FVector& PreviousStartLocation) override;
 
 	virtual void PrepMoveFor(ACharacter* Character) override;
+
+	virtual void PostUpdate(ACharacter* Character, EPostUpdateMode PostUpdateMode) override;
+};
+
+struct ALS_API FAlsFloorCacheEntry
+{
+	FVector CapsuleLocation{ForceInit};
+
+	float LineDistance{0.0f};
+
+	float SweepDistance{0.0f};
+
+	float SweepRadius{0.0f};
+
+	float CapsuleRadius{0.0f};
+
+	float CapsuleHalfHeight{0.0f};
+
+	// Frame in which the entry was added. Zero means the entry is not used.
+	uint64 Frame{0};
+
+	FFindFloorResult FloorResult;
 };
 
 class ALS_API FAlsNetworkPredictionData : public FNetworkPredictionData_Client_Character
@@ -64,12 +142,24 @@ class ALS_API FAlsNetworkPredictionData : public FNetworkPredictionData_Client_C
 private:
 	using Super = FNetworkPredictionData_Client_Character;
 
+	bool bFreeMovesPrefilled{false};
+
+	// Number of saved moves allocated after the free moves pool was filled.
+	int32 OverflowSavedMovesCount{0};
+
 public:
 	explicit FAlsNetworkPredictionData(const UCharacterMovementComponent& Movement);
 
 	virtual FSavedMovePtr AllocateNewMove() override;
+
+	int32 GetOverflowSavedMovesCount() const;
 };
 
+inline int32 FAlsNetworkPredictionData::GetOverflowSavedMovesCount() const
+{
+	return OverflowSavedMovesCount;
+}
+
 UCLASS(ClassGroup = "ALS")
 class ALS_API UAlsCharacterMovementComponent : public UCharacterMovementComponent
 {
@@ -77,20 +167,65 @@ class ALS_API UAlsCharacterMovementComponent : public UCharacterMovementComponen
 
 	friend FAlsSavedMove;
 
+	friend UAlsNetworkSmoothingSubsystem;
+
 public:
 	// If checked, improves the response to interaction from moving kinematic physical
 	// bodies, but may cause some issues when interacting with simulated physical bodies.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
 	uint8 bAllowImprovedPenetrationAdjustment : 1 {true};
 
+	// If checked, the remaining walking substeps of a frame are merged into longer substeps once the character moves steadily along the
+	// same floor. This reduces the number of sweeps at low tick rates at the cost of slightly less precise collision response.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
+	uint8 bAllowAdaptiveWalkingSubsteps : 1 {false};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings",
+		Meta = (ClampMin = 0, EditCondition = "bAllowAdaptiveWalkingSubsteps", ForceUnits = "s"))
+	float AdaptiveWalkingMaxSubstepTime{0.1f};
+
+	// Maximum angle between the acceleration directions of two moves at which they can still be combined into a single
+	// move. Larger values allow more moves to be combined when the acceleration slowly rotates along with the camera.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings|Network",
+		Meta = (ClampMin = 0, ClampMax = 45, ForceUnits = "deg"))
+	float MoveCombiningAccelerationAngleTolerance{5.0f};
+
+	// Minimum time between client moves sent to the server while no important move has happened since the last
+	// acknowledged move, such as a change of acceleration direction or ALS state. Zero means the engine default is used.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings|Network", Meta = (ClampMin = 0, ClampMax = 0.1, ForceUnits = "s"))
+	float SteadyStateClientNetSendDeltaTime{0.0f};
+
+	// Server-side limit of the number of moves of the remote client owning this character that are simulated per second
+	// of the client's time. Moves beyond the limit are merged into the next simulated move instead of being simulated one by one.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings|Network")
+	FAlsMovementBudget MovementBudget;
+
 protected:
 	FAlsCharacterNetworkMoveDataContainer MoveDataContainer;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	TObjectPtr<UAlsMovementSettings> MovementSettings;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
-	FAlsMovementGaitSettings GaitSettings;
+	static const FAlsMovementGaitSettings DefaultGaitSettings;
+
+	// Recent floor results on static geometry, mostly reused when client moves are replayed after a server correction.
+	mutable TStaticArray<FAlsFloorCacheEntry, 16> FloorCache;
+
+	mutable int32 NextFloorCacheIndex{0};
+
+	// View rotation twist around the gravity direction used for the direction dependent movement speed. It only depends on
+	// the view rotation and gravity direction, which rarely change between the substeps of a move or during move replays.
+	FRotator DirectionDependentSpeedViewRotation{ForceInit};
+
+	FVector DirectionDependentSpeedGravityDirection{ForceInit};
+
+	FQuat DirectionDependentSpeedRelativeViewRotation{ForceInit};
+
+	// Grounded movement settings calculated during the saved move that is currently being simulated or replayed.
+	FAlsGroundedMovementSettingsMemo GroundedMovementSettingsMemo;
+
+	// Points to the gait settings in the movement settings instead of copying them, since they are refreshed very often.
+	const FAlsMovementGaitSettings* GaitSettings{&DefaultGaitSettings};
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FGameplayTag RotationMode{AlsRotationModeTags::ViewDirection};
@@ -124,6 +259,56 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	uint8 bPrePenetrationAdjustmentVelocityValid : 1 {false};
 
+	// Valid only on the server for remotely controlled characters.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	float RemainingMoveBudget{0.0f};
+
+	// Delta time of the autonomous moves merged into the next affordable move because the movement budget was exhausted.
+	float MergedMoveDeltaTime{0.0f};
+
+	FVector PreviousAutonomousMoveAcceleration{ForceInit};
+
+	uint8 PreviousAutonomousMoveFlags{0};
+
+	// Whether the last autonomous move was merged into the next one instead of being simulated.
+	uint8 bAutonomousMoveMerged : 1 {false};
+
+	// Whether the last autonomous move was simulated along with the moves merged before it.
+	uint8 bAutonomousMoveIncludesMergedMoves : 1 {false};
+
+	// Whether the network smoothing of this simulated proxy is performed by the network smoothing subsystem.
+	uint8 bNetworkSmoothingBatched : 1 {false};
+
+	// Whether the grounded movement settings are recorded into the memo during the first simulation of a saved move.
+	uint8 bRecordingGroundedMovementSettings : 1 {false};
+
+	// Whether the grounded movement settings are restored from the memo during the replay of a saved move.
+	uint8 bReplayingGroundedMovementSettings : 1 {false};
+
+	// Valid only on the locally controlled client.
+	int32 GroundedMovementSettingsMemoHitsCount{0};
+
+	// Valid only on the locally controlled client.
+	int32 GroundedMovementSettingsMemoMismatchesCount{0};
+
+	// Valid only on the server.
+	int32 ServerMovesReceivedCount{0};
+
+	// Valid only on the server.
+	int32 ClientCorrectionsSentCount{0};
+
+	// Valid only on the locally controlled client.
+	int32 ClientCorrectionsReceivedCount{0};
+
+	// Valid only on the server for remotely controlled characters.
+	int32 SimulatedAutonomousMovesCount{0};
+
+	// Valid only on the server for remotely controlled characters.
+	int32 MergedAutonomousMovesCount{0};
+
+	// Valid only on the server for remotely controlled characters.
+	double AutonomousMovesTime{0.0};
+
 public:
 	FAlsPhysicsRotationDelegate OnPhysicsRotation;
 
@@ -136,6 +321,10 @@ public:
 
 	virtual void BeginPlay() override;
 
+protected:
+	virtual void OnUnregister() override;
+
+public:
 	virtual FVector ConsumeInputVector() override;
 
 	virtual void SetMovementMode(EMovementMode NewMovementMode, uint8 NewCustomMode = 0) override;
@@ -173,21 +362,73 @@ public:
 	virtual void ComputeFloorDist(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, FFindFloorResult& OutFloorResult,
 	                              float SweepRadius, const FHitResult* DownwardSweepResult) const override;
 
+private:
+	void ComputeFloorDistUncached(const FVector& CapsuleLocation, float LineDistance, float SweepDistance,
+	                              FFindFloorResult& OutFloorResult, float SweepRadius, const FHitResult* DownwardSweepResult) const;
+
+	bool TryGetCachedFloor(const FVector& CapsuleLocation, float LineDistance, float SweepDistance,
+	                       float SweepRadius, FFindFloorResult& OutFloorResult) const;
+
+	void CacheFloor(const FVector& CapsuleLocation, float LineDistance, float SweepDistance,
+	                float SweepRadius, const FFindFloorResult& FloorResult) const;
+
 protected:
 	virtual void PerformMovement(float DeltaTime) override;
 
 public:
 	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 
+	virtual float GetClientNetSendDeltaTime(const APlayerController* Player, const FNetworkPredictionData_Client_Character* ClientData,
+	                                        const FSavedMovePtr& NewMove) const override;
+
+	virtual void ServerMovePacked_ServerReceive(const FCharacterServerMovePackedBits& PackedBits) override;
+
+	virtual void SendClientAdjustment() override;
+
+	virtual void ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse) override;
+
+	// Number of packed server move RPCs received from the client, each of which may contain up to three moves.
+	int32 GetServerMovesReceivedCount() const;
+
+	int32 GetClientCorrectionsSentCount() const;
+
+	int32 GetClientCorrectionsReceivedCount() const;
+
+	// Number of the client's moves simulated by the server, including the moves simulated on behalf of merged moves.
+	int32 GetSimulatedAutonomousMovesCount() const;
+
+	// Number of the client's moves merged into the next simulated move because the movement budget was exhausted.
+	int32 GetMergedAutonomousMovesCount() const;
+
+	// Total CPU time in seconds spent by the server on simulating the client's moves.
+	double GetAutonomousMovesTime() const;
+
 protected:
 	virtual void SmoothClientPosition(float DeltaTime) override;
 
+private:
+	bool TryGatherNetworkSmoothing(float DeltaTime);
+
+protected:
 	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAcceleration) override;
 
+	virtual void ServerMoveHandleClientError(float ClientTimeStamp, float DeltaTime, const FVector& Acceleration,
+	                                         const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase,
+	                                         FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+
+	virtual bool ServerShouldUseAuthoritativePosition(float ClientTimeStamp, float DeltaTime, const FVector& Acceleration,
+	                                                  const FVector& ClientLocation, const FVector& RelativeClientLocation,
+	                                                  UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName,
+	                                                  uint8 ClientMovementMode) override;
+
+private:
+	bool CanMergeAutonomousMove(uint8 CompressedFlags, const FVector& NewAcceleration, const FAlsCharacterNetworkMoveData* MoveData) const;
+
 public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character Movement")
 	void SetMovementSettings(UAlsMovementSettings* NewMovementSettings);
 
+	UFUNCTION(BlueprintPure, Category = "ALS|Character Movement", Meta = (ReturnDisplayName = "Gait Settings"))
 	const FAlsMovementGaitSettings& GetGaitSettings() const;
 
 private:
@@ -210,9 +451,21 @@ public:
 	// Varies from 0 to 3, where 0 is stopped, 1 is walking, 2 is running, and 3 is sprinting.
 	float GetGaitAmount() const;
 
+	// Number of grounded movement settings calculations skipped during move replays because their inputs didn't change.
+	int32 GetGroundedMovementSettingsMemoHitsCount() const;
+
+	// Number of skipped grounded movement settings calculations whose result differed from the memoized one. Only
+	// counted if the Als.Movement.VerifyGroundedMovementSettingsMemo console variable is enabled, must always be zero.
+	int32 GetGroundedMovementSettingsMemoMismatchesCount() const;
+
 private:
 	void RefreshGroundedMovementSettings();
 
+	// Calculates the grounded movement settings from the inputs in the entry. Returns false if
+	// the acceleration, deceleration and ground friction can't be calculated, in which case
+	// the entry keeps the current values of the character movement component for them.
+	bool CalculateGroundedMovementSettings(FAlsGroundedMovementSettingsMemoEntry& Entry);
+
 public:
 	void SetMovementModeLocked(bool bNewMovementModeLocked);
 
@@ -221,9 +474,39 @@ public:
 	bool TryConsumePrePenetrationAdjustmentVelocity(FVector& OutVelocity);
 };
 
+inline int32 UAlsCharacterMovementComponent::GetServerMovesReceivedCount() const
+{
+	return ServerMovesReceivedCount;
+}
+
+inline int32 UAlsCharacterMovementComponent::GetClientCorrectionsSentCount() const
+{
+	return ClientCorrectionsSentCount;
+}
+
+inline int32 UAlsCharacterMovementComponent::GetClientCorrectionsReceivedCount() const
+{
+	return ClientCorrectionsReceivedCount;
+}
+
+inline int32 UAlsCharacterMovementComponent::GetSimulatedAutonomousMovesCount() const
+{
+	return SimulatedAutonomousMovesCount;
+}
+
+inline int32 UAlsCharacterMovementComponent::GetMergedAutonomousMovesCount() const
+{
+	return MergedAutonomousMovesCount;
+}
+
+inline double UAlsCharacterMovementComponent::GetAutonomousMovesTime() const
+{
+	return AutonomousMovesTime;
+}
+
 inline const FAlsMovementGaitSettings& UAlsCharacterMovementComponent::GetGaitSettings() const
 {
-	return GaitSettings;
+	return *GaitSettings;
 }
 
 inline const FGameplayTag& UAlsCharacterMovementComponent::GetRotationMode() const
@@ -250,3 +533,13 @@ inline float UAlsCharacterMovementComponent::GetGaitAmount() const
 {
 	return GaitAmount;
 }
+
+inline int32 UAlsCharacterMovementComponent::GetGroundedMovementSettingsMemoHitsCount() const
+{
+	return GroundedMovementSettingsMemoHitsCount;
+}
+
+inline int32 UAlsCharacterMovementComponent::GetGroundedMovementSettingsMemoMismatchesCount() const
+{
+	return GroundedMovementSettingsMemoMismatchesCount;
+}
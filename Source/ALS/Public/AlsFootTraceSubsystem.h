@@ -0,0 +1,99 @@
+#pragma once
+
+#include "WorldCollision.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsFootTraceSubsystem.generated.h"
+
+// Gathers the foot traces requested by control rigs during animation evaluation and performs them on the game thread
+// as a single batch of asynchronous traces, so that the animation worker threads don't have to perform synchronous
+// traces. Each request returns the result of the previous trace with the same id, which may be a few frames old.
+UCLASS()
+class ALS_API UAlsFootTraceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	struct FAlsFootTrace
+	{
+		FVector Start{ForceInit};
+
+		FVector End{ForceInit};
+
+		TWeakObjectPtr<const AActor> OwningActor;
+
+		TEnumAsByte<ECollisionChannel> Channel{ECC_Visibility};
+
+		uint8 bRequested : 1 {false};
+
+		uint8 bHitValid : 1 {false};
+
+		FTraceHandle TraceHandle;
+
+		uint64 RequestFrame{0};
+
+		uint64 IssueFrame{0};
+
+		FHitResult Hit;
+	};
+
+	FCriticalSection TracesLock;
+
+	TMap<int32, FAlsFootTrace> Traces;
+
+	std::atomic<int32> NextTraceId{0};
+
+	std::atomic<int32> IssuedTracesCount{0};
+
+	std::atomic<int32> ReusedTracesCount{0};
+
+	std::atomic<int32> SynchronousTracesCount{0};
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	virtual TStatId GetStatId() const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	// Thread safe.
+	int32 AllocateTraceId();
+
+	// Thread safe. Requests a trace to be performed in the next batch and returns the hit of the last completed trace with the
+	// same id, projected onto the requested trace. Returns false if there is no such hit, in which case the caller should perform
+	// the trace by itself and pass its result to CompleteTrace(). Traces of actors with a lower significance tier are performed
+	// less frequently.
+	bool RequestTrace(int32 TraceId, const FVector& Start, const FVector& End, ECollisionChannel Channel,
+	                  const AActor* OwningActor, FHitResult& OutHit);
+
+	// Thread safe. Stores the hit of a trace that the caller performed by itself after RequestTrace() returned false,
+	// so that it is reused by the following requests instead of issuing an asynchronous trace for the same request.
+	void CompleteTrace(int32 TraceId, ECollisionChannel Channel, const FHitResult& Hit);
+
+	// Number of asynchronous traces issued by the subsystem.
+	int32 GetIssuedTracesCount() const;
+
+	// Number of requests answered with the hit of a previously completed trace.
+	int32 GetReusedTracesCount() const;
+
+	// Number of traces that callers performed by themselves and passed to CompleteTrace().
+	int32 GetSynchronousTracesCount() const;
+
+private:
+	void IssueTraces();
+};
+
+inline int32 UAlsFootTraceSubsystem::GetIssuedTracesCount() const
+{
+	return IssuedTracesCount.load(std::memory_order_relaxed);
+}
+
+inline int32 UAlsFootTraceSubsystem::GetReusedTracesCount() const
+{
+	return ReusedTracesCount.load(std::memory_order_relaxed);
+}
+
+inline int32 UAlsFootTraceSubsystem::GetSynchronousTracesCount() const
+{
+	return SynchronousTracesCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsFootstepEffectsSubsystem.generated.h"
+
+struct FStreamableHandle;
+class UAlsFootstepEffectsSettings;
+class UDecalComponent;
+class UMaterialInterface;
+
+// Streams footstep effect assets in ahead of time and recycles footstep decals, so that
+// footsteps neither cause synchronous loads nor create a new decal component every time.
+UCLASS()
+class ALS_API UAlsFootstepEffectsSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	// Ring buffer of decal components. The oldest decal is reused once the pool reaches its maximum size.
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UDecalComponent>> Decals;
+
+	int32 NextDecalIndex{0};
+
+	TSet<TObjectKey<UAlsFootstepEffectsSettings>> PreloadedSettings;
+
+	// One handle per preloaded settings asset, kept to keep the loaded assets referenced for the lifetime of the world.
+	TArray<TSharedPtr<FStreamableHandle>> PreloadHandles;
+
+	// Handles of single assets requested on demand, at most one per asset. Handles of loaded assets are kept for the
+	// same reason as the preload handles, while failed ones are released and leave a null entry so they aren't retried.
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> AsyncLoadHandles;
+
+public:
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	// Asynchronously loads the sounds, decal materials and particle systems of all effects in the settings.
+	// Returns whether the effects were already preloaded before this call.
+	bool PreloadEffects(const UAlsFootstepEffectsSettings* FootstepEffectsSettings);
+
+	// Asynchronously loads a single asset that was not preloaded. The asset is not returned,
+	// so the caller should skip the effect for now and pick the asset up on the next footstep.
+	void RequestAsyncLoad(const FSoftObjectPath& AssetPath);
+
+	UDecalComponent* SpawnDecal(UMaterialInterface* DecalMaterial, const FVector& DecalSize, const FVector& DecalLocation,
+	                            const FRotator& DecalRotation, USceneComponent* AttachParent,
+	                            float Duration, float FadeOutDuration);
+
+	int32 GetDecalsCount() const;
+
+private:
+	void OnAsyncLoadCompleted(FSoftObjectPath AssetPath);
+
+	UDecalComponent* AcquireDecal();
+};
+
+inline int32 UAlsFootstepEffectsSubsystem::GetDecalsCount() const
+{
+	return Decals.Num();
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsNetworkSmoothingSubsystem.generated.h"
+
+class UAlsCharacterMovementComponent;
+class UAlsNetworkSmoothingSubsystem;
+
+USTRUCT()
+struct ALS_API FAlsNetworkSmoothingTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+public:
+	UAlsNetworkSmoothingSubsystem* Subsystem{nullptr};
+
+public:
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& CompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FAlsNetworkSmoothingTickFunction> : public TStructOpsTypeTraitsBase2<FAlsNetworkSmoothingTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+// Performs the network smoothing of simulated proxies as a single batch. Each movement component gathers its smoothing
+// state into the buffers below during its own tick, then the interpolation of all of them runs in parallel, and finally
+// the resulting mesh offsets are applied on the game thread. The batch runs after the ticks of all gathered movement
+// components and before the ticks of their meshes, so the animation sees the same mesh offsets as without batching.
+UCLASS()
+class ALS_API UAlsNetworkSmoothingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	FAlsNetworkSmoothingTickFunction TickFunction;
+
+	// Frame in which the buffers were filled. Smoothing gathered in an earlier frame is discarded.
+	uint64 GatherFrame{0};
+
+	uint64 ExecutionFrame{0};
+
+	int32 LastBatchSize{0};
+
+	// Smoothing state of all gathered movement components, one element per component in each array.
+
+	TArray<TWeakObjectPtr<UAlsCharacterMovementComponent>> Movements;
+
+	TArray<ENetworkSmoothingMode> Modes;
+
+	TArray<float> DeltaTimes;
+
+	TArray<FVector> Velocities;
+
+	TArray<float> CorrectionDeltas;
+
+	TArray<float> SmoothLocationTimes;
+
+	TArray<float> SmoothRotationTimes;
+
+	TArray<double> ServerTimeStamps;
+
+	TArray<double> ClientTimeStamps;
+
+	TArray<FVector> OriginalTranslationOffsets;
+
+	TArray<FVector> TranslationOffsets;
+
+	TArray<FQuat> OriginalRotationOffsets;
+
+	TArray<FQuat> RotationOffsets;
+
+	TArray<FQuat> RotationTargets;
+
+	TArray<uint8> SmoothingCompletes;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& World) override;
+
+	// Makes the batch run after the movement component's tick and before its mesh's tick.
+	void RegisterMovement(UAlsCharacterMovementComponent& Movement);
+
+	void UnregisterMovement(UAlsCharacterMovementComponent& Movement);
+
+	// Gathers the smoothing state of the movement component into the batch. Returns false if the batch can't take
+	// it anymore in this frame, in which case the caller should perform the smoothing by itself.
+	bool GatherSmoothing(UAlsCharacterMovementComponent& Movement, float DeltaTime);
+
+	// Number of movement components smoothed by the last batch.
+	int32 GetLastBatchSize() const;
+
+	void ExecuteBatch();
+
+private:
+	void ResetBatch();
+
+	void ComputeSmoothing(int32 Index);
+};
+
+inline int32 UAlsNetworkSmoothingSubsystem::GetLastBatchSize() const
+{
+	return LastBatchSize;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "State/AlsSignificanceTier.h"
+#include "AlsSignificanceSubsystem.generated.h"
+
+class AAlsCharacter;
+
+// Periodically assigns significance tiers to characters based on their distance to local viewers and
+// visibility. Only simulated proxies are ever demoted from the high tier, so the authoritative and
+// autonomous simulation doesn't depend on the camera position and stays the same on all machines.
+UCLASS()
+class ALS_API UAlsSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	TArray<TWeakObjectPtr<AAlsCharacter>> Characters;
+
+	float RefreshTimeRemaining{0.0f};
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	virtual TStatId GetStatId() const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	void RegisterCharacter(AAlsCharacter* Character);
+
+	void UnregisterCharacter(AAlsCharacter* Character);
+
+	// Interval at which characters in the tier refresh the state that doesn't have to be refreshed every frame.
+	static float GetRefreshInterval(EAlsSignificanceTier Tier);
+
+private:
+	void RefreshSignificance();
+
+	EAlsSignificanceTier CalculateSignificanceTier(const AAlsCharacter* Character, TConstArrayView<FVector> ViewLocations) const;
+};
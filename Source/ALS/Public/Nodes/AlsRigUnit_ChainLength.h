@@ -27,6 +27,20 @@ public:
 	UPROPERTY(Transient)
 	FCachedRigElement CachedDescendantItem;
 
+	// Indices of the elements forming the chain between the ancestor and descendant items. Resolved only when the items or the
+	// hierarchy topology change, so that the hierarchy doesn't have to be searched and no memory is allocated on every execute.
+	UPROPERTY(Transient)
+	TArray<int32> CachedChainElementIndices;
+
+	UPROPERTY(Transient)
+	int32 CachedChainAncestorIndex{INDEX_NONE};
+
+	UPROPERTY(Transient)
+	int32 CachedChainDescendantIndex{INDEX_NONE};
+
+	UPROPERTY(Transient)
+	uint32 CachedChainTopologyVersion{0};
+
 public:
 	RIGVM_METHOD()
 	virtual void Execute() override;
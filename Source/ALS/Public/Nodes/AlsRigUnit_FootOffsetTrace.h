@@ -30,6 +30,16 @@ public:
 	UPROPERTY(Meta = (Input))
 	bool bEnabled{true};
 
+	// If checked, the trace is performed asynchronously by the foot trace subsystem together with the foot traces of other
+	// characters, and the surface hit by the previous trace is projected onto the current one instead. This avoids a synchronous
+	// trace on the animation worker thread, but the result can be a few frames old. A synchronous trace is still used for the
+	// first frame and after the foot moves too far at once, e.g. when the character is teleported. Characters with a lower
+	// significance tier are traced less frequently, but significance tiers only demote simulated proxies, so locally
+	// controlled characters and characters on the server never skip traces. Can be overridden for all rig units with the
+	// Als.ControlRig.BatchFootOffsetTraces console variable.
+	UPROPERTY(Meta = (Input))
+	bool bBatchTrace{false};
+
 	UPROPERTY(meta = (Input, DetailsOnly))
 	bool bDrawDebug{false};
 
@@ -39,6 +49,9 @@ public:
 	UPROPERTY(Transient, Meta = (Output))
 	FVector OffsetNormal{ForceInit};
 
+	UPROPERTY(Transient)
+	int32 TraceId{INDEX_NONE};
+
 public:
 	RIGVM_METHOD()
 	virtual void Execute() override;
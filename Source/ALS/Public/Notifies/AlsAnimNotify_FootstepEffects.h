@@ -10,6 +10,7 @@ struct FHitResult;
 class USoundBase;
 class UMaterialInterface;
 class UNiagaraSystem;
+class UAlsFootstepEffectsSubsystem;
 
 UENUM(BlueprintType)
 enum class EAlsFootBone : uint8
@@ -244,13 +245,15 @@ public:
 	                    const FAnimNotifyEventReference& NotifyEventReference) override;
 
 private:
-	void SpawnSound(USkeletalMeshComponent* Mesh, const FAlsFootstepSoundSettings& SoundSettings,
-	                const FVector& FootstepLocation, const FQuat& FootstepRotation) const;
+	void SpawnSound(USkeletalMeshComponent* Mesh, UAlsFootstepEffectsSubsystem* EffectsSubsystem,
+	                bool bEffectsPreloaded, const FAlsFootstepSoundSettings& SoundSettings, const FVector& FootstepLocation,
+	                const FQuat& FootstepRotation) const;
 
-	void SpawnDecal(USkeletalMeshComponent* Mesh, const FAlsFootstepDecalSettings& DecalSettings,
-	                const FVector& FootstepLocation, const FQuat& FootstepRotation,
-	                const FHitResult& FootstepHit, const FVector& FootZAxis) const;
+	void SpawnDecal(USkeletalMeshComponent* Mesh, UAlsFootstepEffectsSubsystem* EffectsSubsystem,
+	                bool bEffectsPreloaded, const FAlsFootstepDecalSettings& DecalSettings, const FVector& FootstepLocation,
+	                const FQuat& FootstepRotation, const FHitResult& FootstepHit, const FVector& FootZAxis) const;
 
-	void SpawnParticleSystem(USkeletalMeshComponent* Mesh, const FAlsFootstepParticleSystemSettings& ParticleSystemSettings,
+	void SpawnParticleSystem(USkeletalMeshComponent* Mesh, UAlsFootstepEffectsSubsystem* EffectsSubsystem, bool bEffectsPreloaded,
+	                         const FAlsFootstepParticleSystemSettings& ParticleSystemSettings,
 	                         const FVector& FootstepLocation, const FQuat& FootstepRotation) const;
 };
@@ -14,6 +14,8 @@
 #include "Engine/DataAsset.h"
 #include "AlsAnimationInstanceSettings.generated.h"
 
+class UCurveBase;
+
 UCLASS(Blueprintable, BlueprintType)
 class ALS_API UAlsAnimationInstanceSettings : public UDataAsset
 {
@@ -53,10 +55,32 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	FAlsGeneralTurnInPlaceSettings TurnInPlace;
 
+#if WITH_EDITORONLY_DATA
+private:
+	// Curves whose update delegates are bound to rebake the lookup tables when the curves are edited.
+	TArray<TWeakObjectPtr<UCurveBase>> BoundCurves;
+#endif
+
 public:
 	UAlsAnimationInstanceSettings();
 
+	virtual void PostLoad() override;
+
 #if WITH_EDITOR
+	virtual void BeginDestroy() override;
+
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& ChangedEvent) override;
 #endif
+
+	// Bakes the curves that are evaluated every frame into lookup tables, so that they can be sampled without key searches.
+	void BakeCurves();
+
+#if WITH_EDITOR
+private:
+	void BindCurves();
+
+	void UnbindCurves();
+
+	void Curve_OnUpdated(UCurveBase* Curve, EPropertyChangeType::Type ChangeType);
+#endif
 };
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "Utility/AlsBakedCurve.h"
 #include "AlsCrouchingSettings.generated.h"
 
 class UCurveFloat;
@@ -15,4 +16,6 @@ struct ALS_API FAlsCrouchingSettings
 	// Movement speed to stride blend amount curve.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	TObjectPtr<UCurveFloat> StrideBlendAmountCurve;
+
+	FAlsBakedCurve StrideBlendAmountBakedCurve;
 };
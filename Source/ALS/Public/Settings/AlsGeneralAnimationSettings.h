@@ -2,6 +2,8 @@
 
 #include "AlsGeneralAnimationSettings.generated.h"
 
+class UAlsFootstepEffectsSettings;
+
 USTRUCT(BlueprintType)
 struct ALS_API FAlsGeneralAnimationSettings
 {
@@ -19,4 +21,10 @@ struct ALS_API FAlsGeneralAnimationSettings
 	// The higher the value, the faster the interpolation. A zero value results in instant interpolation.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0))
 	float LeanInterpolationSpeed{4.0f};
+
+	// Assets of these footstep effects are loaded asynchronously when the animation instance begins play, so that the first
+	// footstep on each surface doesn't cause a synchronous load. Assets of footstep effects not listed here are loaded
+	// synchronously by their first footstep, which then starts the asynchronous load of the rest of their assets.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	TArray<TObjectPtr<UAlsFootstepEffectsSettings>> FootstepEffectsSettings;
 };
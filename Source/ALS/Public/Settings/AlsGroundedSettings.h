@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "Utility/AlsBakedCurve.h"
 #include "AlsGroundedSettings.generated.h"
 
 class UCurveFloat;
@@ -24,4 +25,13 @@ struct ALS_API FAlsGroundedSettings
 	// The higher the value, the faster the interpolation. A zero value results in instant interpolation.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0))
 	float VelocityBlendInterpolationSpeed{12.0f};
+
+	// Lookup tables baked from the rotation yaw offset curves. Unbaked tables fall back to evaluating the source curves.
+	FAlsBakedCurve RotationYawOffsetForwardBakedCurve;
+
+	FAlsBakedCurve RotationYawOffsetBackwardBakedCurve;
+
+	FAlsBakedCurve RotationYawOffsetLeftBakedCurve;
+
+	FAlsBakedCurve RotationYawOffsetRightBakedCurve;
 };
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "Engine/EngineTypes.h"
+#include "Utility/AlsBakedCurve.h"
 #include "AlsInAirSettings.generated.h"
 
 class UCurveFloat;
@@ -28,6 +29,15 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "ALS", AdvancedDisplay)
 	FCollisionResponseContainer GroundPredictionSweepResponses{ECR_Ignore};
 
+	// The ground prediction sweep is performed asynchronously and its result is consumed in later frames.
+	// Results older than this number of frames are considered stale and are no longer used.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 1))
+	int32 GroundPredictionMaxResultAge{2};
+
+	FAlsBakedCurve LeanAmountBakedCurve;
+
+	FAlsBakedCurve GroundPredictionAmountBakedCurve;
+
 public:
 #if WITH_EDITOR
 	void PostEditChangeProperty(const FPropertyChangedEvent& ChangedEvent);
@@ -122,6 +122,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	FAlsMantlingTraceSettings InAirTrace{{50.0f, 150.0f}, 70.0f};
 
+	// In-air mantling traces that didn't find a ledge are not repeated for this amount of time while the character
+	// stays in the same location bucket and on the same movement base. A zero value disables this cache.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "s"))
+	float InAirNoLedgeCacheDuration{0.2f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 1, ForceUnits = "cm"))
+	float InAirNoLedgeCacheBucketSize{20.0f};
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	TEnumAsByte<ECollisionChannel> MantlingTraceChannel{ECC_Visibility};
 
@@ -0,0 +1,39 @@
+﻿#pragma once
+
+#include "AlsMovementBudget.generated.h"
+
+// Limits the number of moves of a single remote client that the server simulates per second of the client's time. When
+// the budget is exhausted, the following moves are merged into the next affordable move instead of being simulated one
+// by one. The budget only depends on the moves sent by the client, so the same moves are always merged the same way.
+//
+// The budget counts moves instead of measuring the CPU time spent on them. A CPU time budget depends on the server's
+// hardware and load, so the same moves of a client would be merged differently from run to run and from server to
+// server, and the server's simulation would drift away from the client's one in a way that the client can't predict.
+// Since the cost of a move barely depends on its delta time, limiting the moves rate bounds the CPU time just as well.
+// The CPU time itself is still reported by the Autonomous Moves Time stat.
+//
+// A move simulated along with merged moves takes one large step instead of several small ones, so its result slightly
+// differs from the client's one. If the difference is within the allowed client error, the server accepts the client's
+// location, so that the difference doesn't accumulate over consecutive merged moves and doesn't lead to corrections.
+USTRUCT(BlueprintType)
+struct ALS_API FAlsMovementBudget
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	uint8 bEnabled : 1 {false};
+
+	// Number of moves that the server can simulate per second of the client's move delta time.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 1, EditCondition = "bEnabled"))
+	float MaxMovesPerSecond{30.0f};
+
+	// Maximum number of unused moves that can be accumulated, which allows short bursts of moves.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 1, EditCondition = "bEnabled"))
+	float MaxAccumulatedMoves{3.0f};
+
+	// Maximum delta time of a merged move. The delta time of merged moves beyond this limit is dropped. The budget is
+	// refilled by the delta time of the merged moves, so their total delta time only exceeds 1 / Max Moves Per Second
+	// by the delta time of a single move, and this limit doesn't affect legitimate clients unless it is set lower than that.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, EditCondition = "bEnabled", ForceUnits = "s"))
+	float MaxMergedMoveDeltaTime{0.1f};
+};
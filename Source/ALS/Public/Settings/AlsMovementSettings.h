@@ -1,9 +1,11 @@
 ﻿#pragma once
 
 #include "Engine/DataAsset.h"
+#include "Utility/AlsBakedCurve.h"
 #include "Utility/AlsGameplayTags.h"
 #include "AlsMovementSettings.generated.h"
 
+class UCurveBase;
 class UCurveFloat;
 class UCurveVector;
 
@@ -44,7 +46,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	TObjectPtr<UCurveFloat> RotationInterpolationSpeedCurve;
 
+	// Lookup tables baked from the acceleration, deceleration, and ground friction curve. Either all or none of them are baked.
+	TStaticArray<FAlsBakedCurve, 3> AccelerationAndDecelerationAndGroundFrictionBakedCurves;
+
 public:
+	void BakeCurves();
+
 	float GetMaxWalkSpeed() const;
 
 	float GetMaxRunSpeed() const;
@@ -82,10 +89,54 @@ public:
 		{AlsRotationModeTags::Aiming, {}}
 	};
 
+#if WITH_EDITOR
+	// Broadcast every time the gait settings are recompiled in the editor, so that
+	// anyone holding pointers returned by FindGaitSettings() can look them up again.
+	FSimpleMulticastDelegate OnGaitSettingsCompiled;
+#endif
+
+private:
+	static constexpr auto CompiledRotationModesCount{4};
+
+	static constexpr auto CompiledStancesCount{3};
+
+	// Gait settings of the built-in rotation modes and stances compiled into a dense table indexed
+	// by tag indices from AlsTagIndexRegistry, so that they can be found without any map lookups.
+	TStaticArray<FAlsMovementGaitSettings, CompiledRotationModesCount * CompiledStancesCount> CompiledGaitSettings;
+
+	TStaticArray<bool, CompiledRotationModesCount * CompiledStancesCount> CompiledGaitSettingsValid{InPlace, false};
+
+#if WITH_EDITORONLY_DATA
+	// Curves whose update delegates are bound to rebake the lookup tables when the curves are edited.
+	TArray<TWeakObjectPtr<UCurveBase>> BoundCurves;
+#endif
+
 public:
+	virtual void PostLoad() override;
+
 #if WITH_EDITOR
+	virtual void BeginDestroy() override;
+
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& ChangedEvent) override;
 #endif
+
+	void BakeCurves();
+
+	void CompileGaitSettings();
+
+	// For the built-in rotation modes and stances, the returned pointer stays valid for the lifetime of the movement settings.
+	// For custom ones, it points directly to the rotation modes map and becomes invalid if the map is changed in the
+	// editor, in which case OnGaitSettingsCompiled is broadcast and the pointer must be looked up again.
+	const FAlsMovementGaitSettings* FindGaitSettings(const FGameplayTag& RotationMode, const FGameplayTag& Stance) const;
+
+#if WITH_EDITOR
+private:
+	void BindCurves();
+
+	void UnbindCurves();
+
+	void Curve_OnUpdated(UCurveBase* Curve, EPropertyChangeType::Type ChangeType);
+#endif
 };
 
 inline float FAlsMovementGaitSettings::GetMaxWalkSpeed() const
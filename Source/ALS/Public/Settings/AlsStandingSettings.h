@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "Utility/AlsBakedCurve.h"
 #include "AlsStandingSettings.generated.h"
 
 class UCurveFloat;
@@ -28,4 +29,8 @@ struct ALS_API FAlsStandingSettings
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm/s"))
 	float PivotActivationSpeedThreshold{200.0f};
+
+	FAlsBakedCurve StrideBlendAmountWalkBakedCurve;
+
+	FAlsBakedCurve StrideBlendAmountRunBakedCurve;
 };
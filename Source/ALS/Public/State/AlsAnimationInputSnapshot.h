@@ -0,0 +1,48 @@
+#pragma once
+
+#include "AlsMovementBaseState.h"
+#include "AlsAnimationInputSnapshot.generated.h"
+
+// Character state consumed by the animation instance on the game thread. The character publishes it once at the end of its
+// tick, so that the animation instance can read it from a single place instead of gathering it piece by piece every frame.
+USTRUCT()
+struct ALS_API FAlsAnimationInputSnapshot
+{
+	GENERATED_BODY()
+
+	// Frame in which the snapshot was published. Used to detect snapshots that weren't refreshed since the last
+	// animation update, for example, when the character ticks less frequently than its animation instance.
+	uint64 Frame{0};
+
+	// Delta time of the character tick that published the snapshot. If the character ticks at an interval,
+	// it covers all frames since the previous snapshot, so rates of change must be calculated using it.
+	float DeltaTime{0.0f};
+
+	float TimeDilation{1.0f};
+
+	// Exposed to the reflection system only to keep the movement base primitive referenced.
+	UPROPERTY()
+	FAlsMovementBaseState MovementBase;
+
+	FRotator ViewRotation{ForceInit};
+
+	float ViewYawSpeed{0.0f};
+
+	uint8 bHasInput : 1 {false};
+
+	uint8 bHasVelocity : 1 {false};
+
+	uint8 bMoving : 1 {false};
+
+	float InputYawAngle{0.0f};
+
+	float Speed{0.0f};
+
+	FVector Velocity{ForceInit};
+
+	float VelocityYawAngle{0.0f};
+
+	float TargetYawAngle{0.0f};
+
+	FVector RagdollingVelocity{ForceInit};
+};
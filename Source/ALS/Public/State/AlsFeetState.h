@@ -72,3 +72,17 @@ struct ALS_API FAlsFeetState
 		.ThighAxis = FVector3f::ZAxisVector
 	};
 };
+
+// Mesh bone indices resolved during initialization, so that the feet can be refreshed without searching bones by name.
+struct ALS_API FAlsFeetBoneIndices
+{
+	int32 Pelvis{INDEX_NONE};
+
+	int32 FootLeftIk{INDEX_NONE};
+
+	int32 FootRightIk{INDEX_NONE};
+
+	int32 FootLeftVirtual{INDEX_NONE};
+
+	int32 FootRightVirtual{INDEX_NONE};
+};
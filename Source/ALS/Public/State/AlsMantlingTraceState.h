@@ -0,0 +1,98 @@
+#pragma once
+
+#include "WorldCollision.h"
+#include "Engine/HitResult.h"
+#include "Settings/AlsMantlingSettings.h"
+
+class UPrimitiveComponent;
+
+// Intermediate results of the mantling traces. Filled step by step, so
+// that the same checks can be performed by both synchronous and asynchronous traces.
+struct ALS_API FAlsMantlingTraceContext
+{
+	FAlsMantlingTraceSettings TraceSettings;
+
+	FVector CapsuleBottomLocation{ForceInit};
+
+	float CapsuleScale{1.0f};
+
+	float CapsuleRadius{0.0f};
+
+	float CapsuleHalfHeight{0.0f};
+
+	float TraceCapsuleRadius{0.0f};
+
+	float LedgeHeightDelta{0.0f};
+
+	FVector ForwardTraceDirection{ForceInit};
+
+	FVector ForwardTraceStart{ForceInit};
+
+	FVector ForwardTraceEnd{ForceInit};
+
+	float ForwardTraceCapsuleHalfHeight{0.0f};
+
+	FHitResult ForwardTraceHit;
+
+	FVector TargetDirection{ForceInit};
+
+	FVector DownwardTraceStart{ForceInit};
+
+	FVector DownwardTraceEnd{ForceInit};
+
+	FHitResult DownwardTraceHit;
+
+	FVector TargetLocation{ForceInit};
+
+	FVector TargetCapsuleLocation{ForceInit};
+
+	FVector StartLocation{ForceInit};
+
+	float StartLocationTraceCapsuleHalfHeight{0.0f};
+
+#if ENABLE_DRAW_DEBUG
+	bool bDisplayDebug{false};
+#endif
+};
+
+enum class EAlsMantlingTraceStage : uint8
+{
+	None,
+	ForwardTrace,
+	DownwardTrace,
+	Overlaps
+};
+
+struct ALS_API FAlsMantlingNoLedgeCacheEntry
+{
+	TObjectKey<UPrimitiveComponent> MovementBase;
+
+	FIntVector LocationBucket{ForceInit};
+
+	uint8 DirectionSector{0};
+
+	double ExpirationTime{0.0};
+};
+
+// State of the in-air mantling traces, which are performed asynchronously, one step per frame.
+struct ALS_API FAlsInAirMantlingTraceState
+{
+	static constexpr auto NoLedgeCacheSize{8};
+
+	EAlsMantlingTraceStage Stage{EAlsMantlingTraceStage::None};
+
+	FTraceHandle SweepHandle;
+
+	FTraceHandle TargetLocationOverlapHandle;
+
+	FTraceHandle StartLocationOverlapHandle;
+
+	FAlsMantlingTraceContext Context;
+
+	// Cache entry that will be added if the current traces don't find a ledge.
+	FAlsMantlingNoLedgeCacheEntry PendingNoLedgeEntry;
+
+	TStaticArray<FAlsMantlingNoLedgeCacheEntry, NoLedgeCacheSize> NoLedgeCache;
+
+	int32 NextNoLedgeCacheIndex{0};
+};
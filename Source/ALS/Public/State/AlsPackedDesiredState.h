@@ -0,0 +1,59 @@
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "AlsPackedDesiredState.generated.h"
+
+enum class EAlsDesiredStateFields : uint8
+{
+	None = 0,
+	ViewMode = 1 << 0,
+	OverlayMode = 1 << 1,
+	DesiredAiming = 1 << 2,
+	DesiredRotationMode = 1 << 3,
+	DesiredStance = 1 << 4,
+	DesiredGait = 1 << 5,
+	All = (1 << 6) - 1
+};
+
+ENUM_CLASS_FLAGS(EAlsDesiredStateFields)
+
+// Desired state changes accumulated over a frame and sent in a single RPC. Only the changed
+// fields are serialized, and the built-in tags are sent as small indices instead of full tags.
+USTRUCT()
+struct ALS_API FAlsPackedDesiredState
+{
+	GENERATED_BODY()
+
+public:
+	EAlsDesiredStateFields ChangedFields{EAlsDesiredStateFields::None};
+
+	UPROPERTY()
+	uint8 bDesiredAiming : 1 {false};
+
+	UPROPERTY()
+	FGameplayTag ViewMode;
+
+	UPROPERTY()
+	FGameplayTag OverlayMode;
+
+	UPROPERTY()
+	FGameplayTag DesiredRotationMode;
+
+	UPROPERTY()
+	FGameplayTag DesiredStance;
+
+	UPROPERTY()
+	FGameplayTag DesiredGait;
+
+public:
+	bool NetSerialize(FArchive& Archive, UPackageMap* Map, bool& bSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FAlsPackedDesiredState> : public TStructOpsTypeTraitsBase2<FAlsPackedDesiredState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
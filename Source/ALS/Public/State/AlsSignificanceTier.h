@@ -0,0 +1,12 @@
+#pragma once
+
+#include "AlsSignificanceTier.generated.h"
+
+UENUM(BlueprintType)
+enum class EAlsSignificanceTier : uint8
+{
+	High,
+	Medium,
+	Low,
+	Lowest
+};
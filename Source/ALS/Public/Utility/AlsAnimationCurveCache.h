@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Containers/Map.h"
+
+// Resolves a fixed list of animation curves to element ids of the animation instance proxy curve map. The proxy refills
+// this map in the same order every frame, so resolved ids almost always remain valid, which allows reading curve values
+// with a single name comparison instead of a map lookup. Stale ids are re-resolved on demand. Curves that are missing from
+// the map are searched for again only when the number of curves in the map changes or one of the resolved curves moves,
+// so a curve that replaces another one without either of these happening is picked up on the next such change.
+class ALS_API FAlsAnimationCurveCache
+{
+private:
+	struct FAlsCachedCurve
+	{
+		FName Name;
+
+		FSetElementId Id;
+	};
+
+	TArray<FAlsCachedCurve, TInlineAllocator<32>> CachedCurves;
+
+	// Number of curves in the map when the missing curves were last searched for.
+	int32 SearchedCurvesCount{INDEX_NONE};
+
+public:
+	void Initialize(TConstArrayView<FName> NewCurveNames);
+
+	// Reads values of all cached curves in one pass. Curves that do not exist in the map are set to zero.
+	void GetCurveValues(const TMap<FName, float>& Curves, TArrayView<float> Values);
+};
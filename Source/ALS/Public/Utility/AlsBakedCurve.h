@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Containers/StaticArray.h"
+
+struct FRichCurve;
+
+// Fixed resolution lookup table baked from a rich curve. Sampling it takes constant time
+// and doesn't require searching for keys, unlike evaluating the source curve itself.
+struct ALS_API FAlsBakedCurve
+{
+public:
+	static constexpr auto SamplesCount{64};
+
+	// Maximum allowed deviation from the source curve, relative to the curve's value range.
+	static constexpr auto DefaultMaxRelativeError{0.005f};
+
+private:
+	TStaticArray<float, SamplesCount> Samples{InPlace, 0.0f};
+
+	float StartTime{0.0f};
+
+	float TimeToSampleIndex{0.0f};
+
+	float MaxError{0.0f};
+
+	uint8 bBaked : 1 {false};
+
+public:
+	// Bakes the curve in the given time range. Returns false and leaves the table unbaked if
+	// the baked curve deviates from the source curve by more than the allowed relative error.
+	bool Bake(const FRichCurve& Curve, float NewStartTime, float EndTime, float MaxRelativeError = DefaultMaxRelativeError);
+
+	// Bakes the curve in the time range of its keys. Fails if the curve isn't extrapolated as a constant
+	// outside of this range, since the baked curve is always clamped to the values at the range boundaries.
+	bool Bake(const FRichCurve& Curve, float MaxRelativeError = DefaultMaxRelativeError);
+
+	void Reset();
+
+	bool IsBaked() const;
+
+	// Maximum absolute deviation from the source curve measured during baking.
+	float GetMaxError() const;
+
+	float Evaluate(float Time) const;
+};
+
+inline bool FAlsBakedCurve::IsBaked() const
+{
+	return bBaked;
+}
+
+inline float FAlsBakedCurve::GetMaxError() const
+{
+	return MaxError;
+}
+
+inline float FAlsBakedCurve::Evaluate(const float Time) const
+{
+	const auto SampleIndex{FMath::Clamp((Time - StartTime) * TimeToSampleIndex, 0.0f, static_cast<float>(SamplesCount - 1))};
+	const auto LowerSampleIndex{FMath::Min(FMath::FloorToInt32(SampleIndex), SamplesCount - 2)};
+
+	return FMath::Lerp(Samples[LowerSampleIndex], Samples[LowerSampleIndex + 1], SampleIndex - LowerSampleIndex);
+}
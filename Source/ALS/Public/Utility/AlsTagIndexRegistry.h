@@ -0,0 +1,29 @@
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+class UPackageMap;
+
+enum class EAlsTagFamily : uint8
+{
+	ViewMode,
+	RotationMode,
+	Stance,
+	Gait,
+	OverlayMode
+};
+
+// Maps the built-in tags of each ALS tag family to a small index, so that they can be sent over the network
+// using only a few bits. Index 0 is reserved for tags outside the family, which are still sent as regular tags.
+namespace AlsTagIndexRegistry
+{
+	ALS_API TConstArrayView<FGameplayTag> GetFamilyTags(EAlsTagFamily Family);
+
+	// Number of bits needed to store any index of the family.
+	ALS_API uint32 GetIndexBitsCount(EAlsTagFamily Family);
+
+	// Returns 0 if the tag doesn't belong to the family.
+	ALS_API uint8 GetIndexByTag(EAlsTagFamily Family, const FGameplayTag& Tag);
+
+	ALS_API bool NetSerializeTag(FArchive& Archive, UPackageMap* Map, EAlsTagFamily Family, FGameplayTag& Tag);
+}
@@ -15,6 +15,11 @@ public class ALSEditor : ModuleRules
 			"Core", "CoreUObject", "Engine", "AnimGraphRuntime", "AnimationModifiers", "AnimationBlueprintLibrary", "ALS"
 		});
 
+		PrivateDependencyModuleNames.AddRange(new[]
+		{
+			"Json", "ALSExtras"
+		});
+
 		if (Target.bBuildEditor)
 		{
 			PublicDependencyModuleNames.AddRange(new[]
@@ -24,7 +29,7 @@ public class ALSEditor : ModuleRules
 
 			PrivateDependencyModuleNames.AddRange(new[]
 			{
-				"BlueprintGraph"
+				"BlueprintGraph", "UnrealEd"
 			});
 		}
 	}
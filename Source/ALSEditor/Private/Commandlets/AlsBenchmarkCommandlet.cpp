@@ -0,0 +1,609 @@
+﻿#include "Commandlets/AlsBenchmarkCommandlet.h"
+
+#include "AlsCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Stats/StatsData.h"
+#include "UObject/UObjectGlobals.h"
+#include "Utility/AlsGameplayTags.h"
+#include "Utility/AlsLog.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsBenchmarkCommandlet)
+
+namespace AlsBenchmarkCommandlet
+{
+	enum class EScenario : uint8
+	{
+		Walk,
+		Run,
+		Sprint,
+		Crouch,
+		Jump,
+		Mantle,
+		Ragdoll
+	};
+
+	static constexpr auto ScenariosCount{7};
+
+	static const TCHAR* ScenarioNames[ScenariosCount]{
+		TEXT("Walk"), TEXT("Run"), TEXT("Sprint"), TEXT("Crouch"), TEXT("Jump"), TEXT("Mantle"), TEXT("Ragdoll")
+	};
+
+	struct FSettings
+	{
+		TSubclassOf<AAlsCharacter> CharacterClass;
+
+		int32 Count{100};
+
+		int32 Frames{600};
+
+		int32 WarmupFrames{60};
+
+		float DeltaTime{1.0f / 60.0f};
+
+		bool bCompareAnimationInput{false};
+	};
+
+	struct FResult
+	{
+		FString Scenario;
+
+		// How the animation instances got their input from the characters, Snapshot or Gathered.
+		FString AnimationInput;
+
+		int32 Count{0};
+
+		// Wall time of each measured world tick in milliseconds.
+		TArray<double> FrameTimes;
+
+		// Mean inclusive time per frame in milliseconds and mean calls count per frame of each STATGROUP_Als cycle counter.
+		TMap<FName, TPair<double, double>> StatTimes;
+
+		double GetMean() const;
+
+		double GetPercentile(double Percentile) const;
+
+		// Mean game thread time per animation instance in microseconds spent on getting the input from
+		// the character and refreshing the animation instance. Only available if stats are enabled.
+		double GetAnimationGameThreadTimePerInstance() const;
+	};
+
+	// Cycle counters that make up the game thread cost of an animation instance.
+	static const FName AnimationGameThreadStatNames[]{
+		FName{TEXT("STAT_UAlsAnimationInstance_NativeUpdateAnimation")},
+		FName{TEXT("STAT_AAlsCharacter_RefreshAnimationInputSnapshot")}
+	};
+
+	// Characters don't collide with each other, so they can be packed densely without affecting each other's movement.
+	static constexpr auto CharacterSpacing{400.0f};
+
+	// Mantling characters run into an obstacle placed this far in front of them and are moved back periodically.
+	static constexpr auto MantleObstacleDistance{150.0f};
+
+	static constexpr auto MantleResetInterval{3.0f};
+
+	static constexpr auto DirectionChangeInterval{2.0f};
+
+	static constexpr auto JumpInterval{1.5f};
+
+	static constexpr auto RagdollInterval{4.0f};
+
+	double FResult::GetMean() const
+	{
+		auto Sum{0.0};
+
+		for (const auto FrameTime : FrameTimes)
+		{
+			Sum += FrameTime;
+		}
+
+		return FrameTimes.IsEmpty() ? 0.0 : Sum / FrameTimes.Num();
+	}
+
+	double FResult::GetPercentile(const double Percentile) const
+	{
+		if (FrameTimes.IsEmpty())
+		{
+			return 0.0;
+		}
+
+		auto SortedFrameTimes{FrameTimes};
+		SortedFrameTimes.Sort();
+
+		const auto Index{FMath::Clamp(FMath::CeilToInt32(Percentile * SortedFrameTimes.Num()) - 1, 0, SortedFrameTimes.Num() - 1)};
+		return SortedFrameTimes[Index];
+	}
+
+	double FResult::GetAnimationGameThreadTimePerInstance() const
+	{
+		auto Time{0.0};
+
+		for (const auto& StatName : AnimationGameThreadStatNames)
+		{
+			const auto* StatTime{StatTimes.Find(StatName)};
+			if (StatTime != nullptr)
+			{
+				Time += StatTime->Key;
+			}
+		}
+
+		return Count > 0 ? Time * 1000.0 / Count : 0.0;
+	}
+
+#if STATS
+	// Collects the per-frame aggregates of STATGROUP_Als, which the stats system publishes to the game thread for the stat HUD.
+	class FStatsCapture
+	{
+	private:
+		TMap<FName, TPair<double, double>> StatTotals;
+
+		int32 CapturedFramesCount{0};
+
+	public:
+		FStatsCapture()
+		{
+			StatsPrimaryEnableAdd();
+			DirectStatsCommand(TEXT("stat Als -nodisplay"), true);
+		}
+
+		~FStatsCapture()
+		{
+			DirectStatsCommand(TEXT("stat none"), true);
+			StatsPrimaryEnableSubtract();
+		}
+
+		void AdvanceFrame(const bool bCapture)
+		{
+			// The engine loop that usually advances the stats frame doesn't run in commandlets.
+
+			FStats::AdvanceFrame(false);
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+			const auto* StatsData{FLatestGameThreadStatsData::Get().Latest};
+			if (!bCapture || StatsData == nullptr)
+			{
+				return;
+			}
+
+			const auto GroupIndex{StatsData->GroupNames.IndexOfByKey(FName{TEXT("STATGROUP_Als")})};
+			if (GroupIndex == INDEX_NONE)
+			{
+				return;
+			}
+
+			CapturedFramesCount += 1;
+
+			for (const auto& Message : StatsData->ActiveStatGroups[GroupIndex].FlatAggregate)
+			{
+				if (Message.NameAndInfo.GetFlag(EStatMetaFlags::IsCycle))
+				{
+					auto& Totals{StatTotals.FindOrAdd(Message.GetShortName())};
+					Totals.Key += FPlatformTime::ToMilliseconds64(Message.GetValue_Duration(EComplexStatField::IncAve));
+					Totals.Value += Message.GetValue_CallCount(EComplexStatField::IncAve);
+				}
+			}
+		}
+
+		void WriteResult(FResult& Result) const
+		{
+			for (const auto& Totals : StatTotals)
+			{
+				Result.StatTimes.Add(Totals.Key, {
+					                     Totals.Value.Key / FMath::Max(1, CapturedFramesCount),
+					                     Totals.Value.Value / FMath::Max(1, CapturedFramesCount)
+				                     });
+			}
+		}
+	};
+#endif
+
+	static void SpawnBox(UWorld* World, UStaticMesh* BoxMesh, const FVector& Location, const FVector& Scale)
+	{
+		auto* Box{World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator)};
+		if (!IsValid(Box))
+		{
+			return;
+		}
+
+		auto* BoxComponent{Box->GetStaticMeshComponent()};
+
+		// Static components can't change their mesh at runtime.
+
+		BoxComponent->SetMobility(EComponentMobility::Movable);
+		BoxComponent->SetStaticMesh(BoxMesh);
+		BoxComponent->SetWorldScale3D(Scale);
+	}
+
+	static void DriveCharacter(AAlsCharacter* Character, const EScenario Scenario, const int32 Frame,
+	                           const float DeltaTime, const FVector& StartLocation)
+	{
+		const auto Time{Frame * DeltaTime};
+
+		const auto IsIntervalStart{
+			[Frame, DeltaTime](const float Interval)
+			{
+				return Frame % FMath::Max(1, FMath::RoundToInt32(Interval / DeltaTime)) == 0;
+			}
+		};
+
+		switch (Scenario)
+		{
+			case EScenario::Walk:
+			case EScenario::Crouch:
+				Character->SetDesiredGait(AlsGaitTags::Walking);
+				break;
+
+			case EScenario::Sprint:
+				Character->SetDesiredGait(AlsGaitTags::Sprinting);
+				break;
+
+			default:
+				Character->SetDesiredGait(AlsGaitTags::Running);
+				break;
+		}
+
+		Character->SetDesiredStance(Scenario == EScenario::Crouch ? AlsStanceTags::Crouching : AlsStanceTags::Standing);
+
+		if (Scenario == EScenario::Mantle)
+		{
+			if (Frame > 0 && IsIntervalStart(MantleResetInterval))
+			{
+				Character->TeleportTo(StartLocation, FRotator::ZeroRotator);
+			}
+
+			Character->AddMovementInput(FVector::ForwardVector);
+			Character->StartMantlingGrounded();
+			return;
+		}
+
+		if (Scenario == EScenario::Ragdoll)
+		{
+			if (IsIntervalStart(RagdollInterval))
+			{
+				Character->StartRagdolling();
+			}
+			else if (IsIntervalStart(RagdollInterval * 0.5f))
+			{
+				Character->StopRagdolling();
+			}
+		}
+
+		if (Scenario == EScenario::Jump)
+		{
+			if (IsIntervalStart(JumpInterval))
+			{
+				Character->Jump();
+			}
+			else
+			{
+				Character->StopJumping();
+			}
+		}
+
+		// Move along a square, so that the characters keep changing direction and stay near their start location.
+
+		const auto DirectionIndex{FMath::FloorToInt32(Time / DirectionChangeInterval) % 4};
+		Character->AddMovementInput(FRotator{0.0f, DirectionIndex * 90.0f, 0.0f}.Vector());
+	}
+
+	static FResult RunScenario(const FSettings& Settings, const EScenario Scenario)
+	{
+		FResult Result;
+		Result.Scenario = ScenarioNames[static_cast<uint8>(Scenario)];
+		Result.Count = Settings.Count;
+
+		auto* World{UWorld::CreateWorld(EWorldType::Game, false, *FString::Printf(TEXT("AlsBenchmark_%s"), *Result.Scenario))};
+		auto& WorldContext{GEngine->CreateNewWorldContext(EWorldType::Game)};
+		WorldContext.SetCurrentWorld(World);
+
+		// Generate a flat map large enough for all characters.
+
+		const auto GridSize{FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Settings.Count)))};
+		const auto GridExtent{GridSize * CharacterSpacing};
+
+		auto* BoxMesh{LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"))};
+		if (IsValid(BoxMesh))
+		{
+			// The box mesh is 100 units in size, so the top of the floor is at zero height.
+
+			SpawnBox(World, BoxMesh, {GridExtent * 0.5f, GridExtent * 0.5f, -50.0f},
+			         {(GridExtent + CharacterSpacing * 4.0f) / 100.0f, (GridExtent + CharacterSpacing * 4.0f) / 100.0f, 1.0f});
+		}
+
+		TArray<TPair<AAlsCharacter*, FVector>> Characters;
+		Characters.Reserve(Settings.Count);
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		for (auto i{0}; i < Settings.Count; i++)
+		{
+			const FVector StartLocation{
+				(i % GridSize + 0.5f) * CharacterSpacing, (i / GridSize + 0.5f) * CharacterSpacing, 100.0f
+			};
+
+			if (Scenario == EScenario::Mantle && IsValid(BoxMesh))
+			{
+				SpawnBox(World, BoxMesh, StartLocation + FVector{MantleObstacleDistance, 0.0f, -50.0f}, {0.5f, 1.0f, 1.0f});
+			}
+
+			auto* Character{World->SpawnActor<AAlsCharacter>(Settings.CharacterClass, StartLocation, FRotator::ZeroRotator, SpawnParameters)};
+			if (!IsValid(Character))
+			{
+				continue;
+			}
+
+			Character->GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+
+			// Nothing is rendered with -nullrhi, so animation would otherwise be skipped.
+
+			Character->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+			// Input is only consumed by locally controlled characters.
+
+			Character->SpawnDefaultController();
+
+			Characters.Emplace(Character, StartLocation);
+		}
+
+		World->InitializeActorsForPlay(FURL{});
+		World->BeginPlay();
+
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(Settings.DeltaTime);
+
+#if STATS
+		FStatsCapture StatsCapture;
+#endif
+
+		for (auto Frame{0}; Frame < Settings.WarmupFrames + Settings.Frames; Frame++)
+		{
+			for (auto i{0}; i < Characters.Num(); i++)
+			{
+				// Offset the script of each character, so that they don't all change direction or jump in the same frame.
+
+				DriveCharacter(Characters[i].Key, Scenario, Frame + i * 7, Settings.DeltaTime, Characters[i].Value);
+			}
+
+			FApp::SetDeltaTime(Settings.DeltaTime);
+			FApp::SetCurrentTime(FApp::GetCurrentTime() + Settings.DeltaTime);
+
+			const auto StartCycles{FPlatformTime::Cycles64()};
+
+			World->Tick(LEVELTICK_All, Settings.DeltaTime);
+
+			const auto FrameTime{FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles)};
+
+			GFrameCounter += 1;
+
+			if (Frame >= Settings.WarmupFrames)
+			{
+				Result.FrameTimes.Add(FrameTime);
+			}
+
+#if STATS
+			StatsCapture.AdvanceFrame(Frame >= Settings.WarmupFrames);
+#endif
+		}
+
+#if STATS
+		StatsCapture.WriteResult(Result);
+#endif
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		return Result;
+	}
+
+	static void WriteResults(const FString& OutputPath, const FSettings& Settings, const TConstArrayView<FResult> Results)
+	{
+		// Every stat gets its own column, so that the same stat can be compared across scenarios and commits.
+
+		TArray<FName> StatNames;
+
+		for (const auto& Result : Results)
+		{
+			for (const auto& StatTime : Result.StatTimes)
+			{
+				StatNames.AddUnique(StatTime.Key);
+			}
+		}
+
+		StatNames.Sort(FNameLexicalLess{});
+
+		FString Csv{
+			TEXT("Scenario,AnimationInput,Characters,Frames,MeanFrameMs,MedianFrameMs,P95FrameMs,MaxFrameMs,MeanCharacterUs,AnimationGameThreadUs")
+		};
+
+		for (const auto& StatName : StatNames)
+		{
+			Csv += FString::Printf(TEXT(",\"%s Ms\""), *StatName.ToString());
+		}
+
+		Csv += TEXT('\n');
+
+		TArray<TSharedPtr<FJsonValue>> JsonResults;
+
+		for (const auto& Result : Results)
+		{
+			const auto Mean{Result.GetMean()};
+			const auto MeanPerCharacter{Result.Count > 0 ? Mean * 1000.0 / Result.Count : 0.0};
+
+			Csv += FString::Printf(TEXT("%s,%s,%d,%d,%.4f,%.4f,%.4f,%.4f,%.3f,%.3f"), *Result.Scenario, *Result.AnimationInput,
+			                       Result.Count, Result.FrameTimes.Num(), Mean, Result.GetPercentile(0.5), Result.GetPercentile(0.95),
+			                       Result.GetPercentile(1.0), MeanPerCharacter, Result.GetAnimationGameThreadTimePerInstance());
+
+			for (const auto& StatName : StatNames)
+			{
+				const auto* StatTime{Result.StatTimes.Find(StatName)};
+				Csv += FString::Printf(TEXT(",%.4f"), StatTime != nullptr ? StatTime->Key : 0.0);
+			}
+
+			Csv += TEXT('\n');
+
+			const auto JsonResult{MakeShared<FJsonObject>()};
+			JsonResult->SetStringField(TEXT("Scenario"), Result.Scenario);
+			JsonResult->SetStringField(TEXT("AnimationInput"), Result.AnimationInput);
+			JsonResult->SetNumberField(TEXT("Characters"), Result.Count);
+			JsonResult->SetNumberField(TEXT("Frames"), Result.FrameTimes.Num());
+			JsonResult->SetNumberField(TEXT("MeanFrameMs"), Mean);
+			JsonResult->SetNumberField(TEXT("MedianFrameMs"), Result.GetPercentile(0.5));
+			JsonResult->SetNumberField(TEXT("P95FrameMs"), Result.GetPercentile(0.95));
+			JsonResult->SetNumberField(TEXT("MaxFrameMs"), Result.GetPercentile(1.0));
+			JsonResult->SetNumberField(TEXT("MeanCharacterUs"), MeanPerCharacter);
+			JsonResult->SetNumberField(TEXT("AnimationGameThreadUs"), Result.GetAnimationGameThreadTimePerInstance());
+
+			const auto JsonStats{MakeShared<FJsonObject>()};
+
+			for (const auto& StatTime : Result.StatTimes)
+			{
+				const auto JsonStat{MakeShared<FJsonObject>()};
+				JsonStat->SetNumberField(TEXT("MeanFrameMs"), StatTime.Value.Key);
+				JsonStat->SetNumberField(TEXT("MeanFrameCalls"), StatTime.Value.Value);
+
+				JsonStats->SetObjectField(StatTime.Key.ToString(), JsonStat);
+			}
+
+			JsonResult->SetObjectField(TEXT("Stats"), JsonStats);
+
+			JsonResults.Add(MakeShared<FJsonValueObject>(JsonResult));
+		}
+
+		const auto Json{MakeShared<FJsonObject>()};
+		Json->SetStringField(TEXT("Character"), Settings.CharacterClass->GetPathName());
+		Json->SetNumberField(TEXT("DeltaTime"), Settings.DeltaTime);
+		Json->SetNumberField(TEXT("WarmupFrames"), Settings.WarmupFrames);
+		Json->SetArrayField(TEXT("Results"), JsonResults);
+
+		FString JsonString;
+		FJsonSerializer::Serialize(Json, TJsonWriterFactory<>::Create(&JsonString));
+
+		FFileHelper::SaveStringToFile(Csv, *(OutputPath + TEXT(".csv")));
+		FFileHelper::SaveStringToFile(JsonString, *(OutputPath + TEXT(".json")));
+
+		UE_LOG(LogAls, Display, TEXT("Benchmark results written to %s.csv and %s.json:\n%s"), *OutputPath, *OutputPath, *Csv);
+	}
+}
+
+UAlsBenchmarkCommandlet::UAlsBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = true;
+	LogToConsole = true;
+}
+
+int32 UAlsBenchmarkCommandlet::Main(const FString& Parameters)
+{
+	using namespace AlsBenchmarkCommandlet;
+
+	FSettings Settings;
+
+	FString CharacterClassPath{TEXT("/ALS/Game/Blueprints/Characters/B_Als_Character.B_Als_Character_C")};
+	FParse::Value(*Parameters, TEXT("Character="), CharacterClassPath);
+
+	Settings.CharacterClass = LoadClass<AAlsCharacter>(nullptr, *CharacterClassPath);
+	if (Settings.CharacterClass == nullptr)
+	{
+		UE_LOG(LogAls, Error, TEXT("Character class %s could not be loaded."), *CharacterClassPath);
+		return 1;
+	}
+
+	FParse::Value(*Parameters, TEXT("Count="), Settings.Count);
+	FParse::Value(*Parameters, TEXT("Frames="), Settings.Frames);
+	FParse::Value(*Parameters, TEXT("WarmupFrames="), Settings.WarmupFrames);
+	FParse::Value(*Parameters, TEXT("DeltaTime="), Settings.DeltaTime);
+
+	Settings.Count = FMath::Max(1, Settings.Count);
+	Settings.Frames = FMath::Max(1, Settings.Frames);
+	Settings.WarmupFrames = FMath::Max(0, Settings.WarmupFrames);
+	Settings.DeltaTime = FMath::Max(UE_KINDA_SMALL_NUMBER, Settings.DeltaTime);
+
+	Settings.bCompareAnimationInput = FParse::Param(*Parameters, TEXT("CompareAnimationInput"));
+
+	auto* UseCharacterInputSnapshotConsoleVariable{
+		IConsoleManager::Get().FindConsoleVariable(TEXT("Als.Animation.UseCharacterInputSnapshot"))
+	};
+
+	if (Settings.bCompareAnimationInput && UseCharacterInputSnapshotConsoleVariable == nullptr)
+	{
+		UE_LOG(LogAls, Error, TEXT("Console variable Als.Animation.UseCharacterInputSnapshot could not be found."));
+		return 1;
+	}
+
+	FString ScenariosString;
+	TArray<FString> ScenarioNamesToRun;
+
+	if (FParse::Value(*Parameters, TEXT("Scenarios="), ScenariosString, false))
+	{
+		ScenariosString.ParseIntoArray(ScenarioNamesToRun, TEXT(","));
+	}
+
+	TArray<FResult> Results;
+
+	for (auto i{0}; i < ScenariosCount; i++)
+	{
+		if (ScenarioNamesToRun.IsEmpty() || ScenarioNamesToRun.Contains(ScenarioNames[i]))
+		{
+			if (!Settings.bCompareAnimationInput)
+			{
+				UE_LOG(LogAls, Display, TEXT("Running the %s scenario with %d characters..."), ScenarioNames[i], Settings.Count);
+
+				auto& Result{Results.Add_GetRef(RunScenario(Settings, static_cast<EScenario>(i)))};
+
+				Result.AnimationInput = UseCharacterInputSnapshotConsoleVariable == nullptr ||
+				                        UseCharacterInputSnapshotConsoleVariable->GetBool()
+					                        ? TEXT("Snapshot")
+					                        : TEXT("Gathered");
+				continue;
+			}
+
+			const auto bPreviousUseCharacterInputSnapshot{UseCharacterInputSnapshotConsoleVariable->GetBool()};
+
+			for (const auto bUseCharacterInputSnapshot : {false, true})
+			{
+				const auto* AnimationInput{bUseCharacterInputSnapshot ? TEXT("Snapshot") : TEXT("Gathered")};
+
+				UE_LOG(LogAls, Display, TEXT("Running the %s scenario with %d characters and %s animation input..."),
+				       ScenarioNames[i], Settings.Count, AnimationInput);
+
+				UseCharacterInputSnapshotConsoleVariable->Set(bUseCharacterInputSnapshot, ECVF_SetByCode);
+
+				auto& Result{Results.Add_GetRef(RunScenario(Settings, static_cast<EScenario>(i)))};
+				Result.AnimationInput = AnimationInput;
+			}
+
+			UseCharacterInputSnapshotConsoleVariable->Set(bPreviousUseCharacterInputSnapshot, ECVF_SetByCode);
+		}
+	}
+
+	if (Results.IsEmpty())
+	{
+		UE_LOG(LogAls, Error, TEXT("No known scenarios in %s."), *ScenariosString);
+		return 1;
+	}
+
+	FString OutputPath{
+		FPaths::ProjectSavedDir() / TEXT("Als") / FString::Printf(TEXT("Benchmark-%s"), *FDateTime::Now().ToString())
+	};
+
+	FParse::Value(*Parameters, TEXT("Output="), OutputPath);
+
+	WriteResults(OutputPath, Settings, Results);
+
+	return 0;
+}
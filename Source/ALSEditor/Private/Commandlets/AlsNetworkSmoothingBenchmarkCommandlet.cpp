@@ -0,0 +1,458 @@
+﻿#include "Commandlets/AlsNetworkSmoothingBenchmarkCommandlet.h"
+
+#include "AlsCharacter.h"
+#include "AlsNetworkSmoothingSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectGlobals.h"
+#include "Utility/AlsLog.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsNetworkSmoothingBenchmarkCommandlet)
+
+namespace AlsNetworkSmoothingBenchmarkCommandlet
+{
+	struct FScenario
+	{
+		const TCHAR* Name;
+
+		ENetworkSmoothingMode SmoothingMode;
+	};
+
+	static const FScenario Scenarios[]{
+		{TEXT("Linear"), ENetworkSmoothingMode::Linear},
+		{TEXT("Exponential"), ENetworkSmoothingMode::Exponential}
+	};
+
+	struct FSettings
+	{
+		TSubclassOf<AAlsCharacter> CharacterClass;
+
+		int32 Count{300};
+
+		int32 Frames{600};
+
+		int32 WarmupFrames{60};
+
+		float DeltaTime{1.0f / 60.0f};
+
+		// Time between two network updates of the same simulated proxy.
+		float UpdateInterval{0.1f};
+	};
+
+	struct FResult
+	{
+		FString Scenario;
+
+		bool bBatched{false};
+
+		int32 Count{0};
+
+		// Wall time of each measured world tick in milliseconds.
+		TArray<double> FrameTimes;
+
+		int64 BatchedSmoothingsCount{0};
+
+		// Mesh locations of all simulated proxies after the last frame.
+		TArray<FVector> MeshLocations;
+
+		// Maximum distance between the mesh locations of this run and the same run without batching.
+		double MaxMeshLocationDifference{0.0};
+
+		double GetMean() const;
+
+		double GetPercentile(double Percentile) const;
+	};
+
+	// Simulated proxies don't collide with each other, so they can be packed densely without affecting each other's movement.
+	static constexpr auto CharacterSpacing{400.0f};
+
+	// Simulated proxies run along a square, so that the mesh rotation offset is smoothed as well as the mesh translation offset.
+	static constexpr auto PathSpeed{375.0f};
+
+	static constexpr auto DirectionChangeInterval{2.0f};
+
+	// Maximum distance between the replicated location and the path, which emulates network quantization and
+	// latency jitter, so that the locally extrapolated location keeps diverging and the smoothing never completes.
+	static constexpr auto UpdateJitter{20.0f};
+
+	double FResult::GetMean() const
+	{
+		auto Sum{0.0};
+
+		for (const auto FrameTime : FrameTimes)
+		{
+			Sum += FrameTime;
+		}
+
+		return FrameTimes.IsEmpty() ? 0.0 : Sum / FrameTimes.Num();
+	}
+
+	double FResult::GetPercentile(const double Percentile) const
+	{
+		if (FrameTimes.IsEmpty())
+		{
+			return 0.0;
+		}
+
+		auto SortedFrameTimes{FrameTimes};
+		SortedFrameTimes.Sort();
+
+		const auto Index{FMath::Clamp(FMath::CeilToInt32(Percentile * SortedFrameTimes.Num()) - 1, 0, SortedFrameTimes.Num() - 1)};
+		return SortedFrameTimes[Index];
+	}
+
+	static void SpawnBox(UWorld* World, UStaticMesh* BoxMesh, const FVector& Location, const FVector& Scale)
+	{
+		auto* Box{World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator)};
+		if (!IsValid(Box))
+		{
+			return;
+		}
+
+		auto* BoxComponent{Box->GetStaticMeshComponent()};
+
+		// Static components can't change their mesh at runtime.
+
+		BoxComponent->SetMobility(EComponentMobility::Movable);
+		BoxComponent->SetStaticMesh(BoxMesh);
+		BoxComponent->SetWorldScale3D(Scale);
+	}
+
+	static void CalculatePathState(const float Time, const FVector& StartLocation, FVector& Location, FRotator& Rotation, FVector& Velocity)
+	{
+		const auto SideLength{PathSpeed * DirectionChangeInterval};
+		const auto DirectionIndex{FMath::FloorToInt32(Time / DirectionChangeInterval) % 4};
+
+		Location = StartLocation;
+
+		for (auto i{0}; i < DirectionIndex; i++)
+		{
+			Location += FRotator{0.0f, i * 90.0f, 0.0f}.Vector() * SideLength;
+		}
+
+		Rotation = {0.0f, DirectionIndex * 90.0f, 0.0f};
+		Velocity = Rotation.Vector() * PathSpeed;
+
+		Location += Velocity * FMath::Fmod(Time, DirectionChangeInterval);
+	}
+
+	static FResult RunScenario(const FSettings& Settings, const FScenario& Scenario, const bool bBatched)
+	{
+		FResult Result;
+		Result.Scenario = Scenario.Name;
+		Result.bBatched = bBatched;
+		Result.Count = Settings.Count;
+
+		auto* World{
+			UWorld::CreateWorld(EWorldType::Game, false, *FString::Printf(TEXT("AlsNetworkSmoothingBenchmark_%s"), Scenario.Name))
+		};
+
+		auto& WorldContext{GEngine->CreateNewWorldContext(EWorldType::Game)};
+		WorldContext.SetCurrentWorld(World);
+
+		// Generate a flat map large enough for all paths.
+
+		const auto GridSize{FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Settings.Count)))};
+		const auto GridExtent{GridSize * CharacterSpacing + PathSpeed * DirectionChangeInterval};
+
+		auto* BoxMesh{LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"))};
+		if (IsValid(BoxMesh))
+		{
+			// The box mesh is 100 units in size, so the top of the floor is at zero height.
+
+			SpawnBox(World, BoxMesh, {GridExtent * 0.5f, GridExtent * 0.5f, -50.0f},
+			         {(GridExtent + CharacterSpacing * 4.0f) / 100.0f, (GridExtent + CharacterSpacing * 4.0f) / 100.0f, 1.0f});
+		}
+
+		TArray<TPair<AAlsCharacter*, FVector>> Characters;
+		Characters.Reserve(Settings.Count);
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		for (auto i{0}; i < Settings.Count; i++)
+		{
+			const FVector StartLocation{
+				(i % GridSize + 0.5f) * CharacterSpacing, (i / GridSize + 0.5f) * CharacterSpacing, 100.0f
+			};
+
+			auto* Character{World->SpawnActor<AAlsCharacter>(Settings.CharacterClass, StartLocation, FRotator::ZeroRotator, SpawnParameters)};
+			if (!IsValid(Character))
+			{
+				continue;
+			}
+
+			Character->GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+
+			// Nothing is rendered with -nullrhi, so animation would otherwise be skipped.
+
+			Character->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+			Character->GetCharacterMovement()->NetworkSmoothingMode = Scenario.SmoothingMode;
+
+			// There is no net driver in this world, so the character is turned into a simulated proxy
+			// manually, and its network updates are emulated the same way as in ACharacter::PostNetReceiveLocationAndRotation().
+
+			Character->SetRole(ROLE_SimulatedProxy);
+
+			Characters.Emplace(Character, StartLocation);
+		}
+
+		World->InitializeActorsForPlay(FURL{});
+		World->BeginPlay();
+
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(Settings.DeltaTime);
+
+		const auto UpdateFrames{FMath::Max(1, FMath::RoundToInt32(Settings.UpdateInterval / Settings.DeltaTime))};
+		const auto* NetworkSmoothingSubsystem{World->GetSubsystem<UAlsNetworkSmoothingSubsystem>()};
+
+		for (auto Frame{0}; Frame < Settings.WarmupFrames + Settings.Frames; Frame++)
+		{
+			for (auto i{0}; i < Characters.Num(); i++)
+			{
+				auto* Character{Characters[i].Key};
+				auto* Movement{Character->GetCharacterMovement()};
+
+				// Smoothing of meshes that were not rendered recently is skipped, so pretend that all of them are visible.
+
+				Character->GetMesh()->SetLastRenderTime(World->GetTimeSeconds());
+
+				// Offset the network updates of each simulated proxy, so that they don't all receive them in the same frame.
+
+				if ((Frame + i) % UpdateFrames != 0)
+				{
+					continue;
+				}
+
+				FVector NewLocation;
+				FRotator NewRotation;
+				FVector NewVelocity;
+
+				CalculatePathState((Frame + i * 7) * Settings.DeltaTime, Characters[i].Value, NewLocation, NewRotation, NewVelocity);
+
+				// The jitter is seeded from the frame and the simulated proxy index, so that all runs receive the same updates.
+
+				const FRandomStream RandomStream{Frame * Settings.Count + i};
+				NewLocation += FVector{RandomStream.FRandRange(-1.0f, 1.0f), RandomStream.FRandRange(-1.0f, 1.0f), 0.0f} * UpdateJitter;
+
+				const auto OldLocation{Character->GetActorLocation()};
+				const auto OldRotation{Character->GetActorQuat()};
+
+				Movement->Velocity = NewVelocity;
+				Movement->bNetworkSmoothingComplete = false;
+				Movement->SmoothCorrection(OldLocation, OldRotation, NewLocation, NewRotation.Quaternion());
+			}
+
+			FApp::SetDeltaTime(Settings.DeltaTime);
+			FApp::SetCurrentTime(FApp::GetCurrentTime() + Settings.DeltaTime);
+
+			const auto StartCycles{FPlatformTime::Cycles64()};
+
+			World->Tick(LEVELTICK_All, Settings.DeltaTime);
+
+			const auto FrameTime{FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles)};
+
+			GFrameCounter += 1;
+
+			if (Frame >= Settings.WarmupFrames)
+			{
+				Result.FrameTimes.Add(FrameTime);
+
+				if (IsValid(NetworkSmoothingSubsystem))
+				{
+					Result.BatchedSmoothingsCount += NetworkSmoothingSubsystem->GetLastBatchSize();
+				}
+			}
+		}
+
+		Result.MeshLocations.Reserve(Characters.Num());
+
+		for (const auto& Character : Characters)
+		{
+			Result.MeshLocations.Add(Character.Key->GetMesh()->GetComponentLocation());
+		}
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		return Result;
+	}
+
+	static void WriteResults(const FString& OutputPath, const FSettings& Settings, const TConstArrayView<FResult> Results)
+	{
+		FString Csv{
+			TEXT("Scenario,Batched,Proxies,Frames,MeanFrameMs,MedianFrameMs,P95FrameMs,MaxFrameMs,MeanProxyUs,")
+			TEXT("MeanBatchSize,MaxMeshLocationDifference\n")
+		};
+
+		TArray<TSharedPtr<FJsonValue>> JsonResults;
+
+		for (const auto& Result : Results)
+		{
+			const auto Mean{Result.GetMean()};
+			const auto MeanPerProxy{Result.Count > 0 ? Mean * 1000.0 / Result.Count : 0.0};
+
+			const auto MeanBatchSize{
+				Result.FrameTimes.IsEmpty() ? 0.0 : static_cast<double>(Result.BatchedSmoothingsCount) / Result.FrameTimes.Num()
+			};
+
+			Csv += FString::Printf(TEXT("%s,%d,%d,%d,%.4f,%.4f,%.4f,%.4f,%.3f,%.2f,%.6f\n"), *Result.Scenario, Result.bBatched ? 1 : 0,
+			                       Result.Count, Result.FrameTimes.Num(), Mean, Result.GetPercentile(0.5), Result.GetPercentile(0.95),
+			                       Result.GetPercentile(1.0), MeanPerProxy, MeanBatchSize, Result.MaxMeshLocationDifference);
+
+			const auto JsonResult{MakeShared<FJsonObject>()};
+			JsonResult->SetStringField(TEXT("Scenario"), Result.Scenario);
+			JsonResult->SetBoolField(TEXT("Batched"), Result.bBatched);
+			JsonResult->SetNumberField(TEXT("Proxies"), Result.Count);
+			JsonResult->SetNumberField(TEXT("Frames"), Result.FrameTimes.Num());
+			JsonResult->SetNumberField(TEXT("MeanFrameMs"), Mean);
+			JsonResult->SetNumberField(TEXT("MedianFrameMs"), Result.GetPercentile(0.5));
+			JsonResult->SetNumberField(TEXT("P95FrameMs"), Result.GetPercentile(0.95));
+			JsonResult->SetNumberField(TEXT("MaxFrameMs"), Result.GetPercentile(1.0));
+			JsonResult->SetNumberField(TEXT("MeanProxyUs"), MeanPerProxy);
+			JsonResult->SetNumberField(TEXT("MeanBatchSize"), MeanBatchSize);
+			JsonResult->SetNumberField(TEXT("MaxMeshLocationDifference"), Result.MaxMeshLocationDifference);
+
+			JsonResults.Add(MakeShared<FJsonValueObject>(JsonResult));
+		}
+
+		const auto Json{MakeShared<FJsonObject>()};
+		Json->SetStringField(TEXT("Character"), Settings.CharacterClass->GetPathName());
+		Json->SetNumberField(TEXT("DeltaTime"), Settings.DeltaTime);
+		Json->SetNumberField(TEXT("UpdateInterval"), Settings.UpdateInterval);
+		Json->SetNumberField(TEXT("WarmupFrames"), Settings.WarmupFrames);
+		Json->SetArrayField(TEXT("Results"), JsonResults);
+
+		FString JsonString;
+		FJsonSerializer::Serialize(Json, TJsonWriterFactory<>::Create(&JsonString));
+
+		FFileHelper::SaveStringToFile(Csv, *(OutputPath + TEXT(".csv")));
+		FFileHelper::SaveStringToFile(JsonString, *(OutputPath + TEXT(".json")));
+
+		UE_LOG(LogAls, Display, TEXT("Benchmark results written to %s.csv and %s.json:\n%s"), *OutputPath, *OutputPath, *Csv);
+	}
+}
+
+UAlsNetworkSmoothingBenchmarkCommandlet::UAlsNetworkSmoothingBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = true;
+	LogToConsole = true;
+}
+
+int32 UAlsNetworkSmoothingBenchmarkCommandlet::Main(const FString& Parameters)
+{
+	using namespace AlsNetworkSmoothingBenchmarkCommandlet;
+
+	FSettings Settings;
+
+	FString CharacterClassPath{TEXT("/ALS/Game/Blueprints/Characters/B_Als_Character.B_Als_Character_C")};
+	FParse::Value(*Parameters, TEXT("Character="), CharacterClassPath);
+
+	Settings.CharacterClass = LoadClass<AAlsCharacter>(nullptr, *CharacterClassPath);
+	if (Settings.CharacterClass == nullptr)
+	{
+		UE_LOG(LogAls, Error, TEXT("Character class %s could not be loaded."), *CharacterClassPath);
+		return 1;
+	}
+
+	auto* BatchNetworkSmoothingConsoleVariable{IConsoleManager::Get().FindConsoleVariable(TEXT("Als.Movement.BatchNetworkSmoothing"))};
+	if (BatchNetworkSmoothingConsoleVariable == nullptr)
+	{
+		UE_LOG(LogAls, Error, TEXT("Console variable Als.Movement.BatchNetworkSmoothing could not be found."));
+		return 1;
+	}
+
+	FParse::Value(*Parameters, TEXT("Count="), Settings.Count);
+	FParse::Value(*Parameters, TEXT("Frames="), Settings.Frames);
+	FParse::Value(*Parameters, TEXT("WarmupFrames="), Settings.WarmupFrames);
+	FParse::Value(*Parameters, TEXT("DeltaTime="), Settings.DeltaTime);
+	FParse::Value(*Parameters, TEXT("UpdateInterval="), Settings.UpdateInterval);
+
+	Settings.Count = FMath::Max(1, Settings.Count);
+	Settings.Frames = FMath::Max(1, Settings.Frames);
+	Settings.WarmupFrames = FMath::Max(0, Settings.WarmupFrames);
+	Settings.DeltaTime = FMath::Max(UE_KINDA_SMALL_NUMBER, Settings.DeltaTime);
+	Settings.UpdateInterval = FMath::Max(Settings.DeltaTime, Settings.UpdateInterval);
+
+	FString ModesString;
+	TArray<FString> ModeNamesToRun;
+
+	if (FParse::Value(*Parameters, TEXT("Modes="), ModesString, false))
+	{
+		ModesString.ParseIntoArray(ModeNamesToRun, TEXT(","));
+	}
+
+	const auto bPreviousBatchNetworkSmoothing{BatchNetworkSmoothingConsoleVariable->GetBool()};
+
+	TArray<FResult> Results;
+
+	for (const auto& Scenario : Scenarios)
+	{
+		if (!ModeNamesToRun.IsEmpty() && !ModeNamesToRun.Contains(Scenario.Name))
+		{
+			continue;
+		}
+
+		UE_LOG(LogAls, Display, TEXT("Running the %s scenario with %d simulated proxies..."), Scenario.Name, Settings.Count);
+
+		BatchNetworkSmoothingConsoleVariable->Set(false, ECVF_SetByCode);
+
+		const auto& UnbatchedResult{Results.Add_GetRef(RunScenario(Settings, Scenario, false))};
+
+		BatchNetworkSmoothingConsoleVariable->Set(true, ECVF_SetByCode);
+
+		auto BatchedResult{RunScenario(Settings, Scenario, true)};
+
+		// Batching must not change the smoothing itself, only where it is computed.
+
+		for (auto i{0}; i < FMath::Min(UnbatchedResult.MeshLocations.Num(), BatchedResult.MeshLocations.Num()); i++)
+		{
+			BatchedResult.MaxMeshLocationDifference = FMath::Max(BatchedResult.MaxMeshLocationDifference,
+			                                                     FVector::Dist(UnbatchedResult.MeshLocations[i],
+			                                                                   BatchedResult.MeshLocations[i]));
+		}
+
+		if (BatchedResult.BatchedSmoothingsCount <= 0)
+		{
+			UE_LOG(LogAls, Warning, TEXT("No network smoothing was batched in the %s scenario."), Scenario.Name);
+		}
+
+		Results.Add(MoveTemp(BatchedResult));
+	}
+
+	BatchNetworkSmoothingConsoleVariable->Set(bPreviousBatchNetworkSmoothing, ECVF_SetByCode);
+
+	if (Results.IsEmpty())
+	{
+		UE_LOG(LogAls, Error, TEXT("No known modes in %s."), *ModesString);
+		return 1;
+	}
+
+	FString OutputPath{
+		FPaths::ProjectSavedDir() / TEXT("Als") / FString::Printf(TEXT("NetworkSmoothingBenchmark-%s"), *FDateTime::Now().ToString())
+	};
+
+	FParse::Value(*Parameters, TEXT("Output="), OutputPath);
+
+	WriteResults(OutputPath, Settings, Results);
+
+	return 0;
+}
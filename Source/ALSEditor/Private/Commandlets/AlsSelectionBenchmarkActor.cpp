@@ -0,0 +1,21 @@
+﻿#include "Commandlets/AlsSelectionBenchmarkActor.h"
+
+#include "Components/SceneComponent.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsSelectionBenchmarkActor)
+
+AAlsSelectionBenchmarkActor::AAlsSelectionBenchmarkActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void AAlsSelectionBenchmarkActor::OnSelectedByMarquee_Implementation(APlayerController* SelectingPlayer) {}
+
+void AAlsSelectionBenchmarkActor::OnDeselectedByMarquee_Implementation(APlayerController* SelectingPlayer) {}
+
+bool AAlsSelectionBenchmarkActor::IsCurrentlySelectableByMarquee_Implementation(APlayerController* SelectingPlayer) const
+{
+	return true;
+}
@@ -0,0 +1,21 @@
+﻿#pragma once
+
+#include "GameFramework/Actor.h"
+#include "Interfaces/SelectableActorInterface.h"
+#include "AlsSelectionBenchmarkActor.generated.h"
+
+// Minimal selectable actor spawned by the selection benchmark commandlet.
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class AAlsSelectionBenchmarkActor : public AActor, public ISelectableActorInterface
+{
+	GENERATED_BODY()
+
+public:
+	AAlsSelectionBenchmarkActor();
+
+	virtual void OnSelectedByMarquee_Implementation(APlayerController* SelectingPlayer) override;
+
+	virtual void OnDeselectedByMarquee_Implementation(APlayerController* SelectingPlayer) override;
+
+	virtual bool IsCurrentlySelectableByMarquee_Implementation(APlayerController* SelectingPlayer) const override;
+};
@@ -0,0 +1,344 @@
+﻿#include "Commandlets/AlsSelectionBenchmarkCommandlet.h"
+
+#include "Commandlets/AlsSelectionBenchmarkActor.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Math/InverseRotationMatrix.h"
+#include "Math/PerspectiveMatrix.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "SceneView.h"
+#include "Serialization/JsonSerializer.h"
+#include "Subsystems/SelectableActorSubsystem.h"
+#include "UObject/UObjectGlobals.h"
+#include "Utility/AlsLog.h"
+#include "Utility/AlsMacros.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsSelectionBenchmarkCommandlet)
+
+namespace AlsSelectionBenchmarkCommandlet
+{
+	struct FScenario
+	{
+		const TCHAR* Name;
+
+		// Marquee size relative to the view size.
+		float MarqueeScale;
+
+		float CameraPitch;
+	};
+
+	// The horizon scenario looks at the grid at a shallow angle, so the upper corner rays of the
+	// marquee never reach the ground and the subsystem has to fall back to testing every non-empty cell.
+	static const FScenario Scenarios[]{
+		{TEXT("Small"), 0.1f, -60.0f},
+		{TEXT("Medium"), 0.4f, -60.0f},
+		{TEXT("FullScreen"), 1.0f, -60.0f},
+		{TEXT("Horizon"), 1.0f, -15.0f}
+	};
+
+	struct FSettings
+	{
+		int32 Count{10000};
+
+		int32 Queries{1000};
+	};
+
+	struct FResult
+	{
+		FString Scenario;
+
+		int32 Count{0};
+
+		// Wall time of each query through the selectable actor subsystem in microseconds.
+		TArray<double> SubsystemQueryTimes;
+
+		// Wall time of each query that projects every actor in the world to the screen in microseconds.
+		TArray<double> ProjectionQueryTimes;
+
+		int64 SubsystemSelectedCount{0};
+
+		int64 ProjectionSelectedCount{0};
+	};
+
+	static constexpr auto ActorSpacing{200.0f};
+
+	static constexpr auto CameraDistance{5000.0f};
+
+	static constexpr auto ViewWidth{1920};
+
+	static constexpr auto ViewHeight{1080};
+
+	static constexpr auto FieldOfView{90.0f};
+
+	static double GetMean(const TConstArrayView<double> Times)
+	{
+		auto Sum{0.0};
+
+		for (const auto Time : Times)
+		{
+			Sum += Time;
+		}
+
+		return Times.IsEmpty() ? 0.0 : Sum / Times.Num();
+	}
+
+	static double GetPercentile(const TConstArrayView<double> Times, const double Percentile)
+	{
+		if (Times.IsEmpty())
+		{
+			return 0.0;
+		}
+
+		TArray<double> SortedTimes{Times};
+		SortedTimes.Sort();
+
+		const auto Index{FMath::Clamp(FMath::CeilToInt32(Percentile * SortedTimes.Num()) - 1, 0, SortedTimes.Num() - 1)};
+		return SortedTimes[Index];
+	}
+
+	static FSceneViewProjectionData MakeProjectionData(const FVector& TargetLocation, const float CameraPitch)
+	{
+		const FRotator CameraRotation{CameraPitch, 45.0f, 0.0f};
+
+		FSceneViewProjectionData ProjectionData;
+		ProjectionData.ViewOrigin = TargetLocation - CameraRotation.Vector() * CameraDistance;
+
+		// Same view and projection matrices that the local player builds for a perspective camera.
+
+		ProjectionData.ViewRotationMatrix = FInverseRotationMatrix{CameraRotation} * FMatrix{
+			FPlane{0.0f, 0.0f, 1.0f, 0.0f},
+			FPlane{1.0f, 0.0f, 0.0f, 0.0f},
+			FPlane{0.0f, 1.0f, 0.0f, 0.0f},
+			FPlane{0.0f, 0.0f, 0.0f, 1.0f}
+		};
+
+		ProjectionData.ProjectionMatrix = FReversedZPerspectiveMatrix{
+			FMath::DegreesToRadians(FieldOfView * 0.5f), static_cast<float>(ViewWidth), static_cast<float>(ViewHeight), GNearClippingPlane
+		};
+
+		ProjectionData.SetViewRectangle({0, 0, ViewWidth, ViewHeight});
+
+		return ProjectionData;
+	}
+
+	// Marquee selection before the selectable actor subsystem: every actor in the world is checked
+	// for the selectable interface and projected to the screen to test whether it is inside the marquee.
+	static int32 QueryActorsByProjection(UWorld* World, const FSceneViewProjectionData& ProjectionData,
+	                                     const FVector2D& MarqueeMin, const FVector2D& MarqueeMax)
+	{
+		const auto ViewProjectionMatrix{ProjectionData.ComputeViewProjectionMatrix()};
+		const auto ViewRect{ProjectionData.GetConstrainedViewRect()};
+
+		auto SelectedCount{0};
+
+		for (TActorIterator<AActor> Iterator{World}; Iterator; ++Iterator)
+		{
+			if (!Iterator->Implements<USelectableActorInterface>())
+			{
+				continue;
+			}
+
+			FVector2D ScreenLocation;
+
+			if (FSceneView::ProjectWorldToScreen(Iterator->GetActorLocation(), ViewRect, ViewProjectionMatrix, ScreenLocation) &&
+			    ScreenLocation.X >= MarqueeMin.X && ScreenLocation.X <= MarqueeMax.X &&
+			    ScreenLocation.Y >= MarqueeMin.Y && ScreenLocation.Y <= MarqueeMax.Y)
+			{
+				SelectedCount += 1;
+			}
+		}
+
+		return SelectedCount;
+	}
+
+	static FResult RunScenario(const FSettings& Settings, const FScenario& Scenario)
+	{
+		FResult Result;
+		Result.Scenario = Scenario.Name;
+		Result.Count = Settings.Count;
+
+		auto* World{UWorld::CreateWorld(EWorldType::Game, false, *FString::Printf(TEXT("AlsSelectionBenchmark_%s"), Scenario.Name))};
+		auto& WorldContext{GEngine->CreateNewWorldContext(EWorldType::Game)};
+		WorldContext.SetCurrentWorld(World);
+
+		const auto GridSize{FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Settings.Count)))};
+		const auto GridExtent{GridSize * ActorSpacing};
+
+		for (auto i{0}; i < Settings.Count; i++)
+		{
+			// The subsystem registers selectable actors as soon as they are spawned.
+
+			World->SpawnActor<AAlsSelectionBenchmarkActor>(FVector{
+				                                               (i % GridSize + 0.5f) * ActorSpacing, (i / GridSize + 0.5f) * ActorSpacing, 0.0f
+			                                               }, FRotator::ZeroRotator);
+		}
+
+		World->InitializeActorsForPlay(FURL{});
+		World->BeginPlay();
+
+		auto* SelectableActorSubsystem{World->GetSubsystem<USelectableActorSubsystem>()};
+		if (!ALS_ENSURE(IsValid(SelectableActorSubsystem)))
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+			return Result;
+		}
+
+		const auto ProjectionData{MakeProjectionData({GridExtent * 0.5f, GridExtent * 0.5f, 0.0f}, Scenario.CameraPitch)};
+		const FVector2D MarqueeSize{ViewWidth * Scenario.MarqueeScale, ViewHeight * Scenario.MarqueeScale};
+
+		// The same marquees are used for each scenario and each query method.
+
+		FRandomStream RandomStream{0};
+
+		Result.SubsystemQueryTimes.Reserve(Settings.Queries);
+		Result.ProjectionQueryTimes.Reserve(Settings.Queries);
+
+		TArray<AActor*> SelectedActors;
+
+		for (auto i{0}; i < Settings.Queries; i++)
+		{
+			const FVector2D MarqueeMin{
+				RandomStream.FRandRange(0.0f, ViewWidth - MarqueeSize.X), RandomStream.FRandRange(0.0f, ViewHeight - MarqueeSize.Y)
+			};
+
+			const auto MarqueeMax{MarqueeMin + MarqueeSize};
+
+			SelectedActors.Reset();
+
+			auto StartCycles{FPlatformTime::Cycles64()};
+
+			FMarqueeFrustum MarqueeFrustum;
+			if (USelectableActorSubsystem::BuildMarqueeFrustum(ProjectionData, MarqueeMin, MarqueeMax, MarqueeFrustum))
+			{
+				SelectableActorSubsystem->QueryActorsInFrustum(MarqueeFrustum, SelectedActors);
+			}
+
+			Result.SubsystemQueryTimes.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+			Result.SubsystemSelectedCount += SelectedActors.Num();
+
+			StartCycles = FPlatformTime::Cycles64();
+
+			const auto ProjectionSelectedCount{QueryActorsByProjection(World, ProjectionData, MarqueeMin, MarqueeMax)};
+
+			Result.ProjectionQueryTimes.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+			Result.ProjectionSelectedCount += ProjectionSelectedCount;
+		}
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		return Result;
+	}
+
+	static void WriteResults(const FString& OutputPath, const FSettings& Settings, const TConstArrayView<FResult> Results)
+	{
+		FString Csv{
+			TEXT("Scenario,Actors,Queries,MeanSubsystemUs,P95SubsystemUs,MeanProjectionUs,P95ProjectionUs,")
+			TEXT("MeanSubsystemSelected,MeanProjectionSelected\n")
+		};
+
+		TArray<TSharedPtr<FJsonValue>> JsonResults;
+
+		for (const auto& Result : Results)
+		{
+			const auto QueriesCount{FMath::Max(1, Result.SubsystemQueryTimes.Num())};
+			const auto MeanSubsystemSelected{static_cast<double>(Result.SubsystemSelectedCount) / QueriesCount};
+			const auto MeanProjectionSelected{static_cast<double>(Result.ProjectionSelectedCount) / QueriesCount};
+
+			Csv += FString::Printf(TEXT("%s,%d,%d,%.3f,%.3f,%.3f,%.3f,%.2f,%.2f\n"), *Result.Scenario, Result.Count,
+			                       Result.SubsystemQueryTimes.Num(), GetMean(Result.SubsystemQueryTimes),
+			                       GetPercentile(Result.SubsystemQueryTimes, 0.95), GetMean(Result.ProjectionQueryTimes),
+			                       GetPercentile(Result.ProjectionQueryTimes, 0.95), MeanSubsystemSelected, MeanProjectionSelected);
+
+			const auto JsonResult{MakeShared<FJsonObject>()};
+			JsonResult->SetStringField(TEXT("Scenario"), Result.Scenario);
+			JsonResult->SetNumberField(TEXT("Actors"), Result.Count);
+			JsonResult->SetNumberField(TEXT("Queries"), Result.SubsystemQueryTimes.Num());
+			JsonResult->SetNumberField(TEXT("MeanSubsystemUs"), GetMean(Result.SubsystemQueryTimes));
+			JsonResult->SetNumberField(TEXT("P95SubsystemUs"), GetPercentile(Result.SubsystemQueryTimes, 0.95));
+			JsonResult->SetNumberField(TEXT("MeanProjectionUs"), GetMean(Result.ProjectionQueryTimes));
+			JsonResult->SetNumberField(TEXT("P95ProjectionUs"), GetPercentile(Result.ProjectionQueryTimes, 0.95));
+			JsonResult->SetNumberField(TEXT("MeanSubsystemSelected"), MeanSubsystemSelected);
+			JsonResult->SetNumberField(TEXT("MeanProjectionSelected"), MeanProjectionSelected);
+
+			JsonResults.Add(MakeShared<FJsonValueObject>(JsonResult));
+		}
+
+		const auto Json{MakeShared<FJsonObject>()};
+		Json->SetNumberField(TEXT("Actors"), Settings.Count);
+		Json->SetNumberField(TEXT("Queries"), Settings.Queries);
+		Json->SetArrayField(TEXT("Results"), JsonResults);
+
+		FString JsonString;
+		FJsonSerializer::Serialize(Json, TJsonWriterFactory<>::Create(&JsonString));
+
+		FFileHelper::SaveStringToFile(Csv, *(OutputPath + TEXT(".csv")));
+		FFileHelper::SaveStringToFile(JsonString, *(OutputPath + TEXT(".json")));
+
+		UE_LOG(LogAls, Display, TEXT("Selection benchmark results written to %s.csv and %s.json:\n%s"), *OutputPath, *OutputPath, *Csv);
+	}
+}
+
+UAlsSelectionBenchmarkCommandlet::UAlsSelectionBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = true;
+	LogToConsole = true;
+}
+
+int32 UAlsSelectionBenchmarkCommandlet::Main(const FString& Parameters)
+{
+	using namespace AlsSelectionBenchmarkCommandlet;
+
+	FSettings Settings;
+
+	FParse::Value(*Parameters, TEXT("Count="), Settings.Count);
+	FParse::Value(*Parameters, TEXT("Queries="), Settings.Queries);
+
+	Settings.Count = FMath::Max(1, Settings.Count);
+	Settings.Queries = FMath::Max(1, Settings.Queries);
+
+	FString ScenariosString;
+	TArray<FString> ScenarioNamesToRun;
+
+	if (FParse::Value(*Parameters, TEXT("Scenarios="), ScenariosString, false))
+	{
+		ScenariosString.ParseIntoArray(ScenarioNamesToRun, TEXT(","));
+	}
+
+	TArray<FResult> Results;
+
+	for (const auto& Scenario : Scenarios)
+	{
+		if (ScenarioNamesToRun.IsEmpty() || ScenarioNamesToRun.Contains(Scenario.Name))
+		{
+			UE_LOG(LogAls, Display, TEXT("Running the %s scenario with %d actors..."), Scenario.Name, Settings.Count);
+
+			Results.Add(RunScenario(Settings, Scenario));
+		}
+	}
+
+	if (Results.IsEmpty())
+	{
+		UE_LOG(LogAls, Error, TEXT("No known scenarios in %s."), *ScenariosString);
+		return 1;
+	}
+
+	FString OutputPath{
+		FPaths::ProjectSavedDir() / TEXT("Als") / FString::Printf(TEXT("SelectionBenchmark-%s"), *FDateTime::Now().ToString())
+	};
+
+	FParse::Value(*Parameters, TEXT("Output="), OutputPath);
+
+	WriteResults(OutputPath, Settings, Results);
+
+	return 0;
+}
@@ -0,0 +1,255 @@
+﻿#include "AlsCharacter.h"
+#include "AlsCharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectGlobals.h"
+#include "Utility/AlsGameplayTags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+// Runs characters along scripted paths at a low tick rate with the fixed and the adaptive walking substeps, records their
+// trajectories, and checks that the adaptive substeps stay within a positional error budget and that both are deterministic.
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsAdaptiveSubstepsDeterminismTest, "Als.Movement.AdaptiveSubsteps",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace AlsAdaptiveSubstepsTests
+{
+	enum class EPath : uint8
+	{
+		Straight,
+		Turns,
+		Slope,
+		Count
+	};
+
+	static constexpr auto PathsCount{static_cast<int32>(EPath::Count)};
+
+	static const TCHAR* PathNames[]{TEXT("Straight"), TEXT("Turns"), TEXT("Slope")};
+
+	// A low server tick rate, at which every frame is split into several walking substeps.
+	static constexpr auto DeltaTime{1.0f / 15.0f};
+
+	static constexpr auto Frames{90};
+
+	static constexpr auto TurnInterval{1.5f};
+
+	static constexpr auto LaneSpacing{1500.0f};
+
+	static constexpr auto LaneLength{5000.0f};
+
+	static constexpr auto LaneWidth{400.0f};
+
+	static constexpr auto SlopeStartX{300.0f};
+
+	static constexpr auto SlopeLength{3000.0f};
+
+	static constexpr auto SlopeThickness{20.0f};
+
+	static constexpr auto SlopeAngle{10.0f};
+
+	// Maximum distance between the locations of a character in the same frame with the fixed and the adaptive substeps.
+	static constexpr auto PositionalErrorBudget{5.0f};
+
+	static const TCHAR* CharacterClassPath{TEXT("/ALS/Game/Blueprints/Characters/B_Als_Character.B_Als_Character_C")};
+
+	static const TCHAR* CubeMeshPath{TEXT("/Engine/BasicShapes/Cube.Cube")};
+
+	using FTrajectories = TStaticArray<TArray<FVector>, PathsCount>;
+
+	void SpawnBox(UWorld* World, UStaticMesh* CubeMesh, const FVector& Location, const FRotator& Rotation, const FVector& Size)
+	{
+		// The box mesh is 100 units in size.
+
+		const FTransform Transform{Rotation, Location, Size / 100.0f};
+
+		auto* Box{World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform)};
+		Box->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+	}
+
+	FRotator GetInputRotation(const EPath Path, const int32 Frame)
+	{
+		if (Path != EPath::Turns)
+		{
+			return FRotator::ZeroRotator;
+		}
+
+		// Turns by 90 degrees at regular intervals, so that the character runs in a square.
+
+		return {0.0f, FRotator::NormalizeAxis(FMath::FloorToFloat(Frame * DeltaTime / TurnInterval) * 90.0f), 0.0f};
+	}
+
+	bool RecordTrajectories(FAutomationTestBase& Test, const TSubclassOf<AAlsCharacter>& CharacterClass,
+	                        const bool bAllowAdaptiveWalkingSubsteps, FTrajectories& Trajectories, double& TickTime)
+	{
+		auto* CubeMesh{LoadObject<UStaticMesh>(nullptr, CubeMeshPath)};
+		if (!Test.TestNotNull(TEXT("Cube mesh"), CubeMesh))
+		{
+			return false;
+		}
+
+		auto* World{UWorld::CreateWorld(EWorldType::Game, false, TEXT("AlsAdaptiveSubstepsTest"))};
+		auto& WorldContext{GEngine->CreateNewWorldContext(EWorldType::Game)};
+		WorldContext.SetCurrentWorld(World);
+
+		ON_SCOPE_EXIT
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		};
+
+		// The top of the floor is at zero height. Adaptive substeps are only used on static
+		// geometry, which is the default mobility of the spawned static mesh actors.
+
+		SpawnBox(World, CubeMesh, {LaneLength * 0.5f - LaneSpacing * 0.5f, LaneSpacing * (PathsCount - 1) * 0.5f, -50.0f},
+		         FRotator::ZeroRotator, {LaneLength + LaneSpacing, LaneSpacing * PathsCount, 100.0f});
+
+		const auto SlopeAngleRadians{FMath::DegreesToRadians(SlopeAngle)};
+
+		SpawnBox(World, CubeMesh,
+		         {
+			         SlopeStartX + SlopeLength * 0.5f * FMath::Cos(SlopeAngleRadians),
+			         static_cast<int32>(EPath::Slope) * LaneSpacing,
+			         SlopeLength * 0.5f * FMath::Sin(SlopeAngleRadians)
+		         },
+		         {SlopeAngle, 0.0f, 0.0f}, {SlopeLength, LaneWidth, SlopeThickness});
+
+		TArray<AAlsCharacter*> Characters;
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		for (auto i{0}; i < PathsCount; i++)
+		{
+			const FVector Location{0.0f, i * LaneSpacing, 100.0f};
+
+			auto* Character{World->SpawnActor<AAlsCharacter>(CharacterClass, Location, FRotator::ZeroRotator, SpawnParameters)};
+			if (!Test.TestNotNull(FString::Printf(TEXT("%s character"), PathNames[i]), Character))
+			{
+				return false;
+			}
+
+			Character->GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+			Character->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+			Character->SpawnDefaultController();
+			Character->SetDesiredGait(AlsGaitTags::Running);
+
+			auto* Movement{Cast<UAlsCharacterMovementComponent>(Character->GetCharacterMovement())};
+			if (!Test.TestNotNull(FString::Printf(TEXT("%s character movement"), PathNames[i]), Movement))
+			{
+				return false;
+			}
+
+			Movement->bAllowAdaptiveWalkingSubsteps = bAllowAdaptiveWalkingSubsteps;
+
+			Characters.Add(Character);
+
+			Trajectories[i].Reset(Frames);
+		}
+
+		World->InitializeActorsForPlay(FURL{});
+		World->BeginPlay();
+
+		TickTime = 0.0;
+
+		for (auto Frame{0}; Frame < Frames; Frame++)
+		{
+			for (auto i{0}; i < PathsCount; i++)
+			{
+				const auto InputRotation{GetInputRotation(static_cast<EPath>(i), Frame)};
+
+				Characters[i]->GetController()->SetControlRotation(InputRotation);
+				Characters[i]->AddMovementInput(InputRotation.Vector());
+			}
+
+			const auto StartCycles{FPlatformTime::Cycles64()};
+
+			World->Tick(LEVELTICK_All, DeltaTime);
+
+			TickTime += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+			GFrameCounter += 1;
+
+			for (auto i{0}; i < PathsCount; i++)
+			{
+				Trajectories[i].Add(Characters[i]->GetActorLocation());
+			}
+		}
+
+		return true;
+	}
+
+	double CalculateMaxError(const TArray<FVector>& Trajectory, const TArray<FVector>& ReferenceTrajectory)
+	{
+		auto MaxError{0.0};
+
+		for (auto i{0}; i < Trajectory.Num(); i++)
+		{
+			MaxError = FMath::Max(MaxError, FVector::Dist(Trajectory[i], ReferenceTrajectory[i]));
+		}
+
+		return MaxError;
+	}
+}
+
+bool FAlsAdaptiveSubstepsDeterminismTest::RunTest(const FString& Parameters)
+{
+	using namespace AlsAdaptiveSubstepsTests;
+
+	const TSubclassOf<AAlsCharacter> CharacterClass{LoadClass<AAlsCharacter>(nullptr, CharacterClassPath)};
+	if (!TestNotNull(TEXT("Character class"), CharacterClass.Get()))
+	{
+		return false;
+	}
+
+	// Each policy is run twice, so that nondeterminism of the policy itself is
+	// not mistaken for the difference between the fixed and the adaptive substeps.
+
+	FTrajectories FixedTrajectories;
+	FTrajectories FixedTrajectoriesRepeated;
+	FTrajectories AdaptiveTrajectories;
+	FTrajectories AdaptiveTrajectoriesRepeated;
+
+	auto FixedTickTime{0.0};
+	auto AdaptiveTickTime{0.0};
+	auto RepeatedTickTime{0.0};
+
+	if (!RecordTrajectories(*this, CharacterClass, false, FixedTrajectories, FixedTickTime) ||
+	    !RecordTrajectories(*this, CharacterClass, false, FixedTrajectoriesRepeated, RepeatedTickTime) ||
+	    !RecordTrajectories(*this, CharacterClass, true, AdaptiveTrajectories, AdaptiveTickTime) ||
+	    !RecordTrajectories(*this, CharacterClass, true, AdaptiveTrajectoriesRepeated, RepeatedTickTime))
+	{
+		return false;
+	}
+
+	AddInfo(FString::Printf(TEXT("World tick time: %.3f ms per frame with fixed substeps, %.3f ms per frame with adaptive substeps."),
+	                        FixedTickTime / Frames, AdaptiveTickTime / Frames));
+
+	for (auto i{0}; i < PathsCount; i++)
+	{
+		const auto MaxError{CalculateMaxError(AdaptiveTrajectories[i], FixedTrajectories[i])};
+
+		AddInfo(FString::Printf(TEXT("%s: maximum positional error %.3f cm, final location %s with fixed substeps, %s with adaptive substeps."),
+		                        PathNames[i], MaxError, *FixedTrajectories[i].Last().ToCompactString(),
+		                        *AdaptiveTrajectories[i].Last().ToCompactString()));
+
+		TestTrue(FString::Printf(TEXT("%s: fixed substeps are deterministic"), PathNames[i]),
+		         CalculateMaxError(FixedTrajectoriesRepeated[i], FixedTrajectories[i]) <= UE_KINDA_SMALL_NUMBER);
+
+		TestTrue(FString::Printf(TEXT("%s: adaptive substeps are deterministic"), PathNames[i]),
+		         CalculateMaxError(AdaptiveTrajectoriesRepeated[i], AdaptiveTrajectories[i]) <= UE_KINDA_SMALL_NUMBER);
+
+		TestTrue(FString::Printf(TEXT("%s: positional error is within the budget"), PathNames[i]), MaxError <= PositionalErrorBudget);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,306 @@
+﻿#include "AlsCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Controller.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectGlobals.h"
+#include "Utility/AlsGameplayTags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+// Walks characters along scripted paths over flat ground, stairs, a slope and a moving platform, once with the floor
+// cache disabled and once with it enabled, and checks that the characters end up in the same places in both runs.
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsFloorCacheRegressionTest, "Als.Movement.FloorCache",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace AlsFloorCacheTests
+{
+	enum class EScenario : uint8
+	{
+		Flat,
+		Stairs,
+		Slope,
+		MovingPlatform,
+		Count
+	};
+
+	static const TCHAR* ScenarioNames[]{TEXT("Flat"), TEXT("Stairs"), TEXT("Slope"), TEXT("Moving platform")};
+
+	static constexpr auto Frames{150};
+
+	static constexpr auto DeltaTime{1.0f / 60.0f};
+
+	static constexpr auto LaneWidth{400.0f};
+
+	static constexpr auto LaneSpacing{1000.0f};
+
+	static constexpr auto LaneLength{4000.0f};
+
+	// Geometry starts a bit ahead of the characters, so that they reach full speed before the first step.
+	static constexpr auto GeometryStartX{300.0f};
+
+	static constexpr auto StepsCount{12};
+
+	static constexpr auto StepDepth{40.0f};
+
+	static constexpr auto StepHeight{15.0f};
+
+	static constexpr auto SlopeLength{1500.0f};
+
+	static constexpr auto SlopeThickness{20.0f};
+
+	static constexpr auto SlopeAngle{15.0f};
+
+	static constexpr auto PlatformLength{2000.0f};
+
+	static constexpr auto PlatformHeight{50.0f};
+
+	static constexpr auto PlatformSwayAmplitude{100.0f};
+
+	static constexpr auto PlatformBobAmplitude{30.0f};
+
+	static constexpr auto PlatformPeriod{2.0f};
+
+	// Cached floor results may be reused for capsule locations up to Als.Movement.FloorCacheTolerance apart, which
+	// slightly changes the floor distances on slopes and step edges, so the final locations are compared with a tolerance.
+	static constexpr auto LocationTolerance{1.0f};
+
+	// The stairs and the slope rise well above this height in the time the characters are walking on them.
+	static constexpr auto MinClimbHeight{50.0f};
+
+	static const TCHAR* CharacterClassPath{TEXT("/ALS/Game/Blueprints/Characters/B_Als_Character.B_Als_Character_C")};
+
+	static const TCHAR* CubeMeshPath{TEXT("/Engine/BasicShapes/Cube.Cube")};
+
+	struct FScenarioResult
+	{
+		FVector StartLocation{ForceInit};
+
+		FVector Location{ForceInit};
+
+		bool bOnPlatform{false};
+	};
+
+	AStaticMeshActor* SpawnBox(UWorld* World, UStaticMesh* CubeMesh, const FVector& Location, const FRotator& Rotation,
+	                           const FVector& Size, const EComponentMobility::Type Mobility)
+	{
+		// The box mesh is 100 units in size.
+
+		const FTransform Transform{Rotation, Location, Size / 100.0f};
+
+		auto* Box{World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform)};
+		Box->GetStaticMeshComponent()->SetMobility(Mobility);
+		Box->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+
+		return Box;
+	}
+
+	FVector GetPlatformLocation(const float LaneY, const int32 Frame)
+	{
+		const auto Phase{Frame * DeltaTime / PlatformPeriod * UE_TWO_PI};
+
+		return {
+			GeometryStartX + PlatformLength * 0.5f,
+			LaneY + FMath::Sin(Phase) * PlatformSwayAmplitude,
+			PlatformHeight * 0.5f + (1.0f - FMath::Cos(Phase)) * PlatformBobAmplitude
+		};
+	}
+
+	bool RunScenarios(FAutomationTestBase& Test, const TSubclassOf<AAlsCharacter>& CharacterClass,
+	                  TStaticArray<FScenarioResult, static_cast<int32>(EScenario::Count)>& Results)
+	{
+		auto* CubeMesh{LoadObject<UStaticMesh>(nullptr, CubeMeshPath)};
+		if (!Test.TestNotNull(TEXT("Cube mesh"), CubeMesh))
+		{
+			return false;
+		}
+
+		auto* World{UWorld::CreateWorld(EWorldType::Game, false, TEXT("AlsFloorCacheTest"))};
+		auto& WorldContext{GEngine->CreateNewWorldContext(EWorldType::Game)};
+		WorldContext.SetCurrentWorld(World);
+
+		ON_SCOPE_EXIT
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		};
+
+		static constexpr auto ScenariosCount{static_cast<int32>(EScenario::Count)};
+
+		// The top of the floor is at zero height.
+
+		SpawnBox(World, CubeMesh, {LaneLength * 0.5f, LaneSpacing * (ScenariosCount - 1) * 0.5f, -50.0f}, FRotator::ZeroRotator,
+		         {LaneLength, LaneSpacing * ScenariosCount, 100.0f}, EComponentMobility::Static);
+
+		const auto StairsY{static_cast<int32>(EScenario::Stairs) * LaneSpacing};
+
+		for (auto i{0}; i < StepsCount; i++)
+		{
+			const auto StepTop{(i + 1) * StepHeight};
+
+			SpawnBox(World, CubeMesh, {GeometryStartX + (i + 0.5f) * StepDepth, StairsY, StepTop * 0.5f}, FRotator::ZeroRotator,
+			         {StepDepth, LaneWidth, StepTop}, EComponentMobility::Static);
+		}
+
+		const auto StairsTop{StepsCount * StepHeight};
+		const auto LandingStartX{GeometryStartX + StepsCount * StepDepth};
+
+		SpawnBox(World, CubeMesh, {(LandingStartX + LaneLength) * 0.5f, StairsY, StairsTop * 0.5f}, FRotator::ZeroRotator,
+		         {LaneLength - LandingStartX, LaneWidth, StairsTop}, EComponentMobility::Static);
+
+		const auto SlopeAngleRadians{FMath::DegreesToRadians(SlopeAngle)};
+
+		SpawnBox(World, CubeMesh,
+		         {
+			         GeometryStartX + SlopeLength * 0.5f * FMath::Cos(SlopeAngleRadians),
+			         static_cast<int32>(EScenario::Slope) * LaneSpacing,
+			         SlopeLength * 0.5f * FMath::Sin(SlopeAngleRadians)
+		         },
+		         {SlopeAngle, 0.0f, 0.0f}, {SlopeLength, LaneWidth, SlopeThickness}, EComponentMobility::Static);
+
+		const auto PlatformY{static_cast<int32>(EScenario::MovingPlatform) * LaneSpacing};
+
+		auto* Platform{
+			SpawnBox(World, CubeMesh, GetPlatformLocation(PlatformY, 0), FRotator::ZeroRotator,
+			         {PlatformLength, LaneWidth, PlatformHeight}, EComponentMobility::Movable)
+		};
+
+		TArray<AAlsCharacter*> Characters;
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		for (auto i{0}; i < ScenariosCount; i++)
+		{
+			// The character on the moving platform starts on top of it rather than on the floor.
+
+			const FVector Location{
+				i == static_cast<int32>(EScenario::MovingPlatform) ? GeometryStartX + 100.0f : 0.0f,
+				i * LaneSpacing,
+				i == static_cast<int32>(EScenario::MovingPlatform) ? PlatformHeight + 100.0f : 100.0f
+			};
+
+			auto* Character{World->SpawnActor<AAlsCharacter>(CharacterClass, Location, FRotator::ZeroRotator, SpawnParameters)};
+			if (!Test.TestNotNull(FString::Printf(TEXT("%s character"), ScenarioNames[i]), Character))
+			{
+				return false;
+			}
+
+			Character->GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+			Character->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+			Character->SpawnDefaultController();
+			Character->SetDesiredGait(AlsGaitTags::Running);
+
+			Characters.Add(Character);
+		}
+
+		World->InitializeActorsForPlay(FURL{});
+		World->BeginPlay();
+
+		for (auto i{0}; i < ScenariosCount; i++)
+		{
+			Results[i].StartLocation = Characters[i]->GetActorLocation();
+		}
+
+		for (auto Frame{0}; Frame < Frames; Frame++)
+		{
+			Platform->SetActorLocation(GetPlatformLocation(PlatformY, Frame));
+
+			for (auto* Character : Characters)
+			{
+				Character->GetController()->SetControlRotation(FRotator::ZeroRotator);
+				Character->AddMovementInput(FVector::ForwardVector);
+			}
+
+			World->Tick(LEVELTICK_All, DeltaTime);
+
+			GFrameCounter += 1;
+		}
+
+		for (auto i{0}; i < ScenariosCount; i++)
+		{
+			Results[i].Location = Characters[i]->GetActorLocation();
+			Results[i].bOnPlatform = Characters[i]->GetCharacterMovement()->GetMovementBase() == Platform->GetStaticMeshComponent();
+		}
+
+		return true;
+	}
+}
+
+bool FAlsFloorCacheRegressionTest::RunTest(const FString& Parameters)
+{
+	using namespace AlsFloorCacheTests;
+
+	const TSubclassOf<AAlsCharacter> CharacterClass{LoadClass<AAlsCharacter>(nullptr, CharacterClassPath)};
+	if (!TestNotNull(TEXT("Character class"), CharacterClass.Get()))
+	{
+		return false;
+	}
+
+	auto* UseFloorCacheConsoleVariable{IConsoleManager::Get().FindConsoleVariable(TEXT("Als.Movement.UseFloorCache"))};
+	if (!TestNotNull(TEXT("Floor cache console variable"), UseFloorCacheConsoleVariable))
+	{
+		return false;
+	}
+
+	const auto bPreviousUseFloorCache{UseFloorCacheConsoleVariable->GetBool()};
+
+	ON_SCOPE_EXIT
+	{
+		UseFloorCacheConsoleVariable->Set(bPreviousUseFloorCache, ECVF_SetByCode);
+	};
+
+	TStaticArray<FScenarioResult, static_cast<int32>(EScenario::Count)> UncachedResults;
+	TStaticArray<FScenarioResult, static_cast<int32>(EScenario::Count)> CachedResults;
+
+	UseFloorCacheConsoleVariable->Set(false, ECVF_SetByCode);
+
+	if (!RunScenarios(*this, CharacterClass, UncachedResults))
+	{
+		return false;
+	}
+
+	UseFloorCacheConsoleVariable->Set(true, ECVF_SetByCode);
+
+	if (!RunScenarios(*this, CharacterClass, CachedResults))
+	{
+		return false;
+	}
+
+	for (auto i{0}; i < static_cast<int32>(EScenario::Count); i++)
+	{
+		const auto& Uncached{UncachedResults[i]};
+		const auto& Cached{CachedResults[i]};
+
+		AddInfo(FString::Printf(TEXT("%s: %s without the floor cache, %s with it."),
+		                        ScenarioNames[i], *Uncached.Location.ToCompactString(), *Cached.Location.ToCompactString()));
+
+		TestTrue(FString::Printf(TEXT("%s: same final location"), ScenarioNames[i]),
+		         Cached.Location.Equals(Uncached.Location, LocationTolerance));
+	}
+
+	// Make sure the scripted paths actually go over the geometry they are meant to test.
+
+	for (const auto* Results : {&UncachedResults, &CachedResults})
+	{
+		const auto& Stairs{(*Results)[static_cast<int32>(EScenario::Stairs)]};
+		const auto& Slope{(*Results)[static_cast<int32>(EScenario::Slope)]};
+		const auto& MovingPlatform{(*Results)[static_cast<int32>(EScenario::MovingPlatform)]};
+
+		TestTrue(TEXT("Stairs climbed"), Stairs.Location.Z - Stairs.StartLocation.Z > MinClimbHeight);
+		TestTrue(TEXT("Slope climbed"), Slope.Location.Z - Slope.StartLocation.Z > MinClimbHeight);
+		TestTrue(TEXT("Character stayed on the moving platform"), MovingPlatform.bOnPlatform);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,273 @@
+﻿#include "AlsCharacter.h"
+#include "AlsFootTraceSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectGlobals.h"
+#include "Utility/AlsGameplayTags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+// Runs 200 characters over uneven static geometry, once with synchronous foot offset traces and once with the traces batched by
+// the foot trace subsystem, and reports the number of traces and the time spent evaluating the characters' poses and control rigs.
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsFootTraceBatchingTest, "Als.ControlRig.FootOffsetTraces",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace AlsFootTraceTests
+{
+	static constexpr auto CharactersCount{200};
+
+	static constexpr auto CharacterSpacing{400.0f};
+
+	static constexpr auto WarmupFrames{30};
+
+	static constexpr auto Frames{120};
+
+	static constexpr auto DeltaTime{1.0f / 60.0f};
+
+	// Characters run in circles, so that their feet keep moving over the uneven geometry while they stay near their start location.
+	static constexpr auto TurnRate{90.0f};
+
+	// The ground is covered with tilted boxes of random heights, which are small enough for the characters to walk over.
+	static constexpr auto BumpSize{150.0f};
+
+	static constexpr auto MaxBumpHeight{20.0f};
+
+	static constexpr auto MaxBumpTilt{8.0f};
+
+	static constexpr auto RandomSeed{1337};
+
+	static const TCHAR* CharacterClassPath{TEXT("/ALS/Game/Blueprints/Characters/B_Als_Character.B_Als_Character_C")};
+
+	static const TCHAR* CubeMeshPath{TEXT("/Engine/BasicShapes/Cube.Cube")};
+
+	struct FModeResult
+	{
+		// Time spent evaluating the poses of all characters, including their control rigs, in milliseconds.
+		double EvaluationTime{0.0};
+
+		int32 IssuedTracesCount{0};
+
+		int32 ReusedTracesCount{0};
+
+		int32 SynchronousTracesCount{0};
+	};
+
+	void SpawnBox(UWorld* World, UStaticMesh* CubeMesh, const FVector& Location, const FRotator& Rotation, const FVector& Size)
+	{
+		// The box mesh is 100 units in size.
+
+		auto* Box{World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FTransform{Rotation, Location, Size / 100.0f})};
+		Box->GetStaticMeshComponent()->SetMobility(EComponentMobility::Static);
+		Box->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+	}
+
+	FModeResult RunMode(UWorld* World, const TConstArrayView<AAlsCharacter*> Characters, int32& Frame)
+	{
+		const auto* TraceSubsystem{World->GetSubsystem<UAlsFootTraceSubsystem>()};
+
+		FModeResult Result;
+
+		for (auto ModeFrame{0}; ModeFrame < WarmupFrames + Frames; ModeFrame++, Frame++)
+		{
+			if (ModeFrame == WarmupFrames)
+			{
+				Result.IssuedTracesCount = -TraceSubsystem->GetIssuedTracesCount();
+				Result.ReusedTracesCount = -TraceSubsystem->GetReusedTracesCount();
+				Result.SynchronousTracesCount = -TraceSubsystem->GetSynchronousTracesCount();
+			}
+
+			const FRotator Rotation{0.0f, FRotator::NormalizeAxis(Frame * DeltaTime * TurnRate), 0.0f};
+
+			for (auto* Character : Characters)
+			{
+				Character->GetController()->SetControlRotation(Rotation);
+				Character->AddMovementInput(Rotation.Vector());
+			}
+
+			// The meshes don't tick by themselves, so that their poses are evaluated here on the game thread and can be timed.
+
+			World->Tick(LEVELTICK_All, DeltaTime);
+
+			for (auto* Character : Characters)
+			{
+				Character->GetMesh()->TickAnimation(DeltaTime, false);
+			}
+
+			const auto StartCycles{FPlatformTime::Cycles64()};
+
+			for (auto* Character : Characters)
+			{
+				Character->GetMesh()->RefreshBoneTransforms();
+			}
+
+			const auto EvaluationTime{FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles)};
+
+			GFrameCounter += 1;
+
+			if (ModeFrame >= WarmupFrames)
+			{
+				Result.EvaluationTime += EvaluationTime;
+			}
+		}
+
+		Result.IssuedTracesCount += TraceSubsystem->GetIssuedTracesCount();
+		Result.ReusedTracesCount += TraceSubsystem->GetReusedTracesCount();
+		Result.SynchronousTracesCount += TraceSubsystem->GetSynchronousTracesCount();
+
+		return Result;
+	}
+}
+
+bool FAlsFootTraceBatchingTest::RunTest(const FString& Parameters)
+{
+	using namespace AlsFootTraceTests;
+
+	const TSubclassOf<AAlsCharacter> CharacterClass{LoadClass<AAlsCharacter>(nullptr, CharacterClassPath)};
+	if (!TestNotNull(TEXT("Character class"), CharacterClass.Get()))
+	{
+		return false;
+	}
+
+	auto* CubeMesh{LoadObject<UStaticMesh>(nullptr, CubeMeshPath)};
+	if (!TestNotNull(TEXT("Cube mesh"), CubeMesh))
+	{
+		return false;
+	}
+
+	auto* BatchTracesConsoleVariable{IConsoleManager::Get().FindConsoleVariable(TEXT("Als.ControlRig.BatchFootOffsetTraces"))};
+	if (!TestNotNull(TEXT("Console variable Als.ControlRig.BatchFootOffsetTraces"), BatchTracesConsoleVariable))
+	{
+		return false;
+	}
+
+	const auto PreviousBatchTraces{BatchTracesConsoleVariable->GetInt()};
+
+	auto* World{UWorld::CreateWorld(EWorldType::Game, false, TEXT("AlsFootTraceTest"))};
+	auto& WorldContext{GEngine->CreateNewWorldContext(EWorldType::Game)};
+	WorldContext.SetCurrentWorld(World);
+
+	ON_SCOPE_EXIT
+	{
+		BatchTracesConsoleVariable->Set(PreviousBatchTraces, ECVF_SetByCode);
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	};
+
+	const auto GridSize{FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(CharactersCount)))};
+	const auto GridExtent{GridSize * CharacterSpacing};
+
+	// The top of the floor is at zero height.
+
+	SpawnBox(World, CubeMesh, {GridExtent * 0.5f, GridExtent * 0.5f, -50.0f}, FRotator::ZeroRotator,
+	         {GridExtent + CharacterSpacing * 4.0f, GridExtent + CharacterSpacing * 4.0f, 100.0f});
+
+	FRandomStream RandomStream{RandomSeed};
+
+	const auto BumpsCount{FMath::CeilToInt32(GridExtent / BumpSize)};
+
+	for (auto X{0}; X < BumpsCount; X++)
+	{
+		for (auto Y{0}; Y < BumpsCount; Y++)
+		{
+			const auto Height{RandomStream.FRandRange(0.0f, MaxBumpHeight)};
+
+			const FRotator Rotation{
+				RandomStream.FRandRange(-MaxBumpTilt, MaxBumpTilt),
+				RandomStream.FRandRange(0.0f, 90.0f),
+				RandomStream.FRandRange(-MaxBumpTilt, MaxBumpTilt)
+			};
+
+			SpawnBox(World, CubeMesh, {(X + 0.5f) * BumpSize, (Y + 0.5f) * BumpSize, 0.0f}, Rotation,
+			         {BumpSize, BumpSize, Height * 2.0f});
+		}
+	}
+
+	TArray<AAlsCharacter*> Characters;
+	Characters.Reserve(CharactersCount);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	for (auto i{0}; i < CharactersCount; i++)
+	{
+		const FVector Location{
+			(i % GridSize + 0.5f) * CharacterSpacing, (i / GridSize + 0.5f) * CharacterSpacing, MaxBumpHeight + 100.0f
+		};
+
+		auto* Character{World->SpawnActor<AAlsCharacter>(CharacterClass, Location, FRotator::ZeroRotator, SpawnParameters)};
+		if (!IsValid(Character))
+		{
+			continue;
+		}
+
+		Character->GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+		Character->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+		Character->SpawnDefaultController();
+		Character->SetDesiredGait(AlsGaitTags::Running);
+
+		Characters.Add(Character);
+	}
+
+	if (!TestEqual(TEXT("Spawned characters"), Characters.Num(), CharactersCount))
+	{
+		return false;
+	}
+
+	World->InitializeActorsForPlay(FURL{});
+	World->BeginPlay();
+
+	for (auto* Character : Characters)
+	{
+		Character->GetMesh()->SetComponentTickEnabled(false);
+	}
+
+	auto Frame{0};
+
+	BatchTracesConsoleVariable->Set(0, ECVF_SetByCode);
+
+	const auto SynchronousResult{RunMode(World, Characters, Frame)};
+
+	BatchTracesConsoleVariable->Set(1, ECVF_SetByCode);
+
+	const auto BatchedResult{RunMode(World, Characters, Frame)};
+
+	const auto FeetEvaluationsCount{BatchedResult.ReusedTracesCount + BatchedResult.SynchronousTracesCount};
+
+	AddInfo(FString::Printf(TEXT("Synchronous traces: %.3f ms per frame, %.2f us per character, one trace per foot evaluation."),
+	                        SynchronousResult.EvaluationTime / Frames,
+	                        SynchronousResult.EvaluationTime * 1000.0 / (Frames * Characters.Num())));
+
+	AddInfo(FString::Printf(TEXT("Batched traces: %.3f ms per frame, %.2f us per character, %d foot evaluations, ")
+	                        TEXT("%d asynchronous traces, %d synchronous traces."),
+	                        BatchedResult.EvaluationTime / Frames, BatchedResult.EvaluationTime * 1000.0 / (Frames * Characters.Num()),
+	                        FeetEvaluationsCount, BatchedResult.IssuedTracesCount, BatchedResult.SynchronousTracesCount));
+
+	TestEqual(TEXT("Synchronous run: traces passed through the foot trace subsystem"),
+	          SynchronousResult.ReusedTracesCount + SynchronousResult.SynchronousTracesCount, 0);
+
+	TestTrue(TEXT("Batched run: the control rigs requested foot traces"), FeetEvaluationsCount > 0);
+	TestTrue(TEXT("Batched run: asynchronous traces were issued"), BatchedResult.IssuedTracesCount > 0);
+
+	// The characters are authoritative, so they stay in the high significance tier and each foot is traced at most once
+	// per frame. Their feet never move far enough in a frame to require a synchronous trace after the first frames.
+
+	TestTrue(TEXT("Batched run: at most one trace per foot evaluation"),
+	         BatchedResult.IssuedTracesCount + BatchedResult.SynchronousTracesCount <= FeetEvaluationsCount);
+
+	TestEqual(TEXT("Batched run: synchronous traces after warmup"), BatchedResult.SynchronousTracesCount, 0);
+
+	return true;
+}
+
+#endif
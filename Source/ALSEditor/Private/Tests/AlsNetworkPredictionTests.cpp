@@ -0,0 +1,1186 @@
+﻿#include "AlsCharacter.h"
+#include "AlsCharacterMovementComponent.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "Tests/AutomationCommon.h"
+#include "UObject/CoreNet.h"
+#include "Utility/AlsGameplayTags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+// Runs a dedicated server and several clients in a single editor process, drives the clients' characters with scripted
+// ALS inputs under emulated network conditions, and reports server moves, corrections, traffic and server move CPU time. Can be run
+// headless, e.g. UnrealEditor <Project> -ExecCmds="Automation RunTests Als.Network; Quit" -NullRHI -Unattended.
+
+namespace AlsNetworkPredictionTestsConsoleVariables
+{
+	static TAutoConsoleVariable<int32> ClientsCount{
+		TEXT("Als.Tests.NetworkPrediction.ClientsCount"), 2,
+		TEXT("Number of clients connected to the server during the network prediction fidelity test.")
+	};
+
+	static TAutoConsoleVariable<int32> Latency{
+		TEXT("Als.Tests.NetworkPrediction.Latency"), 100,
+		TEXT("Emulated latency in milliseconds added to the outgoing packets of the server and every client.")
+	};
+
+	static TAutoConsoleVariable<int32> Jitter{
+		TEXT("Als.Tests.NetworkPrediction.Jitter"), 20,
+		TEXT("Emulated random latency variance in milliseconds.")
+	};
+
+	static TAutoConsoleVariable<int32> PacketLoss{
+		TEXT("Als.Tests.NetworkPrediction.PacketLoss"), 1,
+		TEXT("Emulated percentage of lost outgoing packets.")
+	};
+
+	static TAutoConsoleVariable<FString> Map{
+		TEXT("Als.Tests.NetworkPrediction.Map"), TEXT("/ALS/Game/Maps/L_Als_Playground"),
+		TEXT("Map used by the network prediction fidelity test.")
+	};
+}
+
+namespace AlsNetworkPredictionTests
+{
+	struct FInputPhase
+	{
+		const TCHAR* Name{nullptr};
+
+		FGameplayTag RotationMode;
+
+		FGameplayTag Stance;
+
+		FGameplayTag Gait;
+
+		bool bJump{false};
+
+		bool bMantle{false};
+	};
+
+	struct FMoveCombiningConfiguration
+	{
+		const TCHAR* Name{nullptr};
+
+		float AccelerationAngleTolerance{0.0f};
+
+		float SteadyStateClientNetSendDeltaTime{0.0f};
+	};
+
+	static constexpr auto PhaseDuration{3.0};
+
+	static constexpr auto MoveCombiningPhaseDuration{6.0};
+
+	static constexpr auto PlaySessionStartTimeout{60.0};
+
+	// Legitimate high frame rate clients send a move every frame, well above the movement budget's default moves rate.
+	static constexpr auto HighFrameRateDeltaTime{1.0 / 240.0};
+
+	static constexpr auto MovementBudgetPhaseDuration{6.0};
+
+	// Corrections caused by the emulated packet loss and jitter vary from run to run, so the
+	// corrections rate with the movement budget is allowed to slightly exceed the rate without it.
+	static constexpr auto MaxMovementBudgetCorrectionsRateIncrease{0.5};
+
+	// A malicious client floods the server with tiny moves that together advance at the normal client time rate.
+	static constexpr auto MaliciousMovesPerFrame{16};
+
+	static constexpr auto MaliciousStreamDuration{5.0};
+
+	static constexpr auto MoveReplaysDuration{10.0};
+
+	static constexpr auto MoveReplayInterval{0.25};
+
+	// Characters run back and forth without turning the camera, since move replays use the current view rotation.
+	static constexpr auto DirectionChangeInterval{2.0};
+
+	// Characters keep turning while moving, so that they stay in the same area of the map.
+	static constexpr auto TurnRate{45.0};
+
+	const TArray<FInputPhase>& GetInputPhases()
+	{
+		static const TArray<FInputPhase> InputPhases{
+			{TEXT("Walk"), AlsRotationModeTags::VelocityDirection, AlsStanceTags::Standing, AlsGaitTags::Walking},
+			{TEXT("Run"), AlsRotationModeTags::VelocityDirection, AlsStanceTags::Standing, AlsGaitTags::Running},
+			{TEXT("Sprint"), AlsRotationModeTags::VelocityDirection, AlsStanceTags::Standing, AlsGaitTags::Sprinting},
+			{TEXT("Crouch"), AlsRotationModeTags::ViewDirection, AlsStanceTags::Crouching, AlsGaitTags::Running},
+			{TEXT("Aim"), AlsRotationModeTags::Aiming, AlsStanceTags::Standing, AlsGaitTags::Walking},
+			{TEXT("Jump"), AlsRotationModeTags::ViewDirection, AlsStanceTags::Standing, AlsGaitTags::Running, true},
+			{TEXT("Mantle"), AlsRotationModeTags::VelocityDirection, AlsStanceTags::Standing, AlsGaitTags::Running, false, true}
+		};
+
+		return InputPhases;
+	}
+
+	const TArray<FMoveCombiningConfiguration>& GetMoveCombiningConfigurations()
+	{
+		static const TArray<FMoveCombiningConfiguration> Configurations{
+			{TEXT("Engine defaults"), 5.0f, 0.0f},
+			{TEXT("Wider combining tolerance"), 15.0f, 0.0f},
+			{TEXT("Wider combining tolerance and steady-state send rate"), 15.0f, 1.0f / 20.0f}
+		};
+
+		return Configurations;
+	}
+
+	struct FMetrics
+	{
+		int32 ServerMovesReceived{0};
+
+		int32 SimulatedAutonomousMoves{0};
+
+		int32 MergedAutonomousMoves{0};
+
+		int32 CorrectionsSent{0};
+
+		int32 CorrectionsReceived{0};
+
+		int32 GroundedMovementSettingsMemoHits{0};
+
+		int32 GroundedMovementSettingsMemoMismatches{0};
+
+		double AutonomousMovesTime{0.0};
+
+		uint64 InBytes{0};
+
+		uint64 OutBytes{0};
+	};
+
+	struct FContext
+	{
+		FAutomationTestBase* Test{nullptr};
+
+		int32 ClientsCount{0};
+
+		bool bFailed{false};
+
+		TWeakObjectPtr<UWorld> ServerWorld;
+
+		TArray<TWeakObjectPtr<UWorld>> ClientWorlds;
+
+		double StartTime{0.0};
+
+		int32 PhaseIndex{INDEX_NONE};
+
+		int32 MantlesCount{0};
+
+		FMetrics StartMetrics;
+	};
+
+	AAlsCharacter* GetLocalCharacter(const UWorld* World)
+	{
+		const auto* Player{IsValid(World) ? World->GetFirstPlayerController() : nullptr};
+		return IsValid(Player) ? Cast<AAlsCharacter>(Player->GetPawn()) : nullptr;
+	}
+
+	FMetrics GatherMetrics(const FContext& Context)
+	{
+		FMetrics Metrics;
+
+		if (Context.ServerWorld.IsValid())
+		{
+			for (TActorIterator<AAlsCharacter> Iterator{Context.ServerWorld.Get()}; Iterator; ++Iterator)
+			{
+				const auto* Movement{Cast<UAlsCharacterMovementComponent>(Iterator->GetCharacterMovement())};
+				if (IsValid(Movement))
+				{
+					Metrics.ServerMovesReceived += Movement->GetServerMovesReceivedCount();
+					Metrics.SimulatedAutonomousMoves += Movement->GetSimulatedAutonomousMovesCount();
+					Metrics.MergedAutonomousMoves += Movement->GetMergedAutonomousMovesCount();
+					Metrics.CorrectionsSent += Movement->GetClientCorrectionsSentCount();
+					Metrics.AutonomousMovesTime += Movement->GetAutonomousMovesTime();
+				}
+			}
+
+			const auto* NetDriver{Context.ServerWorld->GetNetDriver()};
+			if (IsValid(NetDriver))
+			{
+				Metrics.InBytes = NetDriver->InTotalBytes;
+				Metrics.OutBytes = NetDriver->OutTotalBytes;
+			}
+		}
+
+		for (const auto& ClientWorld : Context.ClientWorlds)
+		{
+			const auto* Character{GetLocalCharacter(ClientWorld.Get())};
+			const auto* Movement{IsValid(Character) ? Cast<UAlsCharacterMovementComponent>(Character->GetCharacterMovement()) : nullptr};
+
+			if (IsValid(Movement))
+			{
+				Metrics.CorrectionsReceived += Movement->GetClientCorrectionsReceivedCount();
+				Metrics.GroundedMovementSettingsMemoHits += Movement->GetGroundedMovementSettingsMemoHitsCount();
+				Metrics.GroundedMovementSettingsMemoMismatches += Movement->GetGroundedMovementSettingsMemoMismatchesCount();
+			}
+		}
+
+		return Metrics;
+	}
+
+	void SetMovementBudgetEnabled(const FContext& Context, const bool bEnabled)
+	{
+		if (!Context.ServerWorld.IsValid())
+		{
+			return;
+		}
+
+		for (TActorIterator<AAlsCharacter> Iterator{Context.ServerWorld.Get()}; Iterator; ++Iterator)
+		{
+			auto* Movement{Cast<UAlsCharacterMovementComponent>(Iterator->GetCharacterMovement())};
+			if (IsValid(Movement))
+			{
+				Movement->MovementBudget.bEnabled = bEnabled;
+			}
+		}
+	}
+
+	FAlsMovementBudget GetServerMovementBudget(const FContext& Context)
+	{
+		if (Context.ServerWorld.IsValid())
+		{
+			for (TActorIterator<AAlsCharacter> Iterator{Context.ServerWorld.Get()}; Iterator; ++Iterator)
+			{
+				const auto* Movement{Cast<UAlsCharacterMovementComponent>(Iterator->GetCharacterMovement())};
+				if (IsValid(Movement))
+				{
+					return Movement->MovementBudget;
+				}
+			}
+		}
+
+		return {};
+	}
+}
+
+class FAlsStartNetworkPlaySessionCommand : public IAutomationLatentCommand
+{
+private:
+	TSharedRef<AlsNetworkPredictionTests::FContext> Context;
+
+public:
+	explicit FAlsStartNetworkPlaySessionCommand(const TSharedRef<AlsNetworkPredictionTests::FContext>& InContext) : Context{InContext} {}
+
+	virtual bool Update() override
+	{
+		auto* PlaySettings{NewObject<ULevelEditorPlaySettings>()};
+		PlaySettings->SetPlayNetMode(PIE_Client);
+		PlaySettings->SetPlayNumberOfClients(Context->ClientsCount);
+		PlaySettings->SetRunUnderOneProcess(true);
+
+		FRequestPlaySessionParams Parameters;
+		Parameters.WorldType = EPlaySessionWorldType::PlayInEditor;
+		Parameters.EditorPlaySettings = PlaySettings;
+
+		GEditor->RequestPlaySession(Parameters);
+		return true;
+	}
+};
+
+class FAlsWaitForNetworkPlayersCommand : public IAutomationLatentCommand
+{
+private:
+	TSharedRef<AlsNetworkPredictionTests::FContext> Context;
+
+public:
+	explicit FAlsWaitForNetworkPlayersCommand(const TSharedRef<AlsNetworkPredictionTests::FContext>& InContext) : Context{InContext} {}
+
+	virtual bool Update() override
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		if (GetCurrentRunTime() > PlaySessionStartTimeout)
+		{
+			Context->Test->AddError(TEXT("The server and clients didn't start in time."));
+			Context->bFailed = true;
+			return true;
+		}
+
+		UWorld* ServerWorld{nullptr};
+		TArray<TWeakObjectPtr<UWorld>> ClientWorlds;
+
+		for (const auto& WorldContext : GEditor->GetWorldContexts())
+		{
+			auto* World{WorldContext.World()};
+			if (WorldContext.WorldType != EWorldType::PIE || !IsValid(World))
+			{
+				continue;
+			}
+
+			if (World->GetNetMode() == NM_DedicatedServer)
+			{
+				ServerWorld = World;
+			}
+			else if (World->GetNetMode() == NM_Client)
+			{
+				if (!IsValid(GetLocalCharacter(World)))
+				{
+					return false;
+				}
+
+				ClientWorlds.Emplace(World);
+			}
+		}
+
+		if (!IsValid(ServerWorld) || ClientWorlds.Num() < Context->ClientsCount)
+		{
+			return false;
+		}
+
+		// The packet emulation applies to outgoing packets, so it is enabled on both ends of every connection.
+
+		const auto EmulationCommands{
+			FString::Printf(TEXT("Net PktLag=%d PktLagVariance=%d PktLoss=%d"),
+			                AlsNetworkPredictionTestsConsoleVariables::Latency.GetValueOnGameThread(),
+			                AlsNetworkPredictionTestsConsoleVariables::Jitter.GetValueOnGameThread(),
+			                AlsNetworkPredictionTestsConsoleVariables::PacketLoss.GetValueOnGameThread())
+		};
+
+		GEngine->Exec(ServerWorld, *EmulationCommands);
+
+		for (const auto& ClientWorld : ClientWorlds)
+		{
+			GEngine->Exec(ClientWorld.Get(), *EmulationCommands);
+		}
+
+		Context->ServerWorld = ServerWorld;
+		Context->ClientWorlds = MoveTemp(ClientWorlds);
+		Context->StartTime = FPlatformTime::Seconds();
+		Context->StartMetrics = GatherMetrics(*Context);
+
+		return true;
+	}
+};
+
+class FAlsDriveScriptedInputsCommand : public IAutomationLatentCommand
+{
+private:
+	TSharedRef<AlsNetworkPredictionTests::FContext> Context;
+
+public:
+	explicit FAlsDriveScriptedInputsCommand(const TSharedRef<AlsNetworkPredictionTests::FContext>& InContext) : Context{InContext} {}
+
+	virtual bool Update() override
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		if (Context->bFailed)
+		{
+			return true;
+		}
+
+		if (!Context->ServerWorld.IsValid())
+		{
+			Context->Test->AddError(TEXT("The play session ended before the scripted inputs were finished."));
+			return true;
+		}
+
+		const auto& InputPhases{GetInputPhases()};
+		const auto ElapsedTime{FPlatformTime::Seconds() - Context->StartTime};
+		const auto PhaseIndex{FMath::FloorToInt32(ElapsedTime / PhaseDuration)};
+
+		if (PhaseIndex >= InputPhases.Num())
+		{
+			ReportMetrics(ElapsedTime);
+			return true;
+		}
+
+		const auto& Phase{InputPhases[PhaseIndex]};
+		const auto bPhaseChanged{PhaseIndex != Context->PhaseIndex};
+
+		Context->PhaseIndex = PhaseIndex;
+
+		const FRotator ViewRotation{0.0, FRotator::NormalizeAxis(ElapsedTime * TurnRate), 0.0};
+
+		for (const auto& ClientWorld : Context->ClientWorlds)
+		{
+			auto* Character{GetLocalCharacter(ClientWorld.Get())};
+			if (!IsValid(Character))
+			{
+				continue;
+			}
+
+			if (bPhaseChanged)
+			{
+				Character->StopJumping();
+
+				Character->SetDesiredRotationMode(Phase.RotationMode);
+				Character->SetDesiredStance(Phase.Stance);
+				Character->SetDesiredGait(Phase.Gait);
+			}
+
+			Character->GetController()->SetControlRotation(ViewRotation);
+			Character->AddMovementInput(ViewRotation.Vector());
+
+			if (Phase.bJump)
+			{
+				Character->Jump();
+			}
+
+			if (Phase.bMantle && Character->StartMantlingGrounded())
+			{
+				Context->MantlesCount += 1;
+			}
+		}
+
+		return false;
+	}
+
+private:
+	void ReportMetrics(const double Duration) const
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		const auto Metrics{GatherMetrics(*Context)};
+		const auto& StartMetrics{Context->StartMetrics};
+
+		const auto ClientsCount{Context->ClientWorlds.Num()};
+		const auto ClientSeconds{Duration * ClientsCount};
+
+		auto* Test{Context->Test};
+
+		Test->AddInfo(FString::Printf(TEXT("Clients: %d, latency: %d ms, jitter: %d ms, packet loss: %d%%, duration: %.1f s."),
+		                              ClientsCount, AlsNetworkPredictionTestsConsoleVariables::Latency.GetValueOnGameThread(),
+		                              AlsNetworkPredictionTestsConsoleVariables::Jitter.GetValueOnGameThread(),
+		                              AlsNetworkPredictionTestsConsoleVariables::PacketLoss.GetValueOnGameThread(), Duration));
+
+		Test->AddInfo(FString::Printf(TEXT("Server moves received by the server: %d (%.2f per client per second)."),
+		                              Metrics.ServerMovesReceived - StartMetrics.ServerMovesReceived,
+		                              (Metrics.ServerMovesReceived - StartMetrics.ServerMovesReceived) / ClientSeconds));
+
+		Test->AddInfo(FString::Printf(TEXT("Corrections sent by the server: %d (%.2f per client per second)."),
+		                              Metrics.CorrectionsSent - StartMetrics.CorrectionsSent,
+		                              (Metrics.CorrectionsSent - StartMetrics.CorrectionsSent) / ClientSeconds));
+
+		Test->AddInfo(FString::Printf(TEXT("Corrections received by the clients: %d."),
+		                              Metrics.CorrectionsReceived - StartMetrics.CorrectionsReceived));
+
+		Test->AddInfo(FString::Printf(TEXT("Server traffic: %.0f bytes per second in, %.0f bytes per second out."),
+		                              (Metrics.InBytes - StartMetrics.InBytes) / Duration,
+		                              (Metrics.OutBytes - StartMetrics.OutBytes) / Duration));
+
+		Test->AddInfo(FString::Printf(TEXT("Server move CPU time: %.2f ms total, %.1f us per client per second."),
+		                              (Metrics.AutonomousMovesTime - StartMetrics.AutonomousMovesTime) * 1000.0,
+		                              (Metrics.AutonomousMovesTime - StartMetrics.AutonomousMovesTime) * 1000000.0 / ClientSeconds));
+
+		Test->AddInfo(FString::Printf(TEXT("Mantles started: %d."), Context->MantlesCount));
+	}
+};
+
+class FAlsDriveSteadyStateLocomotionCommand : public IAutomationLatentCommand
+{
+private:
+	TSharedRef<AlsNetworkPredictionTests::FContext> Context;
+
+	AlsNetworkPredictionTests::FMetrics PhaseStartMetrics;
+
+	double PhaseStartTime{0.0};
+
+public:
+	explicit FAlsDriveSteadyStateLocomotionCommand(const TSharedRef<AlsNetworkPredictionTests::FContext>& InContext) : Context{InContext} {}
+
+	virtual bool Update() override
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		if (Context->bFailed)
+		{
+			return true;
+		}
+
+		if (!Context->ServerWorld.IsValid())
+		{
+			Context->Test->AddError(TEXT("The play session ended before all move combining configurations were measured."));
+			return true;
+		}
+
+		const auto& Configurations{GetMoveCombiningConfigurations()};
+		const auto Time{FPlatformTime::Seconds()};
+		const auto ElapsedTime{Time - Context->StartTime};
+		const auto PhaseIndex{FMath::FloorToInt32(ElapsedTime / MoveCombiningPhaseDuration)};
+
+		if (PhaseIndex != Context->PhaseIndex)
+		{
+			if (Configurations.IsValidIndex(Context->PhaseIndex))
+			{
+				ReportPhaseMetrics(Configurations[Context->PhaseIndex], Time - PhaseStartTime);
+			}
+
+			if (PhaseIndex >= Configurations.Num())
+			{
+				return true;
+			}
+
+			Context->PhaseIndex = PhaseIndex;
+
+			const auto& Configuration{Configurations[PhaseIndex]};
+
+			for (const auto& ClientWorld : Context->ClientWorlds)
+			{
+				const auto* Character{GetLocalCharacter(ClientWorld.Get())};
+				auto* Movement{IsValid(Character) ? Cast<UAlsCharacterMovementComponent>(Character->GetCharacterMovement()) : nullptr};
+
+				if (IsValid(Movement))
+				{
+					Movement->MoveCombiningAccelerationAngleTolerance = Configuration.AccelerationAngleTolerance;
+					Movement->SteadyStateClientNetSendDeltaTime = Configuration.SteadyStateClientNetSendDeltaTime;
+				}
+			}
+
+			PhaseStartMetrics = GatherMetrics(*Context);
+			PhaseStartTime = Time;
+		}
+
+		// Steady-state locomotion: running while the camera slowly turns, so that consecutive
+		// moves only differ by a small rotation of the acceleration direction.
+
+		const FRotator ViewRotation{0.0, FRotator::NormalizeAxis(ElapsedTime * TurnRate), 0.0};
+
+		for (const auto& ClientWorld : Context->ClientWorlds)
+		{
+			auto* Character{GetLocalCharacter(ClientWorld.Get())};
+			if (!IsValid(Character))
+			{
+				continue;
+			}
+
+			Character->SetDesiredRotationMode(AlsRotationModeTags::VelocityDirection);
+			Character->SetDesiredStance(AlsStanceTags::Standing);
+			Character->SetDesiredGait(AlsGaitTags::Running);
+
+			Character->GetController()->SetControlRotation(ViewRotation);
+			Character->AddMovementInput(ViewRotation.Vector());
+		}
+
+		return false;
+	}
+
+private:
+	void ReportPhaseMetrics(const AlsNetworkPredictionTests::FMoveCombiningConfiguration& Configuration, const double Duration) const
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		const auto Metrics{GatherMetrics(*Context)};
+		const auto ClientSeconds{Duration * Context->ClientWorlds.Num()};
+
+		Context->Test->AddInfo(FString::Printf(
+			TEXT("%s (tolerance: %.0f deg, steady-state send delta time: %.3f s): ")
+			TEXT("%.2f server moves and %.2f corrections per client per second, %.0f bytes per second in."),
+			Configuration.Name, Configuration.AccelerationAngleTolerance, Configuration.SteadyStateClientNetSendDeltaTime,
+			(Metrics.ServerMovesReceived - PhaseStartMetrics.ServerMovesReceived) / ClientSeconds,
+			(Metrics.CorrectionsSent - PhaseStartMetrics.CorrectionsSent) / ClientSeconds,
+			(Metrics.InBytes - PhaseStartMetrics.InBytes) / Duration));
+	}
+};
+
+class FAlsDriveHighFrameRateLocomotionCommand : public IAutomationLatentCommand
+{
+private:
+	TSharedRef<AlsNetworkPredictionTests::FContext> Context;
+
+	AlsNetworkPredictionTests::FMetrics PhaseStartMetrics;
+
+	int32 FramesCount{0};
+
+	bool bPreviousUseFixedTimeStep{false};
+
+	double PreviousFixedDeltaTime{0.0};
+
+	bool bPreviousMoveCombiningEnabled{true};
+
+	// Corrections per client per second without and with the movement budget.
+	double CorrectionsRates[2]{0.0, 0.0};
+
+	int32 BudgetMergedMovesCount{0};
+
+public:
+	explicit FAlsDriveHighFrameRateLocomotionCommand(const TSharedRef<AlsNetworkPredictionTests::FContext>& InContext) : Context{InContext} {}
+
+	virtual ~FAlsDriveHighFrameRateLocomotionCommand() override
+	{
+		if (FramesCount > 0)
+		{
+			FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+			FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+
+			auto* MoveCombiningConsoleVariable{IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetEnableMoveCombining"))};
+			if (MoveCombiningConsoleVariable != nullptr)
+			{
+				MoveCombiningConsoleVariable->Set(bPreviousMoveCombiningEnabled, ECVF_SetByCode);
+			}
+		}
+	}
+
+	virtual bool Update() override
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		if (Context->bFailed)
+		{
+			return true;
+		}
+
+		if (!Context->ServerWorld.IsValid())
+		{
+			Context->Test->AddError(TEXT("The play session ended before the high frame rate locomotion was measured."));
+			return true;
+		}
+
+		if (FramesCount <= 0)
+		{
+			// Every world ticks with the same small fixed delta time regardless of how fast the editor actually runs, and the
+			// clients send every move separately instead of combining them, so that the server receives a move per client frame.
+
+			bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+			PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+
+			FApp::SetUseFixedTimeStep(true);
+			FApp::SetFixedDeltaTime(HighFrameRateDeltaTime);
+
+			auto* MoveCombiningConsoleVariable{IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetEnableMoveCombining"))};
+			if (MoveCombiningConsoleVariable != nullptr)
+			{
+				bPreviousMoveCombiningEnabled = MoveCombiningConsoleVariable->GetBool();
+				MoveCombiningConsoleVariable->Set(false, ECVF_SetByCode);
+			}
+		}
+
+		const auto PhaseFramesCount{FMath::RoundToInt32(MovementBudgetPhaseDuration / HighFrameRateDeltaTime)};
+		const auto PhaseIndex{FramesCount / PhaseFramesCount};
+
+		if (PhaseIndex != Context->PhaseIndex)
+		{
+			if (Context->PhaseIndex == 0 || Context->PhaseIndex == 1)
+			{
+				ReportPhaseMetrics(Context->PhaseIndex, PhaseFramesCount * HighFrameRateDeltaTime);
+			}
+
+			if (PhaseIndex >= 2)
+			{
+				CheckDesync();
+				return true;
+			}
+
+			Context->PhaseIndex = PhaseIndex;
+
+			SetMovementBudgetEnabled(*Context, PhaseIndex == 1);
+
+			PhaseStartMetrics = GatherMetrics(*Context);
+		}
+
+		const FRotator ViewRotation{0.0, FRotator::NormalizeAxis(FramesCount * HighFrameRateDeltaTime * TurnRate), 0.0};
+
+		for (const auto& ClientWorld : Context->ClientWorlds)
+		{
+			auto* Character{GetLocalCharacter(ClientWorld.Get())};
+			if (!IsValid(Character))
+			{
+				continue;
+			}
+
+			Character->SetDesiredRotationMode(AlsRotationModeTags::VelocityDirection);
+			Character->SetDesiredStance(AlsStanceTags::Standing);
+			Character->SetDesiredGait(AlsGaitTags::Running);
+
+			Character->GetController()->SetControlRotation(ViewRotation);
+			Character->AddMovementInput(ViewRotation.Vector());
+		}
+
+		FramesCount += 1;
+		return false;
+	}
+
+private:
+	void ReportPhaseMetrics(const int32 PhaseIndex, const double Duration)
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		const auto Metrics{GatherMetrics(*Context)};
+		const auto ClientSeconds{Duration * Context->ClientWorlds.Num()};
+
+		CorrectionsRates[PhaseIndex] = (Metrics.CorrectionsSent - PhaseStartMetrics.CorrectionsSent) / ClientSeconds;
+
+		if (PhaseIndex == 1)
+		{
+			BudgetMergedMovesCount = Metrics.MergedAutonomousMoves - PhaseStartMetrics.MergedAutonomousMoves;
+		}
+
+		Context->Test->AddInfo(FString::Printf(
+			TEXT("%s: %.2f simulated and %.2f merged server moves, %.2f corrections per client per second."),
+			PhaseIndex == 1 ? TEXT("Movement budget") : TEXT("No movement budget"),
+			(Metrics.SimulatedAutonomousMoves - PhaseStartMetrics.SimulatedAutonomousMoves) / ClientSeconds,
+			(Metrics.MergedAutonomousMoves - PhaseStartMetrics.MergedAutonomousMoves) / ClientSeconds,
+			CorrectionsRates[PhaseIndex]));
+	}
+
+	void CheckDesync() const
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		auto* Test{Context->Test};
+
+		// The test is meaningless unless the budget actually merged the moves of the clients.
+
+		Test->TestTrue(TEXT("The movement budget merged moves of the high frame rate clients"), BudgetMergedMovesCount > 0);
+
+		Test->TestTrue(TEXT("The movement budget doesn't desync the high frame rate clients"),
+		               CorrectionsRates[1] <= CorrectionsRates[0] + MaxMovementBudgetCorrectionsRateIncrease);
+	}
+};
+
+class FAlsSendMaliciousMoveStreamCommand : public IAutomationLatentCommand
+{
+private:
+	TSharedRef<AlsNetworkPredictionTests::FContext> Context;
+
+	AlsNetworkPredictionTests::FMetrics StreamStartMetrics;
+
+	double StreamStartTime{0.0};
+
+	// Sum of the delta times of the moves sent by each client.
+	double StreamTime{0.0};
+
+	int32 SentMovesCount{0};
+
+	TArray<float> TimeStamps;
+
+public:
+	explicit FAlsSendMaliciousMoveStreamCommand(const TSharedRef<AlsNetworkPredictionTests::FContext>& InContext) : Context{InContext} {}
+
+	virtual bool Update() override
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		if (Context->bFailed)
+		{
+			return true;
+		}
+
+		if (!Context->ServerWorld.IsValid())
+		{
+			Context->Test->AddError(TEXT("The play session ended before the malicious move stream was sent."));
+			return true;
+		}
+
+		if (StreamStartTime <= 0.0)
+		{
+			StartStream();
+		}
+
+		if (FPlatformTime::Seconds() - StreamStartTime >= MaliciousStreamDuration)
+		{
+			ReportMetrics();
+			return true;
+		}
+
+		auto FrameDeltaTime{0.0f};
+
+		for (auto i{0}; i < Context->ClientWorlds.Num(); i++)
+		{
+			auto* ClientWorld{Context->ClientWorlds[i].Get()};
+			auto* Character{GetLocalCharacter(ClientWorld)};
+
+			if (!IsValid(Character) || !TimeStamps.IsValidIndex(i))
+			{
+				continue;
+			}
+
+			FrameDeltaTime = ClientWorld->GetDeltaSeconds();
+
+			const auto MoveDeltaTime{FrameDeltaTime / MaliciousMovesPerFrame};
+
+			for (auto j{0}; j < MaliciousMovesPerFrame; j++)
+			{
+				TimeStamps[i] += MoveDeltaTime;
+
+				SendMove(*Character, TimeStamps[i]);
+			}
+		}
+
+		StreamTime += FrameDeltaTime;
+		return false;
+	}
+
+private:
+	void StartStream()
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		TimeStamps.SetNumZeroed(Context->ClientWorlds.Num());
+
+		for (auto i{0}; i < Context->ClientWorlds.Num(); i++)
+		{
+			const auto* Character{GetLocalCharacter(Context->ClientWorlds[i].Get())};
+			auto* Movement{IsValid(Character) ? Cast<UAlsCharacterMovementComponent>(Character->GetCharacterMovement()) : nullptr};
+
+			if (!IsValid(Movement))
+			{
+				continue;
+			}
+
+			// The malicious client sends its own moves instead of the moves of the character movement component.
+
+			Movement->SetComponentTickEnabled(false);
+
+			const auto* PredictionData{Movement->GetPredictionData_Client_Character()};
+			TimeStamps[i] = PredictionData != nullptr ? PredictionData->CurrentTimeStamp : 0.0f;
+		}
+
+		SetMovementBudgetEnabled(*Context, true);
+
+		StreamStartMetrics = GatherMetrics(*Context);
+		StreamStartTime = FPlatformTime::Seconds();
+	}
+
+	void SendMove(AAlsCharacter& Character, const float TimeStamp)
+	{
+		// Same as UCharacterMovementComponent::CallServerMovePacked(), but with a crafted idle move.
+
+		auto* Movement{Cast<UAlsCharacterMovementComponent>(Character.GetCharacterMovement())};
+		auto* Connection{Character.GetNetConnection()};
+
+		if (!IsValid(Movement) || !IsValid(Connection))
+		{
+			return;
+		}
+
+		FAlsCharacterNetworkMoveDataContainer MoveDataContainer;
+
+		auto& MoveData{MoveDataContainer.MoveData[0]};
+		MoveData.TimeStamp = TimeStamp;
+		MoveData.Location = Character.GetActorLocation();
+		MoveData.ControlRotation = Character.GetControlRotation();
+		MoveData.MovementMode = Movement->PackNetworkMovementMode();
+
+		FNetBitWriter Writer{Connection->PackageMap, 256};
+
+		if (!MoveDataContainer.Serialize(*Movement, Writer, Connection->PackageMap) || Writer.IsError())
+		{
+			return;
+		}
+
+		const auto BitsCount{static_cast<int32>(Writer.GetNumBits())};
+
+		FCharacterServerMovePackedBits PackedBits;
+		PackedBits.DataBits.SetNumUninitialized(BitsCount);
+
+		FMemory::Memcpy(PackedBits.DataBits.GetData(), Writer.GetData(), FMath::DivideAndRoundUp(BitsCount, 8));
+
+		Character.ServerMovePacked(PackedBits);
+
+		SentMovesCount += 1;
+	}
+
+	void ReportMetrics() const
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		const auto Metrics{GatherMetrics(*Context)};
+		const auto MovementBudget{GetServerMovementBudget(*Context)};
+		const auto ClientsCount{Context->ClientWorlds.Num()};
+
+		const auto SimulatedMovesCount{Metrics.SimulatedAutonomousMoves - StreamStartMetrics.SimulatedAutonomousMoves};
+		const auto MergedMovesCount{Metrics.MergedAutonomousMoves - StreamStartMetrics.MergedAutonomousMoves};
+
+		auto* Test{Context->Test};
+
+		Test->AddInfo(FString::Printf(TEXT("Moves sent: %d, server moves received: %d, simulated: %d, merged: %d, stream time: %.2f s."),
+		                              SentMovesCount, Metrics.ServerMovesReceived - StreamStartMetrics.ServerMovesReceived,
+		                              SimulatedMovesCount, MergedMovesCount, StreamTime));
+
+		// The budget is refilled by the delta time of the received moves, which is at most the stream time. Two more moves
+		// per client are allowed for the first move of the stream, which can't be merged with the client's own previous
+		// move and is simulated even with an empty budget, and for the time between the client's last own move and the stream.
+
+		const auto MaxSimulatedMovesCount{
+			ClientsCount * (StreamTime * MovementBudget.MaxMovesPerSecond + MovementBudget.MaxAccumulatedMoves + 2.0)
+		};
+
+		Test->TestTrue(TEXT("The malicious clients' moves were merged"), MergedMovesCount > SimulatedMovesCount);
+
+		Test->TestTrue(FString::Printf(TEXT("Simulated moves (%d) are within the movement budget (%.0f)"),
+		                               SimulatedMovesCount, MaxSimulatedMovesCount),
+		               SimulatedMovesCount <= MaxSimulatedMovesCount);
+	}
+};
+
+class FAlsForceMoveReplaysCommand : public IAutomationLatentCommand
+{
+private:
+	TSharedRef<AlsNetworkPredictionTests::FContext> Context;
+
+	AlsNetworkPredictionTests::FMetrics StartMetrics;
+
+	double StartTime{0.0};
+
+	double LastReplayTime{0.0};
+
+	int32 ForcedReplaysCount{0};
+
+	bool bPreviousVerifyMemo{false};
+
+public:
+	explicit FAlsForceMoveReplaysCommand(const TSharedRef<AlsNetworkPredictionTests::FContext>& InContext) : Context{InContext} {}
+
+	virtual ~FAlsForceMoveReplaysCommand() override
+	{
+		if (StartTime > 0.0)
+		{
+			auto* VerifyMemoConsoleVariable{IConsoleManager::Get().FindConsoleVariable(TEXT("Als.Movement.VerifyGroundedMovementSettingsMemo"))};
+			if (VerifyMemoConsoleVariable != nullptr)
+			{
+				VerifyMemoConsoleVariable->Set(bPreviousVerifyMemo, ECVF_SetByCode);
+			}
+		}
+	}
+
+	virtual bool Update() override
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		if (Context->bFailed)
+		{
+			return true;
+		}
+
+		if (!Context->ServerWorld.IsValid())
+		{
+			Context->Test->AddError(TEXT("The play session ended before the move replays were finished."));
+			return true;
+		}
+
+		const auto Time{FPlatformTime::Seconds()};
+
+		if (StartTime <= 0.0)
+		{
+			// Every memoized result is also calculated again and compared bit for bit with the memoized one.
+
+			auto* VerifyMemoConsoleVariable{IConsoleManager::Get().FindConsoleVariable(TEXT("Als.Movement.VerifyGroundedMovementSettingsMemo"))};
+			if (VerifyMemoConsoleVariable == nullptr)
+			{
+				Context->Test->AddError(TEXT("Console variable Als.Movement.VerifyGroundedMovementSettingsMemo could not be found."));
+				return true;
+			}
+
+			bPreviousVerifyMemo = VerifyMemoConsoleVariable->GetBool();
+			VerifyMemoConsoleVariable->Set(true, ECVF_SetByCode);
+
+			StartMetrics = GatherMetrics(*Context);
+			StartTime = Time;
+			LastReplayTime = Time;
+		}
+
+		const auto ElapsedTime{Time - StartTime};
+
+		if (ElapsedTime >= MoveReplaysDuration)
+		{
+			ReportMetrics();
+			return true;
+		}
+
+		const auto bForceReplay{Time - LastReplayTime >= MoveReplayInterval};
+		if (bForceReplay)
+		{
+			LastReplayTime = Time;
+		}
+
+		const auto bMoveBackward{FMath::FloorToInt32(ElapsedTime / DirectionChangeInterval) % 2 != 0};
+
+		for (const auto& ClientWorld : Context->ClientWorlds)
+		{
+			auto* Character{GetLocalCharacter(ClientWorld.Get())};
+			if (!IsValid(Character))
+			{
+				continue;
+			}
+
+			Character->SetDesiredRotationMode(AlsRotationModeTags::VelocityDirection);
+			Character->SetDesiredStance(AlsStanceTags::Standing);
+			Character->SetDesiredGait(AlsGaitTags::Running);
+
+			Character->GetController()->SetControlRotation(FRotator::ZeroRotator);
+			Character->AddMovementInput(bMoveBackward ? FVector::BackwardVector : FVector::ForwardVector);
+
+			if (bForceReplay)
+			{
+				ForceReplay(*Character);
+			}
+		}
+
+		return false;
+	}
+
+private:
+	void ForceReplay(AAlsCharacter& Character)
+	{
+		auto* Movement{Cast<UAlsCharacterMovementComponent>(Character.GetCharacterMovement())};
+		const auto* PredictionData{IsValid(Movement) ? Movement->GetPredictionData_Client_Character() : nullptr};
+
+		if (PredictionData == nullptr || PredictionData->SavedMoves.Num() < 2)
+		{
+			return;
+		}
+
+		// Acknowledge the first saved move and put the character back to where the second saved move started, so
+		// that the client replays the remaining saved moves from the same state as they were first simulated from.
+
+		const auto& AcknowledgedMove{PredictionData->SavedMoves[0]};
+		const auto& ReplayedMove{PredictionData->SavedMoves[1]};
+
+		Movement->ClientAdjustPosition(AcknowledgedMove->TimeStamp, ReplayedMove->StartLocation, ReplayedMove->StartVelocity,
+		                               ReplayedMove->StartBase.Get(), ReplayedMove->StartBoneName, ReplayedMove->StartBase.IsValid(),
+		                               false, ReplayedMove->StartPackedMovementMode);
+
+		ForcedReplaysCount += 1;
+	}
+
+	void ReportMetrics() const
+	{
+		using namespace AlsNetworkPredictionTests;
+
+		const auto Metrics{GatherMetrics(*Context)};
+
+		const auto HitsCount{Metrics.GroundedMovementSettingsMemoHits - StartMetrics.GroundedMovementSettingsMemoHits};
+		const auto MismatchesCount{Metrics.GroundedMovementSettingsMemoMismatches - StartMetrics.GroundedMovementSettingsMemoMismatches};
+
+		auto* Test{Context->Test};
+
+		Test->AddInfo(FString::Printf(TEXT("Forced replays: %d, memoized grounded movement settings reused: %d, mismatches: %d."),
+		                              ForcedReplaysCount, HitsCount, MismatchesCount));
+
+		Test->TestTrue(TEXT("Memoized grounded movement settings were reused during replays"), HitsCount > 0);
+		Test->TestEqual(TEXT("Memoized grounded movement settings mismatches"), MismatchesCount, 0);
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsNetworkPredictionFidelityTest, "Als.Network.PredictionFidelity",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAlsNetworkPredictionFidelityTest::RunTest(const FString& Parameters)
+{
+	const auto Context{MakeShared<AlsNetworkPredictionTests::FContext>()};
+	Context->Test = this;
+	Context->ClientsCount = FMath::Max(1, AlsNetworkPredictionTestsConsoleVariables::ClientsCount.GetValueOnGameThread());
+
+	if (!AutomationOpenMap(AlsNetworkPredictionTestsConsoleVariables::Map.GetValueOnGameThread()))
+	{
+		AddError(TEXT("Failed to open the test map."));
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsStartNetworkPlaySessionCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsWaitForNetworkPlayersCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsDriveScriptedInputsCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+
+	return true;
+}
+
+// Measures how often the clients send server moves during steady-state locomotion with different move combining settings.
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsNetworkMoveCombiningTest, "Als.Network.MoveCombining",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAlsNetworkMoveCombiningTest::RunTest(const FString& Parameters)
+{
+	const auto Context{MakeShared<AlsNetworkPredictionTests::FContext>()};
+	Context->Test = this;
+	Context->ClientsCount = FMath::Max(1, AlsNetworkPredictionTestsConsoleVariables::ClientsCount.GetValueOnGameThread());
+
+	if (!AutomationOpenMap(AlsNetworkPredictionTestsConsoleVariables::Map.GetValueOnGameThread()))
+	{
+		AddError(TEXT("Failed to open the test map."));
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsStartNetworkPlaySessionCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsWaitForNetworkPlayersCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsDriveSteadyStateLocomotionCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+
+	return true;
+}
+
+// Measures the corrections of clients running at a high frame rate with and without the movement budget.
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsNetworkMovementBudgetHighFrameRateTest, "Als.Network.MovementBudget.HighFrameRate",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAlsNetworkMovementBudgetHighFrameRateTest::RunTest(const FString& Parameters)
+{
+	const auto Context{MakeShared<AlsNetworkPredictionTests::FContext>()};
+	Context->Test = this;
+	Context->ClientsCount = FMath::Max(1, AlsNetworkPredictionTestsConsoleVariables::ClientsCount.GetValueOnGameThread());
+
+	if (!AutomationOpenMap(AlsNetworkPredictionTestsConsoleVariables::Map.GetValueOnGameThread()))
+	{
+		AddError(TEXT("Failed to open the test map."));
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsStartNetworkPlaySessionCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsWaitForNetworkPlayersCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsDriveHighFrameRateLocomotionCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+
+	return true;
+}
+
+// Floods the server with tiny moves through the clients' connections and checks that
+// the movement budget limits the number of moves that the server simulates.
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsNetworkMovementBudgetMaliciousStreamTest, "Als.Network.MovementBudget.MaliciousStream",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAlsNetworkMovementBudgetMaliciousStreamTest::RunTest(const FString& Parameters)
+{
+	const auto Context{MakeShared<AlsNetworkPredictionTests::FContext>()};
+	Context->Test = this;
+	Context->ClientsCount = FMath::Max(1, AlsNetworkPredictionTestsConsoleVariables::ClientsCount.GetValueOnGameThread());
+
+	if (!AutomationOpenMap(AlsNetworkPredictionTestsConsoleVariables::Map.GetValueOnGameThread()))
+	{
+		AddError(TEXT("Failed to open the test map."));
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsStartNetworkPlaySessionCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsWaitForNetworkPlayersCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsSendMaliciousMoveStreamCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+
+	return true;
+}
+
+// Forces the clients to replay their saved moves and checks that the grounded movement settings reused
+// from the saved moves are bit for bit identical to the ones calculated again during the replays.
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsNetworkGroundedMovementSettingsMemoTest, "Als.Network.GroundedMovementSettingsMemo",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAlsNetworkGroundedMovementSettingsMemoTest::RunTest(const FString& Parameters)
+{
+	const auto Context{MakeShared<AlsNetworkPredictionTests::FContext>()};
+	Context->Test = this;
+	Context->ClientsCount = FMath::Max(1, AlsNetworkPredictionTestsConsoleVariables::ClientsCount.GetValueOnGameThread());
+
+	if (!AutomationOpenMap(AlsNetworkPredictionTestsConsoleVariables::Map.GetValueOnGameThread()))
+	{
+		AddError(TEXT("Failed to open the test map."));
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsStartNetworkPlaySessionCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsWaitForNetworkPlayersCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FAlsForceMoveReplaysCommand(Context));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,193 @@
+﻿#include "AlsCharacter.h"
+#include "AlsSignificanceSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectGlobals.h"
+#include "Utility/AlsGameplayTags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+// Spawns 500 characters, puts all of them into each significance tier in turn, and checks that lower tiers never hold the
+// view or the rotation of a character for more than a frame, while reporting the world tick time of every tier.
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlsSignificanceTiersTest, "Als.Significance.Tiers",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace AlsSignificanceTests
+{
+	static constexpr auto CharactersCount{500};
+
+	static constexpr auto CharacterSpacing{400.0f};
+
+	static constexpr auto WarmupFrames{30};
+
+	static constexpr auto Frames{60};
+
+	static constexpr auto DeltaTime{1.0f / 60.0f};
+
+	// Characters run in circles and look around, so that both their rotation and their view change every frame.
+	static constexpr auto TurnRate{180.0f};
+
+	static const TCHAR* CharacterClassPath{TEXT("/ALS/Game/Blueprints/Characters/B_Als_Character.B_Als_Character_C")};
+
+	static const TCHAR* TierNames[]{TEXT("High"), TEXT("Medium"), TEXT("Low"), TEXT("Lowest")};
+}
+
+bool FAlsSignificanceTiersTest::RunTest(const FString& Parameters)
+{
+	using namespace AlsSignificanceTests;
+
+	const TSubclassOf<AAlsCharacter> CharacterClass{LoadClass<AAlsCharacter>(nullptr, CharacterClassPath)};
+	if (!TestNotNull(TEXT("Character class"), CharacterClass.Get()))
+	{
+		return false;
+	}
+
+	// The whole test runs synchronously, so the significance subsystem never gets a chance to reassign the tiers set below.
+
+	auto* World{UWorld::CreateWorld(EWorldType::Game, false, TEXT("AlsSignificanceTest"))};
+	auto& WorldContext{GEngine->CreateNewWorldContext(EWorldType::Game)};
+	WorldContext.SetCurrentWorld(World);
+
+	ON_SCOPE_EXIT
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	};
+
+	const auto GridSize{FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(CharactersCount)))};
+	const auto GridExtent{GridSize * CharacterSpacing};
+
+	// The box mesh is 100 units in size, so the top of the floor is at zero height.
+
+	auto* Floor{World->SpawnActor<AStaticMeshActor>(FVector{GridExtent * 0.5f, GridExtent * 0.5f, -50.0f}, FRotator::ZeroRotator)};
+	Floor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+	Floor->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+	Floor->GetStaticMeshComponent()->SetWorldScale3D({(GridExtent + CharacterSpacing * 4.0f) / 100.0f,
+	                                                  (GridExtent + CharacterSpacing * 4.0f) / 100.0f, 1.0f});
+
+	TArray<AAlsCharacter*> Characters;
+	Characters.Reserve(CharactersCount);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	for (auto i{0}; i < CharactersCount; i++)
+	{
+		const FVector Location{(i % GridSize + 0.5f) * CharacterSpacing, (i / GridSize + 0.5f) * CharacterSpacing, 100.0f};
+
+		auto* Character{World->SpawnActor<AAlsCharacter>(CharacterClass, Location, FRotator::ZeroRotator, SpawnParameters)};
+		if (!IsValid(Character))
+		{
+			continue;
+		}
+
+		Character->GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+		Character->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+		Character->SpawnDefaultController();
+		Character->SetDesiredGait(AlsGaitTags::Running);
+
+		Characters.Add(Character);
+	}
+
+	if (!TestEqual(TEXT("Spawned characters"), Characters.Num(), CharactersCount))
+	{
+		return false;
+	}
+
+	World->InitializeActorsForPlay(FURL{});
+	World->BeginPlay();
+
+	TArray<float> TickIntervals;
+	TickIntervals.Reserve(Characters.Num());
+
+	for (const auto* Character : Characters)
+	{
+		TickIntervals.Add(Character->GetActorTickInterval());
+	}
+
+	TArray<FRotator> PreviousViewRotations;
+	TArray<FRotator> PreviousRotations;
+
+	auto Frame{0};
+
+	for (auto TierIndex{0}; TierIndex < UE_ARRAY_COUNT(TierNames); TierIndex++)
+	{
+		const auto Tier{static_cast<EAlsSignificanceTier>(TierIndex)};
+
+		for (auto* Character : Characters)
+		{
+			Character->SetSignificanceTier(Tier);
+		}
+
+		auto TierTime{0.0};
+		auto HeldViewsCount{0};
+		auto HeldRotationsCount{0};
+
+		for (auto TierFrame{0}; TierFrame < WarmupFrames + Frames; TierFrame++, Frame++)
+		{
+			const FRotator Rotation{0.0f, FRotator::NormalizeAxis(Frame * DeltaTime * TurnRate), 0.0f};
+
+			for (auto* Character : Characters)
+			{
+				Character->GetController()->SetControlRotation(Rotation);
+				Character->AddMovementInput(Rotation.Vector());
+			}
+
+			const auto StartCycles{FPlatformTime::Cycles64()};
+
+			World->Tick(LEVELTICK_All, DeltaTime);
+
+			const auto FrameTime{FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles)};
+
+			GFrameCounter += 1;
+
+			if (TierFrame >= WarmupFrames)
+			{
+				TierTime += FrameTime;
+
+				for (auto i{0}; i < Characters.Num(); i++)
+				{
+					HeldViewsCount += Characters[i]->GetViewState().Rotation.Equals(PreviousViewRotations[i]) ? 1 : 0;
+					HeldRotationsCount += Characters[i]->GetActorRotation().Equals(PreviousRotations[i]) ? 1 : 0;
+				}
+			}
+
+			PreviousViewRotations.Reset();
+			PreviousRotations.Reset();
+
+			for (const auto* Character : Characters)
+			{
+				PreviousViewRotations.Add(Character->GetViewState().Rotation);
+				PreviousRotations.Add(Character->GetActorRotation());
+			}
+		}
+
+		AddInfo(FString::Printf(TEXT("%s tier: %.3f ms per frame, %.2f us per character."), TierNames[TierIndex],
+		                        TierTime / Frames, TierTime * 1000.0 / (Frames * Characters.Num())));
+
+		TestEqual(FString::Printf(TEXT("%s tier: views not refreshed in a frame"), TierNames[TierIndex]), HeldViewsCount, 0);
+		TestEqual(FString::Printf(TEXT("%s tier: rotations not refreshed in a frame"), TierNames[TierIndex]), HeldRotationsCount, 0);
+
+		auto ChangedTickIntervalsCount{0};
+
+		for (auto i{0}; i < Characters.Num(); i++)
+		{
+			ChangedTickIntervalsCount += FMath::IsNearlyEqual(Characters[i]->GetActorTickInterval(), TickIntervals[i]) ? 0 : 1;
+		}
+
+		TestEqual(FString::Printf(TEXT("%s tier: characters with a changed tick interval"), TierNames[TierIndex]),
+		          ChangedTickIntervalsCount, 0);
+	}
+
+	return true;
+}
+
+#endif
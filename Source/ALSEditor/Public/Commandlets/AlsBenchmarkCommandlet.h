@@ -0,0 +1,27 @@
+﻿#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "AlsBenchmarkCommandlet.generated.h"
+
+class AAlsCharacter;
+
+// Headless locomotion benchmark. For each scenario, spawns characters on a generated flat map, drives them with scripted input,
+// steps the world a fixed number of frames with a fixed delta time and writes frame timings and STATGROUP_Als timings to CSV and JSON.
+//
+// With -CompareAnimationInput, each scenario is run twice: once with the animation instances gathering their input from the characters
+// on every update and once with them reading the snapshot published by the characters. The game thread cost per animation instance,
+// i.e., the time of UAlsAnimationInstance::NativeUpdateAnimation() and of publishing the snapshot, is reported for both runs.
+//
+// UnrealEditor-Cmd <Project> -run=AlsBenchmark -nullrhi -unattended [-Scenarios=Walk,Run,Sprint,Crouch,Jump,Mantle,Ragdoll]
+//     [-Count=100] [-Frames=600] [-WarmupFrames=60] [-DeltaTime=0.016667] [-CompareAnimationInput]
+//     [-Character=<Class Path>] [-Output=<File Path Without Extension>]
+UCLASS()
+class ALSEDITOR_API UAlsBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAlsBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Parameters) override;
+};
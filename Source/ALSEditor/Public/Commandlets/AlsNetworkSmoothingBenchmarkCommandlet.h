@@ -0,0 +1,22 @@
+﻿#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "AlsNetworkSmoothingBenchmarkCommandlet.generated.h"
+
+// Headless network smoothing benchmark. Spawns simulated proxies on a generated flat map, feeds them a scripted stream of
+// network updates, and steps the world a fixed number of frames with the network smoothing of simulated proxies batched
+// and not batched by the network smoothing subsystem. Writes frame timings and batch sizes to CSV and JSON.
+//
+// UnrealEditor-Cmd <Project> -run=AlsNetworkSmoothingBenchmark -nullrhi -unattended [-Modes=Linear,Exponential]
+//     [-Count=300] [-Frames=600] [-WarmupFrames=60] [-DeltaTime=0.016667] [-UpdateInterval=0.1]
+//     [-Character=<Class Path>] [-Output=<File Path Without Extension>]
+UCLASS()
+class ALSEDITOR_API UAlsNetworkSmoothingBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAlsNetworkSmoothingBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Parameters) override;
+};
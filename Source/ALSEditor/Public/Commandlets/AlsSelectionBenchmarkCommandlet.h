@@ -0,0 +1,21 @@
+﻿#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "AlsSelectionBenchmarkCommandlet.generated.h"
+
+// Headless marquee selection benchmark. Spawns selectable actors on a grid, then for each scenario queries random marquees
+// through the selectable actor subsystem and through a walk over all actors that projects each of them to the screen, which is
+// how marquee selection worked before the subsystem was introduced. Writes query timings and selected actors counts to CSV and JSON.
+//
+// UnrealEditor-Cmd <Project> -run=AlsSelectionBenchmark -nullrhi -unattended [-Scenarios=Small,Medium,FullScreen,Horizon]
+//     [-Count=10000] [-Queries=1000] [-Output=<File Path Without Extension>]
+UCLASS()
+class ALSEDITOR_API UAlsSelectionBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAlsSelectionBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Parameters) override;
+};
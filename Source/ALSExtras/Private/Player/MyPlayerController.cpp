@@ -2,10 +2,10 @@
 #include "Net/UnrealNetwork.h"
 #include "Kismet/GameplayStatics.h"
 #include "Interfaces/SelectableActorInterface.h"
+#include "Subsystems/SelectableActorSubsystem.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemInterface.h"
 #include "Engine/World.h"
-#include "EngineUtils.h"
 #include "GameFramework/Pawn.h"
 #include "SceneView.h"
 #include "DrawDebugHelpers.h"
@@ -429,8 +429,9 @@ bool AMyPlayerController::Perform2DScreenSpaceSelection(FVector2D ScreenStart, F
     const FVector2D MarqueeTopLeft(FMath::Min(ScreenStart.X, ScreenEnd.X), FMath::Min(ScreenStart.Y, ScreenEnd.Y));
     const FVector2D MarqueeBottomRight(FMath::Max(ScreenStart.X, ScreenEnd.X), FMath::Max(ScreenStart.Y, ScreenEnd.Y));
 
-    // If the box has no area, don't select anything
-    if ((MarqueeBottomRight - MarqueeTopLeft).SizeSquared() <= KINDA_SMALL_NUMBER)
+    // If the box has no width or no height, it has no area and can't form a frustum, so don't select anything
+    const FVector2D MarqueeSize = MarqueeBottomRight - MarqueeTopLeft;
+    if (MarqueeSize.X < KINDA_SMALL_NUMBER || MarqueeSize.Y < KINDA_SMALL_NUMBER)
     {
         UE_LOG(LogTemp, Log, TEXT("Perform2DScreenSpaceSelection: Marquee selection box has zero area."));
         return false;
@@ -441,7 +442,6 @@ bool AMyPlayerController::Perform2DScreenSpaceSelection(FVector2D ScreenStart, F
 
     OutActorsInBox.Empty();
     
-    // Use manual screen-space projection checking
     UWorld* World = this->GetWorld();
     if (!World)
     {
@@ -449,45 +449,54 @@ bool AMyPlayerController::Perform2DScreenSpaceSelection(FVector2D ScreenStart, F
         return false;
     }
 
-    int32 TotalActorsChecked = 0;
-    for (TActorIterator<AActor> It(World); It; ++It)
+    USelectableActorSubsystem* SelectableActorSubsystem = World->GetSubsystem<USelectableActorSubsystem>();
+    if (!SelectableActorSubsystem)
     {
-        AActor* Actor = *It;
-        TotalActorsChecked++;
-        
-        // This check already uses Implements<USelectableActorInterface>() correctly
-        if (!IsValid(Actor) || !Actor->Implements<USelectableActorInterface>() || Actor == GetPawn()) // Skip self
+        UE_LOG(LogTemp, Warning, TEXT("Perform2DScreenSpaceSelection: Selectable actor subsystem is not available."));
+        return false;
+    }
+
+    // Only actors registered as selectable and located in grid cells overlapping the marquee frustum are tested
+    FMarqueeFrustum MarqueeFrustum;
+    if (!USelectableActorSubsystem::BuildMarqueeFrustum(this, MarqueeTopLeft, MarqueeBottomRight, MarqueeFrustum))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Perform2DScreenSpaceSelection: Failed to build the marquee frustum."));
+        return false;
+    }
+
+    SelectableActorSubsystem->QueryActorsInFrustum(MarqueeFrustum, OutActorsInBox);
+
+    if (APawn* ControlledPawn = GetPawn())
+    {
+        OutActorsInBox.RemoveSingleSwap(ControlledPawn, EAllowShrinking::No); // Skip self
+    }
+
+    if (this->bDrawDebugFrustum)
+    {
+        for (const AActor* Actor : OutActorsInBox)
         {
-            continue;
+            DrawDebugSphere(World, Actor->GetActorLocation(), 25.f, 12, FColor::Green, false, 5.0f);
+            UE_LOG(LogTemp, Log, TEXT("Perform2DScreenSpaceSelection: Actor %s IS INSIDE marquee box."),
+                   *Actor->GetName());
         }
-        
-        FVector ActorLocation = Actor->GetActorLocation();
-        FVector2D ScreenLocation;
-        
-        if (this->ProjectWorldLocationToScreen(ActorLocation, ScreenLocation, true /*bPlayerViewportRelative*/))
+
+        // Debug visualization for on-screen actors outside selection. Walking all registered actors is fine for debugging only
+        TArray<AActor*> RegisteredActors;
+        SelectableActorSubsystem->GetRegisteredActors(RegisteredActors);
+
+        for (const AActor* Actor : RegisteredActors)
         {
-            if (ScreenLocation.X >= MarqueeTopLeft.X && ScreenLocation.X <= MarqueeBottomRight.X &&
-                ScreenLocation.Y >= MarqueeTopLeft.Y && ScreenLocation.Y <= MarqueeBottomRight.Y)
-            {
-                OutActorsInBox.Add(Actor);
-                
-                if (this->bDrawDebugFrustum)
-                {
-                    DrawDebugSphere(World, ActorLocation, 25.f, 12, FColor::Green, false, 5.0f);
-                    UE_LOG(LogTemp, Log, TEXT("Perform2DScreenSpaceSelection: Actor %s IS INSIDE marquee box."), 
-                           *Actor->GetName());
-                }
-            }
-            else if (this->bDrawDebugFrustum)
+            FVector2D ScreenLocation;
+            if (Actor != GetPawn() && !OutActorsInBox.Contains(Actor) &&
+                this->ProjectWorldLocationToScreen(Actor->GetActorLocation(), ScreenLocation, true /*bPlayerViewportRelative*/))
             {
-                // Debug visualization for actors outside selection
-                DrawDebugSphere(World, ActorLocation, 25.f, 12, FColor::Red, false, 5.0f);
+                DrawDebugSphere(World, Actor->GetActorLocation(), 25.f, 12, FColor::Red, false, 5.0f);
             }
         }
     }
-    
-    UE_LOG(LogTemp, Log, TEXT("Perform2DScreenSpaceSelection: Found %d actors (checked %d total)"), 
-           OutActorsInBox.Num(), TotalActorsChecked);
+
+    UE_LOG(LogTemp, Log, TEXT("Perform2DScreenSpaceSelection: Found %d actors (%d selectable actors registered)"),
+           OutActorsInBox.Num(), SelectableActorSubsystem->GetNumRegisteredActors());
     
     return true;
 }
@@ -502,119 +511,3 @@ void AMyPlayerController::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
     // Server tells individual actors they are selected/deselected.
     // If other clients *needed* to know this PC's selection, you would replicate it.
 }
-
-
-// Function to help build the frustum using view projection matrices - COMMENTED OUT
-// This was the original frustum selection method, kept for reference but not used anymore
-/*
-bool GetFrustumForMarquee(APlayerController* PC, const FVector2D& ScreenPos1, const FVector2D& ScreenPos2, FConvexVolume& OutFrustum, float FrustumFarDistance = 10000.0f)
-{
-    UE_LOG(LogTemp, Log, TEXT("GetFrustumForMarquee: Input ScreenPos1(%s), ScreenPos2(%s)"), *ScreenPos1.ToString(), *ScreenPos2.ToString());
-
-    if (!PC || !PC->PlayerCameraManager || !PC->GetLocalPlayer() || !PC->GetLocalPlayer()->ViewportClient || !PC->GetLocalPlayer()->ViewportClient->Viewport)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("GetFrustumForMarquee: Invalid PC, PlayerCameraManager, LocalPlayer, ViewportClient, or Viewport."));
-        return false;
-    }
-
-    FVector ViewOrigin;
-    FRotator ViewRotation;
-    PC->GetPlayerViewPoint(ViewOrigin, ViewRotation); // This gets the camera's viewpoint
-
-    const FIntPoint ViewportSize = PC->GetLocalPlayer()->ViewportClient->Viewport->GetSizeXY();
-    if (ViewportSize.X == 0 || ViewportSize.Y == 0)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("GetFrustumForMarquee: Viewport size is zero."));
-        return false;
-    }
-
-    FVector2D MarqueeMin(FMath::Min(ScreenPos1.X, ScreenPos2.X), FMath::Min(ScreenPos1.Y, ScreenPos2.Y));
-    FVector2D MarqueeMax(FMath::Max(ScreenPos1.X, ScreenPos2.X), FMath::Max(ScreenPos1.Y, ScreenPos2.Y));
-
-    UE_LOG(LogTemp, Log, TEXT("GetFrustumForMarquee: Calculated MarqueeMin:(%s), MarqueeMax:(%s)"), *MarqueeMin.ToString(), *MarqueeMax.ToString());
-
-    if (MarqueeMin.X >= MarqueeMax.X - KINDA_SMALL_NUMBER || MarqueeMin.Y >= MarqueeMax.Y - KINDA_SMALL_NUMBER)
-    {
-        UE_LOG(LogTemp, Log, TEXT("GetFrustumForMarquee: Marquee has zero or negative area."));
-        return false;
-    }
-
-    // Get Near Clip Plane distance using a fixed value instead of the PlayerCameraManager method
-    const float NearClipDistance = 10.0f; // Fixed value to avoid compiler error
-    UE_LOG(LogTemp, Log, TEXT("GetFrustumForMarquee: Using NearClipDistance: %f"), NearClipDistance);
-
-    // Deproject the four corners of the MARQUEE to get world space points on the NEAR plane
-    FVector NearMarqueeVertices[4]; // 0:TL, 1:TR, 2:BR, 3:BL
-    FVector FarMarqueeVertices[4];  // 0:TL, 1:TR, 2:BR, 3:BL
-    FVector RayOrigin_Unused, TempRayDir;
-
-    bool bDepSuccess = true;
-    // Top-Left corner
-    bDepSuccess &= UGameplayStatics::DeprojectScreenToWorld(PC, MarqueeMin, RayOrigin_Unused, TempRayDir);
-    TempRayDir.Normalize();
-    NearMarqueeVertices[0] = ViewOrigin + TempRayDir * NearClipDistance;
-    FarMarqueeVertices[0] = ViewOrigin + TempRayDir * FrustumFarDistance;
-    
-    // Top-Right corner
-    bDepSuccess &= UGameplayStatics::DeprojectScreenToWorld(PC, FVector2D(MarqueeMax.X, MarqueeMin.Y), RayOrigin_Unused, TempRayDir);
-    TempRayDir.Normalize();
-    NearMarqueeVertices[1] = ViewOrigin + TempRayDir * NearClipDistance;
-    FarMarqueeVertices[1] = ViewOrigin + TempRayDir * FrustumFarDistance;
-    
-    // Bottom-Right corner
-    bDepSuccess &= UGameplayStatics::DeprojectScreenToWorld(PC, MarqueeMax, RayOrigin_Unused, TempRayDir);
-    TempRayDir.Normalize();
-    NearMarqueeVertices[2] = ViewOrigin + TempRayDir * NearClipDistance;
-    FarMarqueeVertices[2] = ViewOrigin + TempRayDir * FrustumFarDistance;
-    
-    // Bottom-Left corner
-    bDepSuccess &= UGameplayStatics::DeprojectScreenToWorld(PC, FVector2D(MarqueeMin.X, MarqueeMax.Y), RayOrigin_Unused, TempRayDir);
-    TempRayDir.Normalize();
-    NearMarqueeVertices[3] = ViewOrigin + TempRayDir * NearClipDistance;
-    FarMarqueeVertices[3] = ViewOrigin + TempRayDir * FrustumFarDistance;
-
-    if(!bDepSuccess)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("GetFrustumForMarquee: Deprojection of one or more marquee corners failed."));
-        return false;
-    }
-    
-    UE_LOG(LogTemp, Log, TEXT("GetFrustumForMarquee: Near Marquee Vertices: TL=%s, TR=%s, BR=%s, BL=%s"), 
-        *NearMarqueeVertices[0].ToString(), *NearMarqueeVertices[1].ToString(), 
-        *NearMarqueeVertices[2].ToString(), *NearMarqueeVertices[3].ToString());
-
-    OutFrustum.Planes.Empty(6);
-
-    // 1. Near Plane (Points: NBR, NTR, NTL) - Normal should point INTO frustum (away from camera)
-    OutFrustum.Planes.Emplace(NearMarqueeVertices[2], NearMarqueeVertices[1], NearMarqueeVertices[0]);
-
-    // 2. Far Plane (Points: FBR, FTR, FTL) - Normal should point INTO frustum (towards camera)
-    OutFrustum.Planes.Emplace(FarMarqueeVertices[2], FarMarqueeVertices[1], FarMarqueeVertices[0]);
-
-    // 3. Left Plane (ViewOrigin, NearTopLeft, NearBottomLeft) - Normal points RIGHT
-    OutFrustum.Planes.Emplace(ViewOrigin, NearMarqueeVertices[0], NearMarqueeVertices[3]);
-    
-    // 4. Right Plane (ViewOrigin, NearBottomRight, NearTopRight) - Normal points LEFT
-    OutFrustum.Planes.Emplace(ViewOrigin, NearMarqueeVertices[2], NearMarqueeVertices[1]);
-
-    // 5. Top Plane (ViewOrigin, NearTopRight, NearTopLeft) - Normal points DOWN
-    OutFrustum.Planes.Emplace(ViewOrigin, NearMarqueeVertices[1], NearMarqueeVertices[0]);
-
-    // 6. Bottom Plane (ViewOrigin, NearBottomLeft, NearBottomRight) - Normal points UP
-    OutFrustum.Planes.Emplace(ViewOrigin, NearMarqueeVertices[3], NearMarqueeVertices[2]);
-
-    OutFrustum.Init(); 
-
-    const char* PlaneNames[] = { "Near", "Far", "Left", "Right", "Top", "Bottom" };
-    for (int32 i = 0; i < OutFrustum.Planes.Num(); i++)
-    {
-        const FPlane& Plane = OutFrustum.Planes[i];
-        UE_LOG(LogTemp, Log, TEXT("GetFrustumForMarquee: Final %s Plane Normal: %s, W: %f"), 
-            (i < 6) ? ANSI_TO_TCHAR(PlaneNames[i]) : TEXT("Unknown"), 
-            *Plane.GetNormal().ToString(), Plane.W);
-    }
-    
-    UE_LOG(LogTemp, Log, TEXT("GetFrustumForMarquee: Created custom marquee frustum with %d planes."), OutFrustum.Planes.Num());
-    return OutFrustum.Planes.Num() == 6;
-}
-*/
\ No newline at end of file
@@ -0,0 +1,457 @@
+#include "Subsystems/SelectableActorSubsystem.h"
+#include "Interfaces/SelectableActorInterface.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+
+void USelectableActorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UWorld* World = GetWorld();
+    if (World)
+    {
+        ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+            FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::OnActorSpawned));
+    }
+
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::OnLevelAddedToWorld);
+}
+
+void USelectableActorSubsystem::Deinitialize()
+{
+    UWorld* World = GetWorld();
+    if (World)
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+    }
+
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+
+    for (const FRegisteredActor& RegisteredActor : RegisteredActors)
+    {
+        if (USceneComponent* RootComponent = RegisteredActor.RootComponent.Get())
+        {
+            RootComponent->TransformUpdated.Remove(RegisteredActor.TransformUpdatedHandle);
+        }
+    }
+
+    RegisteredActors.Empty();
+    RegisteredActorIndices.Empty();
+    Cells.Empty();
+    ActorBounds.Init();
+
+    Super::Deinitialize();
+}
+
+void USelectableActorSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Pick up actors placed in the level. Anything spawned later is registered by OnActorSpawned().
+    for (TActorIterator<AActor> It(&InWorld); It; ++It)
+    {
+        RegisterActor(*It);
+    }
+}
+
+bool USelectableActorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USelectableActorSubsystem::RegisterActor(AActor* Actor)
+{
+    if (!IsValid(Actor) || !Actor->Implements<USelectableActorInterface>() || RegisteredActorIndices.Contains(Actor))
+    {
+        return;
+    }
+
+    FRegisteredActor RegisteredActor;
+    RegisteredActor.Actor = Actor;
+    RegisteredActor.ActorKey = Actor;
+    RegisteredActor.Cell = GetCell(Actor->GetActorLocation());
+
+    const int32 ActorIndex = RegisteredActors.Add(RegisteredActor);
+    RegisteredActorIndices.Add(Actor, ActorIndex);
+    AddToCell(ActorIndex, RegisteredActor.Cell);
+    ActorBounds += Actor->GetActorLocation();
+
+    if (USceneComponent* RootComponent = Actor->GetRootComponent())
+    {
+        RegisteredActors[ActorIndex].RootComponent = RootComponent;
+        RegisteredActors[ActorIndex].TransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(
+            this, &ThisClass::OnRootComponentTransformUpdated, ActorIndex);
+    }
+
+    Actor->OnEndPlay.AddUniqueDynamic(this, &ThisClass::OnActorEndPlay);
+}
+
+void USelectableActorSubsystem::UnregisterActor(AActor* Actor)
+{
+    int32 ActorIndex;
+    if (Actor == nullptr || !RegisteredActorIndices.RemoveAndCopyValue(Actor, ActorIndex))
+    {
+        return;
+    }
+
+    const FRegisteredActor& RegisteredActor = RegisteredActors[ActorIndex];
+
+    if (USceneComponent* RootComponent = RegisteredActor.RootComponent.Get())
+    {
+        RootComponent->TransformUpdated.Remove(RegisteredActor.TransformUpdatedHandle);
+    }
+
+    RemoveFromCell(ActorIndex, RegisteredActor.Cell);
+    RegisteredActors.RemoveAt(ActorIndex);
+
+    if (RegisteredActors.IsEmpty())
+    {
+        ActorBounds.Init();
+    }
+
+    Actor->OnEndPlay.RemoveDynamic(this, &ThisClass::OnActorEndPlay);
+}
+
+void USelectableActorSubsystem::GetRegisteredActors(TArray<AActor*>& OutActors) const
+{
+    OutActors.Reserve(OutActors.Num() + RegisteredActors.Num());
+
+    for (const FRegisteredActor& RegisteredActor : RegisteredActors)
+    {
+        if (AActor* Actor = RegisteredActor.Actor.Get())
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+bool USelectableActorSubsystem::BuildMarqueeFrustum(const APlayerController* PlayerController, const FVector2D& ScreenStart,
+                                                    const FVector2D& ScreenEnd, FMarqueeFrustum& OutFrustum)
+{
+    if (!IsValid(PlayerController))
+    {
+        return false;
+    }
+
+    const ULocalPlayer* LocalPlayer = PlayerController->GetLocalPlayer();
+    if (!LocalPlayer || !LocalPlayer->ViewportClient)
+    {
+        return false;
+    }
+
+    // Same view that APlayerController::DeprojectScreenPositionToWorld() uses, but fetched once for all four corners.
+    FSceneViewProjectionData ProjectionData;
+    if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+    {
+        return false;
+    }
+
+    return BuildMarqueeFrustum(ProjectionData, ScreenStart, ScreenEnd, OutFrustum);
+}
+
+bool USelectableActorSubsystem::BuildMarqueeFrustum(const FSceneViewProjectionData& ProjectionData, const FVector2D& ScreenStart,
+                                                    const FVector2D& ScreenEnd, FMarqueeFrustum& OutFrustum)
+{
+    const FVector2D MarqueeMin(FMath::Min(ScreenStart.X, ScreenEnd.X), FMath::Min(ScreenStart.Y, ScreenEnd.Y));
+    const FVector2D MarqueeMax(FMath::Max(ScreenStart.X, ScreenEnd.X), FMath::Max(ScreenStart.Y, ScreenEnd.Y));
+
+    // Adjacent corner rays of a marquee without width or height coincide, so they can't span a side plane.
+    const FVector2D MarqueeSize = MarqueeMax - MarqueeMin;
+    if (MarqueeSize.X < KINDA_SMALL_NUMBER || MarqueeSize.Y < KINDA_SMALL_NUMBER)
+    {
+        return false;
+    }
+
+    // Corners in order: top-left, top-right, bottom-right, bottom-left.
+    const FVector2D ScreenCorners[4] = {
+        MarqueeMin,
+        FVector2D(MarqueeMax.X, MarqueeMin.Y),
+        MarqueeMax,
+        FVector2D(MarqueeMin.X, MarqueeMax.Y)
+    };
+
+    const FMatrix InverseViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix().InverseFast();
+    const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+
+    FVector* NearVertices = OutFrustum.NearVertices;
+    FVector* RayDirections = OutFrustum.RayDirections;
+
+    for (int32 i = 0; i < 4; i++)
+    {
+        FSceneView::DeprojectScreenToWorld(ScreenCorners[i], ViewRect, InverseViewProjectionMatrix, NearVertices[i], RayDirections[i]);
+    }
+
+    // Any point along the average corner ray lies inside the frustum, so it is used to orient the planes.
+    FVector Center = FVector::ZeroVector;
+
+    for (int32 i = 0; i < 4; i++)
+    {
+        Center += NearVertices[i] + RayDirections[i] * 100.0f;
+    }
+
+    Center /= 4.0f;
+
+    // Like the previous screen-space projection test, the marquee selects actors at any distance, so only
+    // the near plane and the four side planes are built. Side planes are spanned by two adjacent corner rays.
+    FConvexVolume::FPlaneArray& Planes = OutFrustum.Volume.Planes;
+
+    Planes.Reset(5);
+    Planes.Emplace(NearVertices[0], NearVertices[1], NearVertices[2]);
+
+    for (int32 i = 0; i < 4; i++)
+    {
+        const int32 NextIndex = (i + 1) % 4;
+        Planes.Emplace(NearVertices[i], NearVertices[i] + RayDirections[i] * 1000.0f, NearVertices[NextIndex]);
+    }
+
+    for (FPlane& Plane : Planes)
+    {
+        // FPlane leaves the normal zeroed when the three points it is built from are collinear, and such
+        // a plane would either contain every point or none, depending on the sign of its W component.
+        if (!Plane.GetNormal().IsNormalized())
+        {
+            return false;
+        }
+
+        // FConvexVolume treats points in front of a plane as outside, so make every normal point away from the frustum center
+        // instead of relying on the winding of the deprojected corners.
+        if (Plane.PlaneDot(Center) > 0.0f)
+        {
+            Plane = Plane.Flip();
+        }
+    }
+
+    OutFrustum.Volume.Init();
+    return true;
+}
+
+void USelectableActorSubsystem::QueryActorsInFrustum(const FMarqueeFrustum& Frustum, TArray<AActor*>& OutActors)
+{
+    TArray<int32, TInlineAllocator<8>> StaleActorIndices;
+
+    FIntPoint MinCell;
+    FIntPoint MaxCell;
+
+    // Visiting the cell range costs a map lookup per cell, so it is only worth it when the range has fewer cells than the map.
+    if (CalculateFrustumCellRange(Frustum, MinCell, MaxCell) &&
+        int64(FMath::Max(0, MaxCell.X - MinCell.X + 1)) * FMath::Max(0, MaxCell.Y - MinCell.Y + 1) <= Cells.Num())
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+        {
+            for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+            {
+                const FIntPoint Cell(X, Y);
+
+                if (const TArray<int32>* CellActorIndices = Cells.Find(Cell))
+                {
+                    QueryActorsInCell(Frustum, Cell, *CellActorIndices, OutActors, StaleActorIndices);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+        {
+            QueryActorsInCell(Frustum, Cell.Key, Cell.Value, OutActors, StaleActorIndices);
+        }
+    }
+
+    for (const int32 ActorIndex : StaleActorIndices)
+    {
+        RemoveStaleActor(ActorIndex);
+    }
+}
+
+FIntPoint USelectableActorSubsystem::GetCell(const FVector& Location)
+{
+    return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+bool USelectableActorSubsystem::CalculateFrustumCellRange(const FMarqueeFrustum& Frustum, FIntPoint& OutMinCell, FIntPoint& OutMaxCell) const
+{
+    if (!ActorBounds.IsValid)
+    {
+        return false;
+    }
+
+    // Actors can only be found between the lowest and the highest registered location. If all corner rays point down (or all point up),
+    // the part of the frustum in that height range is bounded: it is the convex hull of the near vertices and of the ray segments that
+    // cross the range, so the XY bounds of these points are its bounds. Otherwise, some direction inside the frustum is horizontal.
+    bool bAllRaysPointDown = true;
+    bool bAllRaysPointUp = true;
+
+    for (const FVector& RayDirection : Frustum.RayDirections)
+    {
+        bAllRaysPointDown &= RayDirection.Z < -KINDA_SMALL_NUMBER;
+        bAllRaysPointUp &= RayDirection.Z > KINDA_SMALL_NUMBER;
+    }
+
+    if (!bAllRaysPointDown && !bAllRaysPointUp)
+    {
+        return false;
+    }
+
+    FBox2D FrustumBounds(ForceInit);
+
+    for (int32 i = 0; i < 4; i++)
+    {
+        const FVector& NearVertex = Frustum.NearVertices[i];
+        const FVector& RayDirection = Frustum.RayDirections[i];
+
+        FrustumBounds += FVector2D(NearVertex);
+
+        // Distances along the ray at which it crosses the bottom and the top of the actor bounds.
+        const double BottomDistance = (ActorBounds.Min.Z - NearVertex.Z) / RayDirection.Z;
+        const double TopDistance = (ActorBounds.Max.Z - NearVertex.Z) / RayDirection.Z;
+
+        const double StartDistance = FMath::Max(0.0, FMath::Min(BottomDistance, TopDistance));
+        const double EndDistance = FMath::Max(BottomDistance, TopDistance);
+
+        if (StartDistance <= EndDistance)
+        {
+            FrustumBounds += FVector2D(NearVertex + RayDirection * StartDistance);
+            FrustumBounds += FVector2D(NearVertex + RayDirection * EndDistance);
+        }
+    }
+
+    const FBox2D CellBounds = FrustumBounds.Overlap(FBox2D(FVector2D(ActorBounds.Min), FVector2D(ActorBounds.Max)));
+    if (!CellBounds.bIsValid)
+    {
+        OutMinCell = FIntPoint::ZeroValue;
+        OutMaxCell = FIntPoint(-1, -1);
+        return true;
+    }
+
+    OutMinCell = GetCell(FVector(CellBounds.Min, 0.0f));
+    OutMaxCell = GetCell(FVector(CellBounds.Max, 0.0f));
+    return true;
+}
+
+void USelectableActorSubsystem::QueryActorsInCell(const FMarqueeFrustum& Frustum, const FIntPoint& Cell, const TArray<int32>& CellActorIndices,
+                                                  TArray<AActor*>& OutActors, TArray<int32, TInlineAllocator<8>>& OutStaleActorIndices) const
+{
+    // Each cell is tested against the frustum as a box of unbounded height first.
+    static constexpr float CellHalfHeight = UE_OLD_HALF_WORLD_MAX;
+
+    const FVector CellExtent(CellSize * 0.5f, CellSize * 0.5f, CellHalfHeight);
+    const FVector CellCenter((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, 0.0f);
+
+    if (!Frustum.Volume.IntersectBox(CellCenter, CellExtent))
+    {
+        return;
+    }
+
+    for (const int32 ActorIndex : CellActorIndices)
+    {
+        AActor* Actor = RegisteredActors[ActorIndex].Actor.Get();
+        if (!Actor)
+        {
+            OutStaleActorIndices.Add(ActorIndex);
+        }
+        else if (Frustum.Volume.IntersectPoint(Actor->GetActorLocation()))
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+void USelectableActorSubsystem::AddToCell(const int32 ActorIndex, const FIntPoint& Cell)
+{
+    Cells.FindOrAdd(Cell).Add(ActorIndex);
+}
+
+void USelectableActorSubsystem::RemoveFromCell(const int32 ActorIndex, const FIntPoint& Cell)
+{
+    TArray<int32>* CellActorIndices = Cells.Find(Cell);
+    if (!CellActorIndices)
+    {
+        return;
+    }
+
+    CellActorIndices->RemoveSingleSwap(ActorIndex, EAllowShrinking::No);
+
+    if (CellActorIndices->IsEmpty())
+    {
+        Cells.Remove(Cell);
+    }
+}
+
+void USelectableActorSubsystem::RemoveStaleActor(const int32 ActorIndex)
+{
+    // The actor was destroyed without going through EndPlay, e.g. during level streaming.
+    const FRegisteredActor& RegisteredActor = RegisteredActors[ActorIndex];
+
+    if (USceneComponent* RootComponent = RegisteredActor.RootComponent.Get())
+    {
+        RootComponent->TransformUpdated.Remove(RegisteredActor.TransformUpdatedHandle);
+    }
+
+    RemoveFromCell(ActorIndex, RegisteredActor.Cell);
+    RegisteredActorIndices.Remove(RegisteredActor.ActorKey);
+    RegisteredActors.RemoveAt(ActorIndex);
+
+    if (RegisteredActors.IsEmpty())
+    {
+        ActorBounds.Init();
+    }
+}
+
+void USelectableActorSubsystem::RegisterLevelActors(const ULevel* Level)
+{
+    if (!Level)
+    {
+        return;
+    }
+
+    for (AActor* Actor : Level->Actors)
+    {
+        RegisterActor(Actor);
+    }
+}
+
+void USelectableActorSubsystem::OnActorSpawned(AActor* Actor)
+{
+    RegisterActor(Actor);
+}
+
+void USelectableActorSubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+    if (World == GetWorld())
+    {
+        RegisterLevelActors(Level);
+    }
+}
+
+void USelectableActorSubsystem::OnRootComponentTransformUpdated(USceneComponent* RootComponent,
+                                                                EUpdateTransformFlags UpdateTransformFlags,
+                                                                ETeleportType TeleportType, const int32 ActorIndex)
+{
+    if (!RegisteredActors.IsValidIndex(ActorIndex))
+    {
+        return;
+    }
+
+    FRegisteredActor& RegisteredActor = RegisteredActors[ActorIndex];
+
+    ActorBounds += RootComponent->GetComponentLocation();
+
+    const FIntPoint NewCell = GetCell(RootComponent->GetComponentLocation());
+    if (NewCell != RegisteredActor.Cell)
+    {
+        RemoveFromCell(ActorIndex, RegisteredActor.Cell);
+        AddToCell(ActorIndex, NewCell);
+        RegisteredActor.Cell = NewCell;
+    }
+}
+
+void USelectableActorSubsystem::OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+    UnregisterActor(Actor);
+}
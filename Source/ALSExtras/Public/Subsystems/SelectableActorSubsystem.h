@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ConvexVolume.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SelectableActorSubsystem.generated.h"
+
+class USceneComponent;
+struct FSceneViewProjectionData;
+
+// Marquee frustum together with its deprojected corner rays, which bound the grid cells the frustum can overlap.
+struct FMarqueeFrustum
+{
+    FConvexVolume Volume;
+
+    // Corners in order: top-left, top-right, bottom-right, bottom-left.
+    FVector NearVertices[4];
+
+    FVector RayDirections[4];
+};
+
+// Registry of actors implementing ISelectableActorInterface, bucketed into a uniform 2D grid on the XY plane.
+// Actors are registered automatically when they are spawned or when the world begins play, and unregistered on EndPlay.
+// This lets marquee selection test only the actors in cells overlapping the marquee frustum instead of every actor in the world.
+UCLASS()
+class ALSEXTRAS_API USelectableActorSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+private:
+    // Size of a single grid cell in world units.
+    static constexpr float CellSize = 1000.0f;
+
+    struct FRegisteredActor
+    {
+        TWeakObjectPtr<AActor> Actor;
+
+        // Kept separately from the weak pointer so that the entry can still be found after the actor is destroyed.
+        TObjectKey<AActor> ActorKey;
+
+        // Component whose transform updates move the actor between cells.
+        TWeakObjectPtr<USceneComponent> RootComponent;
+
+        FDelegateHandle TransformUpdatedHandle;
+
+        FIntPoint Cell = FIntPoint::ZeroValue;
+    };
+
+    // Registered actors, indexed by the values stored in the grid cells.
+    TSparseArray<FRegisteredActor> RegisteredActors;
+
+    TMap<TObjectKey<AActor>, int32> RegisteredActorIndices;
+
+    TMap<FIntPoint, TArray<int32>> Cells;
+
+    // Bounds of all locations registered actors have had since the registry was last empty. They only grow, which
+    // keeps them conservative without having to be recalculated when an actor moves away or is unregistered.
+    FBox ActorBounds = FBox(ForceInit);
+
+    FDelegateHandle ActorSpawnedHandle;
+
+    FDelegateHandle LevelAddedHandle;
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    virtual void Deinitialize() override;
+
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+protected:
+    virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+    UFUNCTION(BlueprintCallable, Category = "Selection")
+    void RegisterActor(AActor* Actor);
+
+    UFUNCTION(BlueprintCallable, Category = "Selection")
+    void UnregisterActor(AActor* Actor);
+
+    int32 GetNumRegisteredActors() const;
+
+    void GetRegisteredActors(TArray<AActor*>& OutActors) const;
+
+    // Builds a world-space frustum from the four corners of a screen-space marquee. The frustum has no far plane.
+    // Fails if the marquee is thinner than an epsilon on either axis or if any of the frustum planes is degenerate.
+    static bool BuildMarqueeFrustum(const APlayerController* PlayerController, const FVector2D& ScreenStart, const FVector2D& ScreenEnd,
+                                    FMarqueeFrustum& OutFrustum);
+
+    // Same as above, but deprojects the marquee with the given view instead of the player's viewport.
+    static bool BuildMarqueeFrustum(const FSceneViewProjectionData& ProjectionData, const FVector2D& ScreenStart, const FVector2D& ScreenEnd,
+                                    FMarqueeFrustum& OutFrustum);
+
+    // Appends registered actors whose location lies inside the frustum. Only actors in grid cells overlapping the frustum are tested.
+    //
+    // When all corner rays point down (or all point up), the part of the frustum between the lowest and the highest registered
+    // actor is bounded, and only the cells under it are visited. Otherwise, e.g. for a marquee drawn across the horizon, the frustum
+    // reaches infinitely far on the XY plane, so every non-empty cell is tested against it instead.
+    void QueryActorsInFrustum(const FMarqueeFrustum& Frustum, TArray<AActor*>& OutActors);
+
+private:
+    static FIntPoint GetCell(const FVector& Location);
+
+    // Calculates the range of cells under the part of the frustum that lies within the actor bounds. Fails if that part is unbounded.
+    // The range is empty (the max cell is less than the min cell) if the frustum doesn't overlap the actor bounds at all.
+    bool CalculateFrustumCellRange(const FMarqueeFrustum& Frustum, FIntPoint& OutMinCell, FIntPoint& OutMaxCell) const;
+
+    void QueryActorsInCell(const FMarqueeFrustum& Frustum, const FIntPoint& Cell, const TArray<int32>& CellActorIndices,
+                           TArray<AActor*>& OutActors, TArray<int32, TInlineAllocator<8>>& OutStaleActorIndices) const;
+
+    void AddToCell(int32 ActorIndex, const FIntPoint& Cell);
+
+    void RemoveFromCell(int32 ActorIndex, const FIntPoint& Cell);
+
+    // Removes an entry whose actor was destroyed without going through EndPlay.
+    void RemoveStaleActor(int32 ActorIndex);
+
+    void RegisterLevelActors(const ULevel* Level);
+
+    void OnActorSpawned(AActor* Actor);
+
+    void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+
+    // Moves the actor to its new cell as soon as its root component is moved, so that queries never have to refresh cells.
+    void OnRootComponentTransformUpdated(USceneComponent* RootComponent, EUpdateTransformFlags UpdateTransformFlags,
+                                         ETeleportType TeleportType, int32 ActorIndex);
+
+    UFUNCTION()
+    void OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+};
+
+inline int32 USelectableActorSubsystem::GetNumRegisteredActors() const
+{
+    return RegisteredActors.Num();
+}